@@ -12,23 +12,54 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from .loaders import load_metadata, load_usearch_index
+from .artifacts import chunk_key, chunk_keys, write_search_artifacts
+from .bm25 import SparseBM25Index
+from .cache import CachedEncoder, QueryCache, content_hash, normalize_query
+from .loaders import (
+    USEARCH_CHUNK_KEYS,
+    KeyedIndex,
+    KeyedMatches,
+    MappedMetadata,
+    load_metadata,
+    load_search_artifacts,
+    load_usearch_config,
+    load_usearch_index,
+    metadata_chunk_keys,
+    usearch_config_path,
+    write_usearch_config,
+)
 from .evaluation import (
     EvaluationCaseResult,
     EvaluationResult,
+    HnswGridResult,
+    IndexVariantResult,
     RetrievalError,
     RetrievalMiss,
     evaluate_retrieval,
+    ann_recall_at_k,
     load_eval_rows,
+    pick_hnsw_setting,
     print_evaluation,
+    print_hnsw_grid,
+    print_index_variants,
 )
 from .search import (
+    ChunkFieldTokens,
+    FieldTokenIndex,
+    LazyFieldTokenIndex,
+    QueryAnalysis,
+    analyze_query,
     build_bm25_index,
+    build_chunk_field_tokens,
+    build_field_token_index,
     bm25_search,
+    bm25_search_many,
     deduplicate_urls,
     deduplication_candidate_count,
     embedding_search,
+    embedding_search_many,
     hybrid_search,
+    hybrid_search_many,
     lexical_prepass_search,
     rerank_candidates,
     salient_tokens,
@@ -36,12 +67,15 @@ from .search import (
 )
 from .resources import (
     SearchResources,
+    embedding_backend_kwargs,
     embedding_dimension,
     load_embedding_model,
     load_search_resources,
     search,
+    search_many,
     sentence_transformer_cache_folder,
 )
+from .timing import SEARCH_STAGES, StageTimer
 from .response import (
     ARM_CONTENT_DISCLAIMER,
     add_disclaimer_to_arm_results,
@@ -54,31 +88,68 @@ __all__ = [
     "add_disclaimer_to_arm_results",
     "add_utm_source_to_results",
     "add_utm_source_to_url",
+    "analyze_query",
+    "ann_recall_at_k",
     "ARM_CONTENT_DISCLAIMER",
-    "build_bm25_index",
     "bm25_search",
+    "bm25_search_many",
+    "build_bm25_index",
+    "build_chunk_field_tokens",
+    "build_field_token_index",
+    "CachedEncoder",
+    "chunk_key",
+    "chunk_keys",
+    "ChunkFieldTokens",
+    "content_hash",
     "deduplicate_urls",
     "deduplication_candidate_count",
-    "embedding_search",
+    "embedding_backend_kwargs",
     "embedding_dimension",
+    "embedding_search",
+    "embedding_search_many",
     "evaluate_retrieval",
     "EvaluationCaseResult",
     "EvaluationResult",
+    "FieldTokenIndex",
+    "HnswGridResult",
     "hybrid_search",
+    "hybrid_search_many",
+    "IndexVariantResult",
     "is_arm_domain_url",
+    "KeyedIndex",
+    "KeyedMatches",
+    "LazyFieldTokenIndex",
     "lexical_prepass_search",
     "load_embedding_model",
     "load_eval_rows",
     "load_metadata",
+    "load_search_artifacts",
     "load_search_resources",
+    "load_usearch_config",
     "load_usearch_index",
+    "MappedMetadata",
+    "metadata_chunk_keys",
+    "normalize_query",
+    "pick_hnsw_setting",
     "print_evaluation",
+    "print_hnsw_grid",
+    "print_index_variants",
+    "QueryAnalysis",
+    "QueryCache",
     "rerank_candidates",
     "RetrievalError",
     "RetrievalMiss",
     "salient_tokens",
     "search",
+    "search_many",
+    "SEARCH_STAGES",
     "SearchResources",
     "sentence_transformer_cache_folder",
+    "SparseBM25Index",
+    "StageTimer",
     "tokenize_for_search",
+    "usearch_config_path",
+    "USEARCH_CHUNK_KEYS",
+    "write_search_artifacts",
+    "write_usearch_config",
 ]
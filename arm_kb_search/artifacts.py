@@ -0,0 +1,139 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Prebuilt search artifacts that the server memory-maps instead of rebuilding at startup.
+
+Layout of an artifacts directory:
+
+- manifest.json: format version, document count, and BM25 corpus size.
+- metadata.bin / metadata_offsets.npy: one UTF-8 JSON record per chunk, concatenated,
+  with int64 offsets (document_count + 1 entries) so any record decodes on its own.
+- metadata_keys.npy: uint64 chunk_key() of each record's chunk_uuid, in record order.
+- bm25_vocabulary.txt: newline-separated terms; line number is the term id.
+- bm25_idf.npy, bm25_indptr.npy, bm25_doc_ids.npy, bm25_weights.npy: SparseBM25Index arrays.
+"""
+
+from typing import Any, Dict, Iterable, List, Optional
+import hashlib
+import json
+import os
+import shutil
+import tempfile
+
+import numpy as np
+
+from .bm25 import SparseBM25Index
+
+
+SEARCH_ARTIFACTS_FORMAT_VERSION = 1
+MANIFEST_FILENAME = "manifest.json"
+METADATA_BLOB_FILENAME = "metadata.bin"
+METADATA_OFFSETS_FILENAME = "metadata_offsets.npy"
+METADATA_KEYS_FILENAME = "metadata_keys.npy"
+BM25_VOCABULARY_FILENAME = "bm25_vocabulary.txt"
+BM25_ARRAY_FILENAMES = {
+    "idf": "bm25_idf.npy",
+    "indptr": "bm25_indptr.npy",
+    "doc_ids": "bm25_doc_ids.npy",
+    "weights": "bm25_weights.npy",
+}
+
+
+def chunk_key(chunk_uuid: str) -> int:
+    """Stable USearch key for a chunk: 63 bits of a hash of its chunk_uuid."""
+    digest = hashlib.blake2b(chunk_uuid.encode("utf-8"), digest_size=8).digest()
+    return int.from_bytes(digest, "little") & (2**63 - 1)
+
+
+def chunk_keys(chunk_uuids: Iterable[str]) -> np.ndarray:
+    return np.fromiter((chunk_key(chunk_uuid) for chunk_uuid in chunk_uuids), dtype=np.uint64)
+
+
+def write_search_artifacts(
+    metadata: List[Dict[str, Any]],
+    bm25_index: Optional[SparseBM25Index],
+    output_dir: str,
+) -> Dict[str, Any]:
+    """Write metadata and the BM25 index in the memory-mappable layout described above.
+
+    The files are written to a temporary sibling directory that then replaces output_dir, so
+    a reader never sees a mix of two builds, and a server still mapping the old files keeps
+    them intact.
+    """
+    output_dir = os.path.normpath(output_dir)
+    parent = os.path.dirname(os.path.abspath(output_dir))
+    os.makedirs(parent, exist_ok=True)
+    staging_dir = tempfile.mkdtemp(prefix=f".{os.path.basename(output_dir)}.", dir=parent)
+    try:
+        manifest = _write_search_artifacts(metadata, bm25_index, staging_dir)
+        os.chmod(staging_dir, 0o755)
+        _replace_directory(staging_dir, output_dir)
+    except BaseException:
+        shutil.rmtree(staging_dir, ignore_errors=True)
+        raise
+    return manifest
+
+
+def _replace_directory(source: str, target: str) -> None:
+    """Move source over target; a target that exists is moved aside first and then deleted."""
+    if not os.path.exists(target):
+        os.replace(source, target)
+        return
+    retired = tempfile.mkdtemp(prefix=f".{os.path.basename(target)}.old.", dir=os.path.dirname(source))
+    os.rmdir(retired)
+    os.replace(target, retired)
+    try:
+        os.replace(source, target)
+    except BaseException:
+        os.replace(retired, target)
+        raise
+    shutil.rmtree(retired, ignore_errors=True)
+
+
+def _write_search_artifacts(
+    metadata: List[Dict[str, Any]],
+    bm25_index: Optional[SparseBM25Index],
+    output_dir: str,
+) -> Dict[str, Any]:
+
+    offsets = np.zeros(len(metadata) + 1, dtype=np.int64)
+    with open(os.path.join(output_dir, METADATA_BLOB_FILENAME), "wb") as blob:
+        for position, item in enumerate(metadata, start=1):
+            record = json.dumps(item, ensure_ascii=False, separators=(",", ":")).encode("utf-8")
+            blob.write(record)
+            offsets[position] = offsets[position - 1] + len(record)
+    np.save(os.path.join(output_dir, METADATA_OFFSETS_FILENAME), offsets)
+    np.save(os.path.join(output_dir, METADATA_KEYS_FILENAME), chunk_keys(item["chunk_uuid"] for item in metadata))
+
+    manifest: Dict[str, Any] = {
+        "format_version": SEARCH_ARTIFACTS_FORMAT_VERSION,
+        "document_count": len(metadata),
+        "bm25": None,
+    }
+    if bm25_index is not None:
+        terms = sorted(bm25_index.vocabulary, key=bm25_index.vocabulary.__getitem__)
+        with open(os.path.join(output_dir, BM25_VOCABULARY_FILENAME), "w", encoding="utf-8") as file:
+            file.write("\n".join(terms))
+        for attribute, filename in BM25_ARRAY_FILENAMES.items():
+            np.save(os.path.join(output_dir, filename), getattr(bm25_index, attribute))
+        manifest["bm25"] = {
+            "corpus_size": bm25_index.corpus_size,
+            "vocabulary_size": len(terms),
+            "posting_count": int(bm25_index.doc_ids.size),
+        }
+
+    # The manifest is written last, so a staging directory left by a failed build has none.
+    with open(os.path.join(output_dir, MANIFEST_FILENAME), "w") as file:
+        json.dump(manifest, file, indent=2)
+    return manifest
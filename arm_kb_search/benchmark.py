@@ -0,0 +1,241 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Latency and throughput benchmark for search() over loaded SearchResources.
+
+A report holds, for a cold pass (each query's first search after loading) and a warm pass
+(the same queries again), p50/p95/p99 of the total latency and of every stage in
+SEARCH_STAGES; QPS at each concurrency level; startup time; and RSS. Reports are plain dicts
+so they can be saved as JSON and gated against a baseline with find_regressions().
+"""
+
+from __future__ import annotations
+
+from collections.abc import Callable, Sequence
+from concurrent.futures import ThreadPoolExecutor
+import random
+import time
+from typing import Any
+
+from .evaluation import EvalRow
+from .resources import SearchResources, search
+from .search import salient_tokens
+from .timing import SEARCH_STAGES, StageTimer, latency_percentile, peak_rss_bytes, rss_bytes
+
+PERCENTILES = (50, 95, 99)
+# Query mixes synthetic_queries() draws from.
+QUERY_MIXES = ("eval", "keywords", "long", "miss")
+# Latencies below this many milliseconds are noise; find_regressions() never fails on them.
+DEFAULT_MIN_SLACK_MS = 1.0
+
+
+def synthetic_queries(
+    eval_rows: Sequence[EvalRow],
+    metadata: Sequence[dict[str, Any]],
+    count: int,
+    seed: int = 0,
+) -> list[tuple[str, str]]:
+    """(mix, query) pairs: eval questions plus keyword, long and no-match queries built from metadata.
+
+    keywords queries are a few salient title and heading tokens, long ones join a question
+    with a chunk's heading path, and miss queries are tokens that match no document, which
+    exercise the paths where every stage returns little.
+    """
+    rng = random.Random(seed)
+    questions = [str(row["question"]) for row in eval_rows if row.get("question")]
+    sample = [metadata[rng.randrange(len(metadata))] for _ in range(min(count, len(metadata)))] if len(metadata) else []
+    generated: dict[str, list[str]] = {mix: [] for mix in QUERY_MIXES}
+    generated["eval"] = questions
+    for item in sample:
+        tokens = salient_tokens(f"{item.get('title', '')} {item.get('heading', '')}")
+        if tokens:
+            generated["keywords"].append(" ".join(rng.sample(tokens, min(3, len(tokens)))))
+        heading_path = " ".join(item.get("heading_path") or [])
+        if questions and heading_path:
+            generated["long"].append(f"{rng.choice(questions)} {heading_path} {item.get('title', '')}")
+    generated["miss"] = [f"zq{rng.getrandbits(40):x} xv{rng.getrandbits(40):x}" for _ in range(max(1, count // 10))]
+
+    queries: list[tuple[str, str]] = []
+    mixes = [mix for mix in QUERY_MIXES if generated[mix]]
+    while mixes and len(queries) < count:
+        for mix in mixes:
+            if len(queries) < count:
+                queries.append((mix, rng.choice(generated[mix])))
+    return queries
+
+
+def _distribution(samples_ms: Sequence[float]) -> dict[str, float]:
+    samples = list(samples_ms)
+    summary = {f"p{percentile}_ms": latency_percentile(samples, percentile) for percentile in PERCENTILES}
+    summary["mean_ms"] = sum(samples) / len(samples) if samples else 0
+    return summary
+
+
+def latency_pass(resources: SearchResources, queries: Sequence[str], k: int | None = None) -> dict[str, Any]:
+    """Search each query once, timing the whole call and each stage it went through."""
+    totals: list[float] = []
+    stages: dict[str, list[float]] = {stage: [] for stage in SEARCH_STAGES}
+    for query in queries:
+        timer = StageTimer()
+        started = time.perf_counter()
+        search(query, resources, k=k, timer=timer)
+        totals.append((time.perf_counter() - started) * 1000)
+        for stage in SEARCH_STAGES:
+            if stage in timer.stages_ms:
+                stages[stage].append(timer.stages_ms[stage])
+    return {
+        "queries": len(totals),
+        "total": _distribution(totals),
+        "stages": {stage: _distribution(samples) for stage, samples in stages.items() if samples},
+    }
+
+
+def throughput(
+    resources: SearchResources,
+    queries: Sequence[str],
+    concurrency: int,
+    k: int | None = None,
+) -> dict[str, Any]:
+    """QPS of searching every query once with `concurrency` threads."""
+    started = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=concurrency) as pool:
+        list(pool.map(lambda query: search(query, resources, k=k), queries))
+    elapsed = time.perf_counter() - started
+    return {"concurrency": concurrency, "queries": len(queries), "seconds": elapsed, "qps": len(queries) / elapsed if elapsed else 0}
+
+
+def run_benchmark(
+    load_resources: Callable[[], SearchResources],
+    eval_rows: Sequence[EvalRow],
+    query_count: int = 200,
+    concurrency_levels: Sequence[int] = (1, 4),
+    k: int | None = None,
+    seed: int = 0,
+) -> dict[str, Any]:
+    """Load the resources, then time a cold and a warm pass over the query mix and measure QPS.
+
+    The cold pass is the first search of each query after loading (model warm-up, first
+    touch of memory-mapped pages, empty query cache); the warm pass repeats the same queries.
+    """
+    rss_before = rss_bytes()
+    started = time.perf_counter()
+    resources = load_resources()
+    startup_seconds = time.perf_counter() - started
+    rss_loaded = rss_bytes()
+
+    mixed = synthetic_queries(eval_rows, resources.metadata, query_count, seed=seed)
+    queries = [query for _, query in mixed]
+    cold = latency_pass(resources, queries, k=k)
+    warm = latency_pass(resources, queries, k=k)
+    report: dict[str, Any] = {
+        "corpus": {"documents": len(resources.metadata), "queries": len(queries)},
+        "query_mix": {mix: sum(1 for m, _ in mixed if m == mix) for mix in QUERY_MIXES},
+        "startup_seconds": startup_seconds,
+        "cold": cold,
+        "warm": warm,
+        "throughput": [throughput(resources, queries, concurrency, k=k) for concurrency in concurrency_levels],
+        "rss": {
+            "before_load_bytes": rss_before,
+            "after_load_bytes": rss_loaded,
+            "after_benchmark_bytes": rss_bytes(),
+            "peak_bytes": peak_rss_bytes(),
+        },
+    }
+    if resources.cache is not None:
+        report["cache"] = resources.cache.stats()
+    return report
+
+
+def gated_metrics(report: dict[str, Any]) -> dict[str, tuple[float, bool]]:
+    """Metrics find_regressions() compares: name -> (value, higher_is_better)."""
+    metrics: dict[str, tuple[float, bool]] = {"startup_seconds": (report["startup_seconds"], False)}
+    for phase in ("cold", "warm"):
+        for name, value in report[phase]["total"].items():
+            metrics[f"{phase}.total.{name}"] = (value, False)
+    for stage, summary in report["warm"]["stages"].items():
+        for percentile in PERCENTILES:
+            metrics[f"warm.{stage}.p{percentile}_ms"] = (summary[f"p{percentile}_ms"], False)
+    for entry in report["throughput"]:
+        metrics[f"qps@{entry['concurrency']}"] = (entry["qps"], True)
+    if report["rss"].get("peak_bytes"):
+        metrics["rss.peak_bytes"] = (report["rss"]["peak_bytes"], False)
+    return metrics
+
+
+def find_regressions(
+    report: dict[str, Any],
+    baseline: dict[str, Any],
+    max_regression: float = 0.25,
+    min_slack_ms: float = DEFAULT_MIN_SLACK_MS,
+) -> list[str]:
+    """Metrics of report more than max_regression worse than baseline, as readable lines.
+
+    Latencies (``*_ms``) also need to be worse by more than min_slack_ms, so sub-millisecond
+    jitter on fast stages does not fail the gate. Metrics missing from either side are skipped.
+    """
+    current = gated_metrics(report)
+    reference = gated_metrics(baseline)
+    regressions = []
+    for name, (value, higher_is_better) in current.items():
+        if name not in reference:
+            continue
+        expected = reference[name][0]
+        if higher_is_better:
+            limit = expected * (1 - max_regression)
+            failed = value < limit
+        else:
+            limit = expected * (1 + max_regression)
+            if name.endswith("_ms"):
+                limit = max(limit, expected + min_slack_ms)
+            failed = value > limit
+        if failed:
+            regressions.append(f"{name}: {value:.3f} vs baseline {expected:.3f} (limit {limit:.3f})")
+    return regressions
+
+
+def exceeded_budgets(report: dict[str, Any], budgets: dict[str, float]) -> list[str]:
+    """Metrics of report past an absolute budget (a maximum, or a minimum for QPS).
+
+    budgets maps gated_metrics() names to limits. A budgeted metric the report lacks fails, so a
+    renamed stage cannot silently drop out of the gate.
+    """
+    current = gated_metrics(report)
+    exceeded = []
+    for name, limit in budgets.items():
+        if name not in current:
+            exceeded.append(f"{name}: not measured")
+            continue
+        value, higher_is_better = current[name]
+        if (value < limit) if higher_is_better else (value > limit):
+            exceeded.append(f"{name}: {value:.3f} vs budget {limit:.3f}")
+    return exceeded
+
+
+def print_benchmark(report: dict[str, Any]) -> None:
+    corpus = report["corpus"]
+    print(f"Benchmark: {corpus['queries']} queries over {corpus['documents']} documents; mix {report['query_mix']}")
+    print(f"Startup: {report['startup_seconds']:.2f} s")
+    print(f"{'phase':<6} {'stage':<8} {'p50 ms':>9} {'p95 ms':>9} {'p99 ms':>9} {'mean ms':>9}")
+    for phase in ("cold", "warm"):
+        rows = [("total", report[phase]["total"])] + list(report[phase]["stages"].items())
+        for stage, summary in rows:
+            print(
+                f"{phase:<6} {stage:<8} {summary['p50_ms']:>9.3f} {summary['p95_ms']:>9.3f} "
+                f"{summary['p99_ms']:>9.3f} {summary['mean_ms']:>9.3f}"
+            )
+    for entry in report["throughput"]:
+        print(f"QPS with {entry['concurrency']} threads: {entry['qps']:.1f}")
+    rss = report["rss"]
+    if rss.get("after_load_bytes") is not None:
+        print(f"RSS after load: {rss['after_load_bytes'] / 2**20:.1f} MB; peak {rss['peak_bytes'] / 2**20:.1f} MB")
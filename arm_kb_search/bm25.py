@@ -0,0 +1,194 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from collections import Counter
+from typing import Dict, List, Sequence, Tuple
+import math
+
+import numpy as np
+
+
+BM25_K1 = 1.5
+BM25_B = 0.75
+BM25_EPSILON = 0.25
+
+
+class SparseBM25Index:
+    """Okapi BM25 over an inverted index stored as CSR postings.
+
+    Scores match rank_bm25.BM25Okapi (same k1/b/epsilon and idf flooring), but a
+    query only touches the postings of its own terms instead of every document.
+    Per-posting term weights are precomputed, so scoring is a gather plus a sum.
+    """
+
+    def __init__(
+        self,
+        vocabulary: Dict[str, int],
+        idf: np.ndarray,
+        indptr: np.ndarray,
+        doc_ids: np.ndarray,
+        weights: np.ndarray,
+        corpus_size: int,
+    ):
+        self.vocabulary = vocabulary
+        self.idf = idf
+        self.indptr = indptr
+        self.doc_ids = doc_ids
+        self.weights = weights
+        self.corpus_size = corpus_size
+
+    @classmethod
+    def from_corpus(
+        cls,
+        corpus: Sequence[List[str]],
+        k1: float = BM25_K1,
+        b: float = BM25_B,
+        epsilon: float = BM25_EPSILON,
+    ) -> "SparseBM25Index":
+        vocabulary: Dict[str, int] = {}
+        document_frequency: List[int] = []
+        posting_terms: List[int] = []
+        posting_docs: List[int] = []
+        posting_freqs: List[int] = []
+        doc_len = np.zeros(len(corpus), dtype=np.float64)
+
+        for doc_id, document in enumerate(corpus):
+            doc_len[doc_id] = len(document)
+            for token, frequency in Counter(document).items():
+                term_id = vocabulary.setdefault(token, len(vocabulary))
+                if term_id == len(document_frequency):
+                    document_frequency.append(0)
+                document_frequency[term_id] += 1
+                posting_terms.append(term_id)
+                posting_docs.append(doc_id)
+                posting_freqs.append(frequency)
+
+        corpus_size = len(corpus)
+        avgdl = float(doc_len.sum()) / corpus_size if corpus_size else 0.0
+
+        # Same idf definition and negative-idf flooring as BM25Okapi._calc_idf.
+        idf = np.zeros(len(vocabulary), dtype=np.float64)
+        idf_sum = 0.0
+        negative_terms: List[int] = []
+        for term_id, frequency in enumerate(document_frequency):
+            term_idf = math.log(corpus_size - frequency + 0.5) - math.log(frequency + 0.5)
+            idf[term_id] = term_idf
+            idf_sum += term_idf
+            if term_idf < 0:
+                negative_terms.append(term_id)
+        if vocabulary:
+            idf[negative_terms] = epsilon * (idf_sum / len(vocabulary))
+
+        terms = np.asarray(posting_terms, dtype=np.int64)
+        order = np.argsort(terms, kind="stable")
+        doc_ids = np.asarray(posting_docs, dtype=np.int32)[order]
+        term_freqs = np.asarray(posting_freqs, dtype=np.float64)[order]
+        indptr = np.zeros(len(vocabulary) + 1, dtype=np.int64)
+        np.cumsum(np.bincount(terms, minlength=len(vocabulary)), out=indptr[1:])
+
+        if avgdl:
+            length_norm = k1 * (1 - b + b * doc_len[doc_ids] / avgdl)
+            weights = term_freqs * (k1 + 1) / (term_freqs + length_norm)
+        else:
+            weights = np.zeros_like(term_freqs)
+        return cls(
+            vocabulary=vocabulary,
+            idf=idf,
+            indptr=indptr,
+            doc_ids=doc_ids,
+            weights=weights,
+            corpus_size=corpus_size,
+        )
+
+    def _term_postings(self, tokens: Sequence[str]) -> Tuple[np.ndarray, np.ndarray]:
+        doc_parts: List[np.ndarray] = []
+        score_parts: List[np.ndarray] = []
+        for token in tokens:
+            term_id = self.vocabulary.get(token)
+            if term_id is None:
+                continue
+            start, end = self.indptr[term_id], self.indptr[term_id + 1]
+            doc_parts.append(self.doc_ids[start:end])
+            score_parts.append(self.idf[term_id] * self.weights[start:end])
+        if not doc_parts:
+            return np.empty(0, dtype=np.int32), np.empty(0, dtype=np.float64)
+        return np.concatenate(doc_parts), np.concatenate(score_parts)
+
+    def score_candidates(self, tokens: Sequence[str]) -> Tuple[np.ndarray, np.ndarray]:
+        """Return (doc_ids, scores) for every document containing at least one query token."""
+        posting_docs, posting_scores = self._term_postings(tokens)
+        if posting_docs.size == 0:
+            return posting_docs, posting_scores
+        candidate_docs, inverse = np.unique(posting_docs, return_inverse=True)
+        # bincount accumulates in posting order, i.e. query-term order, matching BM25Okapi's summation.
+        scores = np.bincount(inverse, weights=posting_scores, minlength=candidate_docs.size)
+        return candidate_docs, scores
+
+    def get_scores(self, tokens: Sequence[str]) -> np.ndarray:
+        """Dense score vector over the whole corpus, for BM25Okapi.get_scores compatibility."""
+        scores = np.zeros(self.corpus_size, dtype=np.float64)
+        candidate_docs, candidate_scores = self.score_candidates(tokens)
+        scores[candidate_docs] = candidate_scores
+        return scores
+
+    def top_k(self, tokens: Sequence[str], k: int) -> Tuple[np.ndarray, np.ndarray]:
+        """Return up to k positive-scoring (doc_ids, scores), best first, ties broken by doc id."""
+        candidate_docs, scores = self.score_candidates(tokens)
+        return self._select_top_k(candidate_docs, scores, k)
+
+    def top_k_many(self, token_lists: Sequence[Sequence[str]], k: int) -> List[Tuple[np.ndarray, np.ndarray]]:
+        """top_k for several queries with a single unique/bincount pass over all their postings.
+
+        Postings are keyed by (query, doc), so each query's per-document sums accumulate in the
+        same order as score_candidates and the per-query results are identical to top_k.
+        """
+        doc_parts: List[np.ndarray] = []
+        score_parts: List[np.ndarray] = []
+        query_parts: List[np.ndarray] = []
+        for query_id, tokens in enumerate(token_lists):
+            posting_docs, posting_scores = self._term_postings(tokens)
+            doc_parts.append(posting_docs)
+            score_parts.append(posting_scores)
+            query_parts.append(np.full(posting_docs.size, query_id, dtype=np.int64))
+        empty = (np.empty(0, dtype=np.int32), np.empty(0, dtype=np.float64))
+        if not any(part.size for part in doc_parts):
+            return [empty for _ in token_lists]
+
+        keys = np.concatenate(query_parts) * self.corpus_size + np.concatenate(doc_parts)
+        candidate_keys, inverse = np.unique(keys, return_inverse=True)
+        scores = np.bincount(inverse, weights=np.concatenate(score_parts), minlength=candidate_keys.size)
+        candidate_queries, candidate_docs = np.divmod(candidate_keys, self.corpus_size)
+        bounds = np.searchsorted(candidate_queries, np.arange(len(token_lists) + 1))
+        return [
+            self._select_top_k(
+                candidate_docs[bounds[query_id]:bounds[query_id + 1]].astype(np.int32),
+                scores[bounds[query_id]:bounds[query_id + 1]],
+                k,
+            )
+            for query_id in range(len(token_lists))
+        ]
+
+    @staticmethod
+    def _select_top_k(candidate_docs: np.ndarray, scores: np.ndarray, k: int) -> Tuple[np.ndarray, np.ndarray]:
+        positive = scores > 0
+        candidate_docs, scores = candidate_docs[positive], scores[positive]
+        if k <= 0 or candidate_docs.size == 0:
+            return candidate_docs[:0], scores[:0]
+        if candidate_docs.size > k:
+            # Keep every score tied with the k-th best so the doc-id tie-break below stays exact.
+            kth_score = -np.partition(-scores, k - 1)[k - 1]
+            selected = scores >= kth_score
+            candidate_docs, scores = candidate_docs[selected], scores[selected]
+        order = np.lexsort((candidate_docs, -scores))[:k]
+        return candidate_docs[order], scores[order]
@@ -0,0 +1,190 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Bounded LRU caches for query embeddings and formatted search results.
+
+The index and metadata are immutable for a given embeddings image, so cached entries stay
+valid until their content changes; a persisted cache records the content hash it was
+built against and is discarded on load when the hash differs.
+"""
+
+from collections import OrderedDict
+from collections.abc import Hashable, Iterable, Sequence
+import base64
+import copy
+import hashlib
+import json
+import os
+import sys
+import threading
+from typing import Any
+
+import numpy as np
+
+
+QUERY_CACHE_FORMAT_VERSION = 1
+HASH_CHUNK_BYTES = 1 << 20
+
+
+def normalize_query(query: str) -> str:
+    """Cache key for a query: whitespace-collapsed and lowercased.
+
+    Lexical scoring already lowercases every token and all-MiniLM-L6-v2 is an uncased model,
+    so normalized variants of a query retrieve the same results.
+    """
+    return " ".join((query or "").split()).lower()
+
+
+def content_hash(paths: Iterable[str]) -> str:
+    """sha256 over the bytes of every existing path, in order."""
+    digest = hashlib.sha256()
+    for path in paths:
+        if not path or not os.path.isfile(path):
+            continue
+        digest.update(os.path.basename(path).encode("utf-8"))
+        with open(path, "rb") as file:
+            while chunk := file.read(HASH_CHUNK_BYTES):
+                digest.update(chunk)
+    return digest.hexdigest()
+
+
+class _LRU:
+    def __init__(self, max_entries: int):
+        self.max_entries = max_entries
+        self.entries: OrderedDict[Hashable, Any] = OrderedDict()
+        self.hits = 0
+        self.misses = 0
+
+    def get(self, key: Hashable) -> Any:
+        value = self.entries.get(key)
+        if value is None:
+            self.misses += 1
+            return None
+        self.entries.move_to_end(key)
+        self.hits += 1
+        return value
+
+    def put(self, key: Hashable, value: Any) -> None:
+        if self.max_entries <= 0:
+            return
+        self.entries[key] = value
+        self.entries.move_to_end(key)
+        while len(self.entries) > self.max_entries:
+            self.entries.popitem(last=False)
+
+    def stats(self) -> dict[str, int]:
+        return {"entries": len(self.entries), "max_entries": self.max_entries, "hits": self.hits, "misses": self.misses}
+
+
+class QueryCache:
+    """Thread-safe LRU of normalized query -> embedding and (query, k) -> formatted results."""
+
+    def __init__(self, max_entries: int, index_hash: str = "", path: str | None = None):
+        self.index_hash = index_hash
+        self.path = path
+        self._embeddings = _LRU(max_entries)
+        self._results = _LRU(max_entries)
+        self._lock = threading.Lock()
+
+    def get_embedding(self, query: str) -> np.ndarray | None:
+        with self._lock:
+            return self._embeddings.get(normalize_query(query))
+
+    def put_embedding(self, query: str, embedding: np.ndarray) -> None:
+        with self._lock:
+            self._embeddings.put(normalize_query(query), np.asarray(embedding, dtype=np.float32))
+
+    def get_results(self, query: str, k: int) -> list[dict[str, Any]] | None:
+        with self._lock:
+            results = self._results.get((normalize_query(query), k))
+        # Callers own the returned list; the cached copy must never be mutated through it.
+        return copy.deepcopy(results) if results is not None else None
+
+    def put_results(self, query: str, k: int, results: list[dict[str, Any]]) -> None:
+        with self._lock:
+            self._results.put((normalize_query(query), k), copy.deepcopy(results))
+
+    def stats(self) -> dict[str, Any]:
+        with self._lock:
+            return {
+                "index_hash": self.index_hash,
+                "embeddings": self._embeddings.stats(),
+                "results": self._results.stats(),
+            }
+
+    def save(self, path: str | None = None) -> bool:
+        """Write the cache as JSON (embeddings base64-encoded float32); returns False without a path."""
+        path = path or self.path
+        if not path:
+            return False
+        with self._lock:
+            payload = {
+                "format_version": QUERY_CACHE_FORMAT_VERSION,
+                "index_hash": self.index_hash,
+                "embeddings": [
+                    [query, base64.b64encode(embedding.astype(np.float32).tobytes()).decode("ascii")]
+                    for query, embedding in self._embeddings.entries.items()
+                ],
+                "results": [[query, k, results] for (query, k), results in self._results.entries.items()],
+            }
+        os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+        temp_path = f"{path}.tmp"
+        with open(temp_path, "w", encoding="utf-8") as file:
+            json.dump(payload, file, ensure_ascii=False, separators=(",", ":"))
+        os.replace(temp_path, path)
+        return True
+
+    def load(self, path: str | None = None) -> int:
+        """Load entries from a saved cache built against the same index hash; returns entries loaded."""
+        path = path or self.path
+        if not path or not os.path.isfile(path):
+            return 0
+        try:
+            with open(path, "r", encoding="utf-8") as file:
+                payload = json.load(file)
+        except (OSError, ValueError) as exc:
+            print(f"Ignoring unreadable query cache {path}: {exc}", file=sys.stderr)
+            return 0
+        if payload.get("format_version") != QUERY_CACHE_FORMAT_VERSION or payload.get("index_hash") != self.index_hash:
+            print(f"Discarding query cache {path}: built against a different index", file=sys.stderr)
+            return 0
+
+        loaded = 0
+        with self._lock:
+            for query, encoded in payload.get("embeddings", []):
+                self._embeddings.put(query, np.frombuffer(base64.b64decode(encoded), dtype=np.float32))
+                loaded += 1
+            for query, k, results in payload.get("results", []):
+                self._results.put((query, int(k)), results)
+                loaded += 1
+        return loaded
+
+
+class CachedEncoder:
+    """SentenceTransformer stand-in whose encode() serves cached embeddings and batches the misses."""
+
+    def __init__(self, model: Any, cache: QueryCache):
+        self.model = model
+        self.cache = cache
+
+    def encode(self, sentences: Sequence[str], **kwargs: Any) -> np.ndarray:
+        sentences = list(sentences)
+        embeddings: list[np.ndarray | None] = [self.cache.get_embedding(sentence) for sentence in sentences]
+        missing = [position for position, embedding in enumerate(embeddings) if embedding is None]
+        if missing:
+            encoded = np.atleast_2d(self.model.encode([sentences[position] for position in missing], **kwargs))
+            for position, embedding in zip(missing, encoded):
+                self.cache.put_embedding(sentences[position], embedding)
+                embeddings[position] = np.asarray(embedding, dtype=np.float32)
+        return np.stack(embeddings) if embeddings else np.empty((0, 0), dtype=np.float32)
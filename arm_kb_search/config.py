@@ -14,3 +14,26 @@
 
 DISTANCE_THRESHOLD = 1.1
 K_RESULTS = 5
+# Upper bound on queries per search_many call, so one batch cannot monopolise the encoder.
+MAX_BATCH_QUERIES = 32
+
+# Query encoder backends. "onnx" runs the same weights through ONNX Runtime and "onnx-int8" the
+# dynamically quantized arm64 export; all produce embeddings compatible with the f32 index.
+EMBEDDING_BACKEND_TORCH = "torch"
+EMBEDDING_BACKEND_ONNX = "onnx"
+EMBEDDING_BACKEND_ONNX_INT8 = "onnx-int8"
+EMBEDDING_BACKENDS = (EMBEDDING_BACKEND_TORCH, EMBEDDING_BACKEND_ONNX, EMBEDDING_BACKEND_ONNX_INT8)
+ONNX_INT8_FILE_NAME = "onnx/model_qint8_arm64.onnx"
+
+# USearch index storage. f16 halves and i8 quarters vector memory; the builder records the
+# chosen dtype next to the index so the loader always opens it the way it was written.
+USEARCH_METRIC = "l2sq"
+USEARCH_DEFAULT_DTYPE = "f32"
+USEARCH_SUPPORTED_DTYPES = ("f32", "f16", "i8")
+# HNSW parameters the builder uses by default. They are recorded next to the index as well,
+# so the loader opens it with the parameters it was built with (expansion_search applies at
+# query time). Indexes built before they were recorded used these values.
+USEARCH_CONNECTIVITY = 16
+USEARCH_EXPANSION_ADD = 128
+USEARCH_EXPANSION_SEARCH = 64
+USEARCH_HNSW_PARAMS = ("connectivity", "expansion_add", "expansion_search")
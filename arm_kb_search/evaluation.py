@@ -89,6 +89,42 @@ class EvaluationResult:
         return sum(self.reciprocal_ranks) / self.total if self.total else 0
 
 
+@dataclass
+class IndexVariantResult:
+    dtype: str
+    recall_k: int
+    recall_at_k: float
+    mean_latency_ms: float
+    p95_latency_ms: float
+    memory_bytes: int | None
+    retrieval: EvaluationResult
+
+
+@dataclass
+class HnswGridResult:
+    connectivity: int
+    expansion_add: int
+    expansion_search: int
+    build_seconds: float
+    recall_k: int
+    recall_at_k: float
+    mean_latency_ms: float
+    p95_latency_ms: float
+    memory_bytes: int | None
+    retrieval: EvaluationResult
+
+
+def ann_recall_at_k(approximate_keys: list[list[int]], exact_keys: list[list[int]], k: int) -> float:
+    """Mean fraction of each query's exact top-k neighbours that the approximate search also returned."""
+    recalls = []
+    for approximate, exact in zip(approximate_keys, exact_keys):
+        expected = set(exact[:k])
+        if not expected:
+            continue
+        recalls.append(len(expected & set(approximate[:k])) / len(expected))
+    return sum(recalls) / len(recalls) if recalls else 0
+
+
 def load_eval_rows(eval_path: Path) -> list[EvalRow]:
     with eval_path.open() as file:
         rows = json.load(file)
@@ -208,3 +244,56 @@ def print_evaluation(result: EvaluationResult, label: str | None = None) -> None
         print(f"Q: {miss.question}")
         print(f"Expected: {miss.expected_urls}")
         print(f"Got: {miss.ranked_urls}")
+
+
+def print_index_variants(results: list[IndexVariantResult]) -> None:
+    print("Index variants")
+    print(f"{'dtype':<6} {'recall@k':>10} {'mean ms':>9} {'p95 ms':>9} {'memory MB':>10} {'Hit@1':>7} {'Hit@5':>7} {'MRR':>6}")
+    for result in results:
+        memory = f"{result.memory_bytes / 2**20:.1f}" if result.memory_bytes is not None else "n/a"
+        print(
+            f"{result.dtype:<6} {result.recall_at_k:>10.2%} {result.mean_latency_ms:>9.3f} "
+            f"{result.p95_latency_ms:>9.3f} {memory:>10} {result.retrieval.hit_at_1:>7.2%} "
+            f"{result.retrieval.hit_at_5:>7.2%} {result.retrieval.mrr:>6.3f}"
+        )
+    if results:
+        print(f"recall@k is against exact f32 search with k={results[0].recall_k}.")
+
+
+def pick_hnsw_setting(results: list[HnswGridResult], min_recall: float) -> HnswGridResult | None:
+    """The setting with the lowest p95 latency among those reaching min_recall.
+
+    Ties go to the better MRR, then the cheaper build. None when no setting reaches min_recall.
+    """
+    eligible = [result for result in results if result.recall_at_k >= min_recall]
+    if not eligible:
+        return None
+    return min(eligible, key=lambda result: (result.p95_latency_ms, -result.retrieval.mrr, result.build_seconds))
+
+
+def print_hnsw_grid(results: list[HnswGridResult], min_recall: float) -> None:
+    print("HNSW parameter grid")
+    print(
+        f"{'M':>4} {'ef_add':>7} {'ef_search':>10} {'build s':>8} {'recall@k':>10} {'mean ms':>9} "
+        f"{'p95 ms':>9} {'memory MB':>10} {'Hit@1':>7} {'Hit@5':>7} {'MRR':>6}"
+    )
+    for result in results:
+        memory = f"{result.memory_bytes / 2**20:.1f}" if result.memory_bytes is not None else "n/a"
+        print(
+            f"{result.connectivity:>4} {result.expansion_add:>7} {result.expansion_search:>10} "
+            f"{result.build_seconds:>8.2f} {result.recall_at_k:>10.2%} {result.mean_latency_ms:>9.3f} "
+            f"{result.p95_latency_ms:>9.3f} {memory:>10} {result.retrieval.hit_at_1:>7.2%} "
+            f"{result.retrieval.hit_at_5:>7.2%} {result.retrieval.mrr:>6.3f}"
+        )
+    if not results:
+        return
+    print(f"recall@k is against exact search with k={results[0].recall_k}.")
+    best = pick_hnsw_setting(results, min_recall)
+    if best is None:
+        print(f"No setting reached recall@k {min_recall:.2%}; widen the grid.")
+        return
+    print(
+        f"Fastest setting with recall@k >= {min_recall:.2%}: "
+        f"USEARCH_CONNECTIVITY={best.connectivity} USEARCH_EXPANSION_ADD={best.expansion_add} "
+        f"USEARCH_EXPANSION_SEARCH={best.expansion_search}"
+    )
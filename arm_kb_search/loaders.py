@@ -12,33 +12,209 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Dict, List, Optional
+from collections.abc import Sequence
+from dataclasses import dataclass
+from functools import lru_cache
+from typing import Any, Dict, List, Optional, Tuple
 import json
+import mmap
 import os
 
+import numpy as np
 from usearch.index import Index
 
+from .artifacts import (
+    BM25_ARRAY_FILENAMES,
+    BM25_VOCABULARY_FILENAME,
+    MANIFEST_FILENAME,
+    METADATA_BLOB_FILENAME,
+    METADATA_KEYS_FILENAME,
+    METADATA_OFFSETS_FILENAME,
+    SEARCH_ARTIFACTS_FORMAT_VERSION,
+    chunk_keys,
+)
+from .bm25 import SparseBM25Index
+from .config import (
+    USEARCH_CONNECTIVITY,
+    USEARCH_DEFAULT_DTYPE,
+    USEARCH_EXPANSION_ADD,
+    USEARCH_EXPANSION_SEARCH,
+    USEARCH_METRIC,
+    USEARCH_SUPPORTED_DTYPES,
+)
 
-def load_usearch_index(index_path: str, dimension: int) -> Optional[Index]:
-    """Load USearch index from file."""
+METADATA_RECORD_CACHE_SIZE = 4096
+# usearch_index.json "keys" value of an index keyed by chunk_key(chunk_uuid); without it,
+# the key of each vector is its metadata position.
+USEARCH_CHUNK_KEYS = "chunk_uuid"
+
+
+class MappedMetadata(Sequence):
+    """Read-only metadata list backed by a memory-mapped record blob.
+
+    Records are decoded on access, and recently used ones are cached, so startup does not
+    parse the whole corpus and the mapped pages are shared by every process on the host.
+    """
+
+    def __init__(self, blob: mmap.mmap, offsets: np.ndarray):
+        self._blob = blob
+        self._offsets = offsets
+        self._decode = lru_cache(maxsize=METADATA_RECORD_CACHE_SIZE)(self._decode_record)
+
+    def _decode_record(self, position: int) -> Dict[str, Any]:
+        start, end = int(self._offsets[position]), int(self._offsets[position + 1])
+        return json.loads(self._blob[start:end])
+
+    def __len__(self) -> int:
+        return len(self._offsets) - 1
+
+    def __getitem__(self, position):
+        if isinstance(position, slice):
+            return [self[index] for index in range(*position.indices(len(self)))]
+        if position < 0:
+            position += len(self)
+        if not 0 <= position < len(self):
+            raise IndexError("metadata index out of range")
+        return self._decode(position)
+
+
+@dataclass
+class KeyedMatches:
+    keys: np.ndarray
+    distances: np.ndarray
+    counts: Optional[np.ndarray] = None
+
+
+class KeyedIndex:
+    """A USearch index keyed by chunk_key(), presented as if its keys were metadata positions.
+
+    The builder keys vectors by chunk so it can update the index in place; search code reads
+    metadata by the labels search() returns. position_keys[i] is the key of metadata[i].
+    Search results are translated from keys to positions (-1 for a key with no metadata), and
+    get() takes positions. Everything else is forwarded to the wrapped index.
+    """
+
+    def __init__(self, index: Index, position_keys: np.ndarray):
+        self.index = index
+        self.position_keys = np.asarray(position_keys, dtype=np.uint64)
+        self._order = np.argsort(self.position_keys, kind="stable")
+        self._sorted_keys = self.position_keys[self._order]
+
+    def positions(self, keys: np.ndarray) -> np.ndarray:
+        keys = np.asarray(keys, dtype=np.uint64)
+        if not self._sorted_keys.size:
+            return np.full(keys.shape, -1, dtype=np.int64)
+        found = np.minimum(np.searchsorted(self._sorted_keys, keys), self._sorted_keys.size - 1)
+        positions = self._order[found].astype(np.int64)
+        positions[self._sorted_keys[found] != keys] = -1
+        return positions
+
+    def search(self, query: np.ndarray, count: int, **kwargs: Any) -> KeyedMatches:
+        matches = self.index.search(query, count, **kwargs)
+        return KeyedMatches(
+            keys=self.positions(matches.keys),
+            distances=matches.distances,
+            counts=getattr(matches, "counts", None),
+        )
+
+    def get(self, positions: np.ndarray, dtype: Any = np.float32) -> np.ndarray:
+        return self.index.get(self.position_keys[np.asarray(positions, dtype=np.int64)], dtype=dtype)
+
+    def __len__(self) -> int:
+        return len(self.index)
+
+    def __getattr__(self, name: str) -> Any:
+        if name == "index":
+            raise AttributeError(name)
+        return getattr(self.index, name)
+
+
+def usearch_config_path(index_path: str) -> str:
+    """Sidecar JSON that records how the index at index_path was built."""
+    return f"{os.path.splitext(index_path)[0]}.json"
+
+
+def write_usearch_config(index_path: str, config: Dict[str, Any]) -> None:
+    with open(usearch_config_path(index_path), "w") as file:
+        json.dump(config, file, indent=2)
+
+
+def load_usearch_config(index_path: str) -> Dict[str, Any]:
+    """Read the build config for an index; indexes without a sidecar predate it and are f32."""
+    config: Dict[str, Any] = {
+        "metric": USEARCH_METRIC,
+        "dtype": USEARCH_DEFAULT_DTYPE,
+        "connectivity": USEARCH_CONNECTIVITY,
+        "expansion_add": USEARCH_EXPANSION_ADD,
+        "expansion_search": USEARCH_EXPANSION_SEARCH,
+    }
+    config_path = usearch_config_path(index_path)
+    if os.path.exists(config_path):
+        with open(config_path, "r") as file:
+            config.update(json.load(file))
+    if config["dtype"] not in USEARCH_SUPPORTED_DTYPES:
+        raise ValueError(
+            f"Unsupported USearch dtype '{config['dtype']}' in {config_path}. "
+            f"Supported: {list(USEARCH_SUPPORTED_DTYPES)}"
+        )
+    return config
+
+
+def load_usearch_index(
+    index_path: str,
+    dimension: int,
+    view: bool = False,
+    position_keys: Optional[np.ndarray] = None,
+) -> Optional[Index | KeyedIndex]:
+    """Load USearch index from file.
+
+    With view=True the file is memory-mapped read-only instead of copied onto the heap, so
+    processes on one host share the index through the page cache and startup does not scale
+    with index size. A viewed index cannot be modified.
+
+    An index keyed by chunk (see USEARCH_CHUNK_KEYS) is wrapped in a KeyedIndex, which needs
+    position_keys, the chunk_key() of each metadata record (see metadata_chunk_keys).
+    """
     if not os.path.exists(index_path):
         print(f"Error: USearch index file '{index_path}' does not exist.")
         return None
     if dimension <= 0:
         print("Error: Invalid embedding dimension.")
         return None
+    config = load_usearch_config(index_path)
+    if config.get("ndim", dimension) != dimension:
+        print(f"Error: USearch index has {config['ndim']} dimensions but the embedding model produces {dimension}.")
+        return None
     index = Index(
         ndim=dimension,
-        metric="l2sq",
-        dtype="f32",
-        connectivity=16,
-        expansion_add=128,
-        expansion_search=64,
+        metric=config["metric"],
+        dtype=config["dtype"],
+        connectivity=int(config["connectivity"]),
+        expansion_add=int(config["expansion_add"]),
+        expansion_search=int(config["expansion_search"]),
     )
-    index.load(index_path)
+    if view:
+        index.view(index_path)
+    else:
+        index.load(index_path)
+    if config.get("keys") == USEARCH_CHUNK_KEYS:
+        if position_keys is None:
+            print(f"Error: USearch index '{index_path}' is keyed by chunk, but no metadata keys were given.")
+            return None
+        return KeyedIndex(index, position_keys)
     return index
 
 
+def metadata_chunk_keys(metadata: Sequence, artifacts_dir: Optional[str] = None) -> np.ndarray:
+    """chunk_key() of each metadata record, read from the search artifacts when they have it."""
+    keys_path = os.path.join(artifacts_dir, METADATA_KEYS_FILENAME) if artifacts_dir else ""
+    if keys_path and os.path.exists(keys_path):
+        keys = np.load(keys_path, mmap_mode="r")
+        if len(keys) == len(metadata):
+            return keys
+    return chunk_keys(str(item.get("chunk_uuid", "")) for item in metadata)
+
+
 def load_metadata(metadata_path: str) -> List[Dict]:
     """Load metadata from JSON file."""
     if not os.path.exists(metadata_path):
@@ -46,3 +222,47 @@ def load_metadata(metadata_path: str) -> List[Dict]:
         return []
     with open(metadata_path, "r") as file:
         return json.load(file)
+
+
+def load_search_artifacts(artifacts_dir: str) -> Optional[Tuple[MappedMetadata, Optional[SparseBM25Index]]]:
+    """Memory-map prebuilt metadata and BM25 arrays written by write_search_artifacts.
+
+    Returns None when the directory is missing or was written by another format version,
+    so callers can fall back to loading metadata.json and building the index in memory.
+    """
+    manifest_path = os.path.join(artifacts_dir, MANIFEST_FILENAME)
+    if not os.path.exists(manifest_path):
+        return None
+    with open(manifest_path, "r") as file:
+        manifest = json.load(file)
+    if manifest.get("format_version") != SEARCH_ARTIFACTS_FORMAT_VERSION:
+        print(
+            f"Ignoring search artifacts in '{artifacts_dir}': format version "
+            f"{manifest.get('format_version')} != {SEARCH_ARTIFACTS_FORMAT_VERSION}."
+        )
+        return None
+
+    offsets = np.load(os.path.join(artifacts_dir, METADATA_OFFSETS_FILENAME), mmap_mode="r")
+    with open(os.path.join(artifacts_dir, METADATA_BLOB_FILENAME), "rb") as file:
+        # An empty file cannot be mapped; an empty corpus has nothing to read anyway.
+        blob = mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ) if os.fstat(file.fileno()).st_size else b""
+    metadata = MappedMetadata(blob, offsets)
+    if len(metadata) != manifest.get("document_count"):
+        print(f"Ignoring search artifacts in '{artifacts_dir}': document count does not match manifest.")
+        return None
+
+    bm25_manifest = manifest.get("bm25")
+    if not bm25_manifest:
+        return metadata, None
+    with open(os.path.join(artifacts_dir, BM25_VOCABULARY_FILENAME), "r", encoding="utf-8") as file:
+        terms = file.read().split("\n")
+    arrays = {
+        attribute: np.load(os.path.join(artifacts_dir, filename), mmap_mode="r")
+        for attribute, filename in BM25_ARRAY_FILENAMES.items()
+    }
+    bm25_index = SparseBM25Index(
+        vocabulary={term: term_id for term_id, term in enumerate(terms)},
+        corpus_size=int(bm25_manifest["corpus_size"]),
+        **arrays,
+    )
+    return metadata, bm25_index
@@ -12,29 +12,61 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from collections.abc import Sequence
 from dataclasses import dataclass
 import os
+import sys
 from typing import Any
 
-from rank_bm25 import BM25Okapi
 from sentence_transformers import SentenceTransformer
 from usearch.index import Index
 
-from .config import K_RESULTS
-from .loaders import load_metadata, load_usearch_index
+from .artifacts import MANIFEST_FILENAME, METADATA_BLOB_FILENAME
+from .bm25 import SparseBM25Index
+from .cache import CachedEncoder, QueryCache, content_hash, normalize_query
+from .config import (
+    EMBEDDING_BACKEND_ONNX,
+    EMBEDDING_BACKEND_ONNX_INT8,
+    EMBEDDING_BACKEND_TORCH,
+    EMBEDDING_BACKENDS,
+    K_RESULTS,
+    MAX_BATCH_QUERIES,
+    ONNX_INT8_FILE_NAME,
+)
+from .loaders import (
+    USEARCH_CHUNK_KEYS,
+    KeyedIndex,
+    load_metadata,
+    load_search_artifacts,
+    load_usearch_config,
+    load_usearch_index,
+    metadata_chunk_keys,
+)
 from .response import add_disclaimer_to_arm_results, add_utm_source_to_results
-from .search import build_bm25_index, deduplicate_urls, deduplication_candidate_count, hybrid_search
+from .timing import StageTimer, timed
+from .search import (
+    FieldTokenIndex,
+    LazyFieldTokenIndex,
+    build_bm25_index,
+    build_field_token_index,
+    deduplicate_urls,
+    deduplication_candidate_count,
+    hybrid_search,
+    hybrid_search_many,
+)
 
 
 @dataclass
 class SearchResources:
-    metadata: list[dict[str, Any]]
+    metadata: Sequence[dict[str, Any]]
     embedding_model: SentenceTransformer
-    usearch_index: Index | None
-    bm25_index: BM25Okapi | None
+    usearch_index: Index | KeyedIndex | None
+    bm25_index: SparseBM25Index | None
+    field_tokens: FieldTokenIndex | None = None
     default_k: int = K_RESULTS
     include_disclaimers: bool = True
     utm_source: str | None = None
+    cache: QueryCache | None = None
 
 
 def sentence_transformer_cache_folder() -> str | None:
@@ -47,17 +79,31 @@ def embedding_dimension(embedding_model: SentenceTransformer) -> int:
     return int(embedding_model.get_sentence_embedding_dimension())
 
 
+def embedding_backend_kwargs(backend: str) -> dict[str, Any]:
+    """SentenceTransformer keyword arguments selecting the query encoder backend."""
+    if backend not in EMBEDDING_BACKENDS:
+        raise ValueError(f"Unsupported embedding backend '{backend}'. Supported: {list(EMBEDDING_BACKENDS)}")
+    if backend == EMBEDDING_BACKEND_ONNX:
+        return {"backend": "onnx"}
+    if backend == EMBEDDING_BACKEND_ONNX_INT8:
+        return {"backend": "onnx", "model_kwargs": {"file_name": ONNX_INT8_FILE_NAME}}
+    return {}
+
+
 def load_embedding_model(
     model_name: str,
     cache_folder: str | None = None,
     local_files_only_first: bool = True,
+    backend: str = EMBEDDING_BACKEND_TORCH,
 ) -> SentenceTransformer:
     resolved_cache_folder = cache_folder if cache_folder is not None else sentence_transformer_cache_folder()
+    backend_kwargs = embedding_backend_kwargs(backend)
     if not local_files_only_first:
         return SentenceTransformer(
             model_name,
             cache_folder=resolved_cache_folder,
             local_files_only=False,
+            **backend_kwargs,
         )
 
     try:
@@ -65,6 +111,7 @@ def load_embedding_model(
             model_name,
             cache_folder=resolved_cache_folder,
             local_files_only=True,
+            **backend_kwargs,
         )
     except Exception as exc:
         print(f"Local cache miss for embedding model '{model_name}', retrying with network access: {exc}")
@@ -72,6 +119,7 @@ def load_embedding_model(
             model_name,
             cache_folder=resolved_cache_folder,
             local_files_only=False,
+            **backend_kwargs,
         )
 
 
@@ -84,45 +132,147 @@ def load_search_resources(
     default_k: int = K_RESULTS,
     include_disclaimers: bool = True,
     utm_source: str | None = None,
+    search_artifacts_dir: str | None = None,
+    usearch_view: bool = False,
+    query_cache_size: int = 0,
+    query_cache_path: str | None = None,
+    embedding_backend: str = EMBEDDING_BACKEND_TORCH,
 ) -> SearchResources:
-    metadata = load_metadata(metadata_path)
+    # Prebuilt artifacts are memory-mapped; without them, parse metadata.json and build in memory.
+    artifacts = load_search_artifacts(search_artifacts_dir) if search_artifacts_dir else None
+    if artifacts is not None:
+        metadata, bm25_index = artifacts
+        field_tokens: FieldTokenIndex = LazyFieldTokenIndex(metadata)
+    else:
+        metadata = load_metadata(metadata_path)
+        bm25_index = build_bm25_index(metadata)
+        field_tokens = build_field_token_index(metadata)
     embedding_model = load_embedding_model(
         model_name,
         cache_folder=cache_folder,
         local_files_only_first=local_files_only_first,
+        backend=embedding_backend,
     )
+    # Only an index keyed by chunk needs the metadata keys; computing them decodes every record.
+    position_keys = None
+    if os.path.exists(usearch_index_path) and load_usearch_config(usearch_index_path).get("keys") == USEARCH_CHUNK_KEYS:
+        position_keys = metadata_chunk_keys(metadata, search_artifacts_dir if artifacts is not None else None)
     usearch_index = load_usearch_index(
         usearch_index_path,
         embedding_dimension(embedding_model),
+        view=usearch_view,
+        position_keys=position_keys,
     )
-    bm25_index = build_bm25_index(metadata)
+    cache = None
+    if query_cache_size > 0:
+        index_hash = ""
+        if query_cache_path:
+            # Only a persisted cache can outlive the index it was built from, so only it needs the hash.
+            metadata_sources = (
+                [os.path.join(search_artifacts_dir, MANIFEST_FILENAME), os.path.join(search_artifacts_dir, METADATA_BLOB_FILENAME)]
+                if artifacts is not None
+                else [metadata_path]
+            )
+            index_hash = content_hash([usearch_index_path, *metadata_sources])
+            index_hash = f"{index_hash}:{model_name}:{embedding_backend}:{utm_source or ''}:{int(include_disclaimers)}"
+        cache = QueryCache(query_cache_size, index_hash=index_hash, path=query_cache_path)
+        loaded = cache.load()
+        if loaded:
+            # stdout is the MCP stdio transport, so status messages go to stderr.
+            print(f"Loaded {loaded} query cache entries from {query_cache_path}", file=sys.stderr)
     return SearchResources(
         metadata=metadata,
         embedding_model=embedding_model,
         usearch_index=usearch_index,
         bm25_index=bm25_index,
+        field_tokens=field_tokens,
         default_k=default_k,
         include_disclaimers=include_disclaimers,
         utm_source=utm_source,
+        cache=cache,
     )
 
 
+def _query_encoder(resources: SearchResources) -> Any:
+    if resources.cache is None:
+        return resources.embedding_model
+    return CachedEncoder(resources.embedding_model, resources.cache)
+
+
 def search(
     query: str,
     resources: SearchResources,
     k: int | None = None,
+    timer: StageTimer | None = None,
 ) -> list[dict[str, Any]]:
+    """Search the knowledge base; timer, if given, records the time of each stage in SEARCH_STAGES."""
     resolved_k = k or resources.default_k
+    if resources.cache is not None:
+        # Searching the normalized text keeps cache hits and misses returning identical results.
+        with timed(timer, "cache"):
+            query = normalize_query(query)
+            cached = resources.cache.get_results(query, resolved_k)
+        if cached is not None:
+            return cached
     candidate_depth = max(resolved_k * 20, 100)
     search_results = hybrid_search(
         query,
         resources.usearch_index,
         resources.metadata,
-        resources.embedding_model,
+        _query_encoder(resources),
         resources.bm25_index,
         k=deduplication_candidate_count(resolved_k),
         candidate_depth=candidate_depth,
+        field_tokens=resources.field_tokens,
+        timer=timer,
     )
+    with timed(timer, "dedup"):
+        formatted = _format_results(search_results, resources, resolved_k)
+    if resources.cache is not None:
+        resources.cache.put_results(query, resolved_k, formatted)
+    return formatted
+
+
+def search_many(
+    queries: Sequence[str],
+    resources: SearchResources,
+    k: int | None = None,
+) -> list[list[dict[str, Any]]]:
+    """Run search() for several queries at once; results are returned in query order."""
+    if len(queries) > MAX_BATCH_QUERIES:
+        raise ValueError(f"At most {MAX_BATCH_QUERIES} queries can be searched in one batch, got {len(queries)}.")
+    resolved_k = k or resources.default_k
+    cache = resources.cache
+    if cache is not None:
+        queries = [normalize_query(query) for query in queries]
+    formatted: list[list[dict[str, Any]] | None] = [
+        cache.get_results(query, resolved_k) if cache is not None else None for query in queries
+    ]
+    pending = [position for position, results in enumerate(formatted) if results is None]
+    if pending:
+        candidate_depth = max(resolved_k * 20, 100)
+        batch_results = hybrid_search_many(
+            [queries[position] for position in pending],
+            resources.usearch_index,
+            resources.metadata,
+            _query_encoder(resources),
+            resources.bm25_index,
+            k=deduplication_candidate_count(resolved_k),
+            candidate_depth=candidate_depth,
+            field_tokens=resources.field_tokens,
+        )
+        for position, search_results in zip(pending, batch_results):
+            formatted[position] = _format_results(search_results, resources, resolved_k)
+            if cache is not None:
+                cache.put_results(queries[position], resolved_k, formatted[position])
+    return [results or [] for results in formatted]
+
+
+def _format_results(
+    search_results: list[dict[str, Any]],
+    resources: SearchResources,
+    resolved_k: int,
+) -> list[dict[str, Any]]:
     deduped = deduplicate_urls(search_results)[:resolved_k]
     formatted = [
         {
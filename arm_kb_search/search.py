@@ -12,16 +12,19 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Any, Dict, Iterable, List, Optional
+from dataclasses import dataclass
+from typing import Any, Dict, Iterable, List, Optional, Sequence, Union
 import re
+import sys
 from urllib.parse import urlparse
 
 import numpy as np
-from rank_bm25 import BM25Okapi
 from sentence_transformers import SentenceTransformer
-from usearch.index import Index
+from usearch.index import Index, ScalarKind
 
+from .bm25 import SparseBM25Index
 from .config import DISTANCE_THRESHOLD, K_RESULTS
+from .timing import StageTimer, timed
 
 
 SEARCH_TOKEN_PATTERN = re.compile(r"[a-z0-9][a-z0-9_\-+.]*", re.IGNORECASE)
@@ -106,6 +109,54 @@ def direct_intent_tokens(text: str) -> List[str]:
     return [token for token in tokenize_for_search(text) if token not in DIRECT_INTENT_STOPWORDS]
 
 
+@dataclass(frozen=True)
+class QueryAnalysis:
+    """Query tokens and intent flags derived once per query and shared by every scoring stage."""
+
+    query: str
+    tokens: List[str]
+    token_set: frozenset[str]
+    salient_terms: List[str]
+    salient_set: frozenset[str]
+    direct_terms: List[str]
+    direct_set: frozenset[str]
+    scoring_set: frozenset[str]
+    support_capability_tokens: frozenset[str]
+    prefers_tuning_guide: bool
+    prefers_reference_architecture: bool
+    prefers_tutorial: bool
+    compiler_guide_query: bool
+    provider_documentation_query: bool
+
+
+def analyze_query(query: str) -> QueryAnalysis:
+    tokens = tokenize_for_search(query)
+    token_set = frozenset(tokens)
+    salient_terms = [token for token in tokens if token not in SEARCH_STOPWORDS]
+    direct_terms = [token for token in tokens if token not in DIRECT_INTENT_STOPWORDS]
+    salient_set = frozenset(salient_terms)
+    direct_set = frozenset(direct_terms)
+    support_capability_tokens: frozenset[str] = frozenset()
+    if token_set & SUPPORT_INTENT_TOKENS:
+        support_capability_tokens = frozenset(_capability_tokens(token_set))
+    return QueryAnalysis(
+        query=query,
+        tokens=tokens,
+        token_set=token_set,
+        salient_terms=salient_terms,
+        salient_set=salient_set,
+        direct_terms=direct_terms,
+        direct_set=direct_set,
+        scoring_set=direct_set or salient_set or token_set,
+        support_capability_tokens=support_capability_tokens,
+        prefers_tuning_guide=bool(token_set & TUNING_INTENT_TOKENS),
+        prefers_reference_architecture=bool(token_set & REFERENCE_ARCHITECTURE_INTENT_TOKENS),
+        prefers_tutorial=bool(token_set & TUTORIAL_INTENT_TOKENS),
+        compiler_guide_query=bool((token_set & COMPILER_GUIDE_TOKENS) and "guide" in token_set),
+        provider_documentation_query=bool(token_set & PROVIDER_DOCUMENTATION_TOKENS),
+    )
+
+
 def _metadata_text(metadata: Dict[str, Any], fields: Iterable[str]) -> str:
     values: List[str] = []
     for field in fields:
@@ -117,6 +168,93 @@ def _metadata_text(metadata: Dict[str, Any], fields: Iterable[str]) -> str:
     return " ".join(values)
 
 
+@dataclass(frozen=True)
+class ChunkFieldTokens:
+    """Per-chunk token sets precomputed once so scorers never re-tokenize metadata per query."""
+
+    search_text: frozenset[str]
+    title: frozenset[str]
+    heading: frozenset[str]
+    url: frozenset[str]
+    title_url: frozenset[str]
+    support_text: frozenset[str]
+    prepass_url: frozenset[str]
+    prepass_keywords: frozenset[str]
+    prepass_all: frozenset[str]
+    prepass_negative_support: bool
+    rerank_negative_support: bool
+
+
+PREPASS_TEXT_FIELDS = ("title", "heading", "heading_path", "url", "resolved_url", "keywords", "search_text")
+RERANK_TEXT_FIELDS = ("search_text", "title", "heading", "heading_path", "url", "resolved_url")
+
+
+def _interned_token_set(tokens: Iterable[str]) -> frozenset[str]:
+    return frozenset(sys.intern(token) for token in tokens)
+
+
+def build_chunk_field_tokens(metadata: Dict[str, Any]) -> ChunkFieldTokens:
+    search_text = _interned_token_set(tokenize_for_search(metadata.get("search_text", "")))
+    title = _interned_token_set(tokenize_for_search(_metadata_text(metadata, ("title",))))
+    heading = _interned_token_set(tokenize_for_search(_metadata_text(metadata, ("heading", "heading_path"))))
+    url_text = _metadata_text(metadata, ("url", "resolved_url"))
+    url = _interned_token_set(tokenize_url_for_search(url_text))
+    prepass_url = _interned_token_set(tokenize_for_search(url_text))
+    keywords = _interned_token_set(tokenize_for_search(_metadata_text(metadata, ("keywords",))))
+    prepass_keywords = keywords | _interned_token_set(
+        tokenize_for_search(_metadata_text(metadata, ("product", "doc_type")))
+    )
+    return ChunkFieldTokens(
+        search_text=search_text,
+        title=title,
+        heading=heading,
+        url=url,
+        title_url=title | url,
+        support_text=search_text | title | heading | url,
+        prepass_url=prepass_url,
+        prepass_keywords=prepass_keywords,
+        prepass_all=title | heading | prepass_url | keywords | search_text,
+        prepass_negative_support=_has_negative_support_evidence(_metadata_text(metadata, PREPASS_TEXT_FIELDS)),
+        rerank_negative_support=_has_negative_support_evidence(_metadata_text(metadata, RERANK_TEXT_FIELDS)),
+    )
+
+
+def build_field_token_index(metadata: List[Dict[str, Any]]) -> List[ChunkFieldTokens]:
+    """Tokenize every chunk's scoring fields once; interned tokens are shared across chunks."""
+    return [build_chunk_field_tokens(item) for item in metadata]
+
+
+class LazyFieldTokenIndex:
+    """Field token sets built on first use per chunk, for metadata that is memory-mapped rather than loaded."""
+
+    def __init__(self, metadata: Sequence[Dict[str, Any]]):
+        self._metadata = metadata
+        self._tokens: List[Optional[ChunkFieldTokens]] = [None] * len(metadata)
+
+    def __len__(self) -> int:
+        return len(self._tokens)
+
+    def __getitem__(self, position: int) -> ChunkFieldTokens:
+        tokens = self._tokens[position]
+        if tokens is None:
+            tokens = build_chunk_field_tokens(self._metadata[position])
+            self._tokens[position] = tokens
+        return tokens
+
+
+FieldTokenIndex = Union[List[ChunkFieldTokens], LazyFieldTokenIndex]
+
+
+def _candidate_field_tokens(
+    candidate: Dict[str, Any],
+    field_tokens: Optional[FieldTokenIndex],
+) -> ChunkFieldTokens:
+    doc_index = candidate.get("doc_index")
+    if field_tokens is not None and doc_index is not None and 0 <= doc_index < len(field_tokens):
+        return field_tokens[doc_index]
+    return build_chunk_field_tokens(candidate["metadata"])
+
+
 def _token_match_count(query_tokens: set[str], document_tokens: set[str]) -> int:
     matches = 0
     for token in query_tokens:
@@ -147,11 +285,12 @@ def _has_negative_support_evidence(text: str) -> bool:
     return any(pattern.search(text) for pattern in NEGATIVE_SUPPORT_PATTERNS)
 
 
-def _support_evidence_score(query_tokens: set[str], text_tokens: set[str], text: str) -> float:
-    if not (query_tokens & SUPPORT_INTENT_TOKENS):
-        return 0.0
-
-    capability_query_tokens = _capability_tokens(query_tokens)
+def _support_evidence_score(
+    analysis: QueryAnalysis,
+    text_tokens: frozenset[str],
+    has_negative_evidence: bool,
+) -> float:
+    capability_query_tokens = analysis.support_capability_tokens
     if not capability_query_tokens:
         return 0.0
 
@@ -164,82 +303,79 @@ def _support_evidence_score(query_tokens: set[str], text_tokens: set[str], text:
         return 0.0
 
     score = 0.12 * capability_matches
+    query_tokens = analysis.token_set
     if {"device", "devices"} & query_tokens and {"device", "devices"} & text_tokens:
         score += 0.20
     if {"server", "servers"} & query_tokens and {"server", "servers"} & text_tokens:
         score += 0.10
     if {"support", "supported", "supports", "capable"} & text_tokens:
         score += 0.15
-    if _has_negative_support_evidence(text):
+    if has_negative_evidence:
         score += 0.25
     return score
 
 
-
-def _lexical_prepass_score(query: str, metadata: Dict[str, Any], bm25_score: float) -> float:
-    query_tokens = set(tokenize_for_search(query))
-    salient_query_tokens = set(salient_tokens(query))
+def _lexical_prepass_score(
+    query: str,
+    metadata: Dict[str, Any],
+    bm25_score: float,
+    tokens: Optional[ChunkFieldTokens] = None,
+    analysis: Optional[QueryAnalysis] = None,
+) -> float:
+    analysis = analysis or analyze_query(query)
+    query_tokens = analysis.token_set
+    salient_query_tokens = analysis.salient_set
     if not query_tokens:
         return 0.0
+    tokens = tokens or build_chunk_field_tokens(metadata)
 
     weighted_overlap = 0.0
     field_weights = (
-        (("title",), 0.45),
-        (("heading", "heading_path"), 0.50),
-        (("url", "resolved_url"), 0.35),
-        (("keywords", "product", "doc_type"), 0.25),
-        (("search_text",), 0.20),
+        (tokens.title, 0.45),
+        (tokens.heading, 0.50),
+        (tokens.prepass_url, 0.35),
+        (tokens.prepass_keywords, 0.25),
+        (tokens.search_text, 0.20),
     )
-    for fields, weight in field_weights:
-        field_text = _metadata_text(metadata, fields)
-        field_tokens = set(tokenize_for_search(field_text))
+    for field_tokens, weight in field_weights:
         if not field_tokens:
             continue
         denominator = len(salient_query_tokens) or len(query_tokens)
         overlap = _token_match_count(salient_query_tokens or query_tokens, field_tokens) / denominator
         weighted_overlap += weight * overlap
 
-    all_text = _metadata_text(
-        metadata,
-        ("title", "heading", "heading_path", "url", "resolved_url", "keywords", "search_text"),
-    )
-    all_text_lower = all_text.lower()
-    all_tokens = set(tokenize_for_search(all_text))
-
     phrase_bonus = 0.0
-    salient_sequence = salient_tokens(query)
-    for index in range(len(salient_sequence) - 1):
-        phrase = " ".join(salient_sequence[index:index + 2])
-        if phrase and phrase in all_text_lower:
-            phrase_bonus += 0.08
-    for index in range(len(salient_sequence) - 2):
-        phrase = " ".join(salient_sequence[index:index + 3])
-        if phrase and phrase in all_text_lower:
-            phrase_bonus += 0.12
-
-    support_bonus = _support_evidence_score(query_tokens, all_tokens, all_text)
+    salient_sequence = analysis.salient_terms
+    if len(salient_sequence) >= 2:
+        all_text_lower = _metadata_text(metadata, PREPASS_TEXT_FIELDS).lower()
+        for index in range(len(salient_sequence) - 1):
+            phrase = " ".join(salient_sequence[index:index + 2])
+            if phrase and phrase in all_text_lower:
+                phrase_bonus += 0.08
+        for index in range(len(salient_sequence) - 2):
+            phrase = " ".join(salient_sequence[index:index + 3])
+            if phrase and phrase in all_text_lower:
+                phrase_bonus += 0.12
+
+    support_bonus = _support_evidence_score(analysis, tokens.prepass_all, tokens.prepass_negative_support)
     sparse_score = min(1.0, bm25_score / 25.0)
     return sparse_score + weighted_overlap + phrase_bonus + support_bonus
 
 
-def lexical_prepass_search(
-    query: str,
-    metadata: List[Dict],
-    bm25_index: Optional[BM25Okapi],
-    k: int = PINNED_LEXICAL_CANDIDATES,
-    candidate_depth: int = LEXICAL_PREPASS_DEPTH,
+def _pin_lexical_candidates(
+    analysis: QueryAnalysis,
+    candidates: List[Dict[str, Any]],
+    k: int,
+    field_tokens: Optional[FieldTokenIndex] = None,
 ) -> List[Dict[str, Any]]:
-    """Return high-exactness lexical candidates before dense retrieval is merged."""
-    prepass_depth = max(k, candidate_depth)
-    candidates = bm25_search(query, metadata, bm25_index, prepass_depth)
-    if not candidates:
-        return []
     scored_candidates: List[Dict[str, Any]] = []
     for candidate in candidates:
         lexical_score = _lexical_prepass_score(
-            query,
+            analysis.query,
             candidate["metadata"],
             candidate.get("bm25_score", 0.0),
+            _candidate_field_tokens(candidate, field_tokens),
+            analysis,
         )
         if lexical_score <= 0:
             continue
@@ -252,82 +388,203 @@ def lexical_prepass_search(
     return pinned
 
 
-def build_bm25_index(metadata: List[Dict]) -> Optional[BM25Okapi]:
+def lexical_prepass_search(
+    query: str,
+    metadata: Sequence[Dict],
+    bm25_index: Optional[SparseBM25Index],
+    k: int = PINNED_LEXICAL_CANDIDATES,
+    candidate_depth: int = LEXICAL_PREPASS_DEPTH,
+    field_tokens: Optional[FieldTokenIndex] = None,
+    analysis: Optional[QueryAnalysis] = None,
+) -> List[Dict[str, Any]]:
+    """Return high-exactness lexical candidates before dense retrieval is merged."""
+    analysis = analysis or analyze_query(query)
+    prepass_depth = max(k, candidate_depth)
+    candidates = bm25_search(query, metadata, bm25_index, prepass_depth, analysis=analysis)
+    if not candidates:
+        return []
+    return _pin_lexical_candidates(analysis, candidates, k, field_tokens)
+
+
+def build_bm25_index(metadata: List[Dict]) -> Optional[SparseBM25Index]:
     corpus = [tokenize_for_search(item.get("search_text", "")) for item in metadata]
     if not any(corpus):
         return None
-    return BM25Okapi(corpus)
+    return SparseBM25Index.from_corpus(corpus)
+
+
+def _rescore_quantized_matches(
+    usearch_index: Index,
+    query_embedding: np.ndarray,
+    labels: np.ndarray,
+) -> tuple[np.ndarray, np.ndarray]:
+    """Recompute f32 l2sq distances from dequantized vectors so DISTANCE_THRESHOLD keeps its meaning.
+
+    The vectors are the index's f16/i8 ones converted back to f32, not the original embeddings,
+    so this puts distances on the f32 scale and re-ranks the matches but keeps quantization error.
+    """
+    vectors = np.asarray(usearch_index.get(labels, dtype=np.float32), dtype=np.float32).reshape(len(labels), -1)
+    query = np.asarray(query_embedding, dtype=np.float32)
+    distances = ((vectors - query) ** 2).sum(axis=1)
+    order = np.argsort(distances, kind="stable")
+    return labels[order], distances[order]
+
+
+def _match_arrays(matches: Any) -> tuple[Optional[np.ndarray], Optional[np.ndarray]]:
+    labels = getattr(matches, "keys", None)
+    distances = getattr(matches, "distances", None)
+    if labels is None or distances is None:
+        if isinstance(matches, tuple) and len(matches) == 2:
+            labels, distances = matches
+        elif isinstance(matches, dict):
+            labels = matches.get("labels", matches.get("indices"))
+            distances = matches.get("distances")
+    return labels, distances
+
+
+def _dense_results(
+    usearch_index: Index,
+    query_embedding: np.ndarray,
+    labels: np.ndarray,
+    distances: np.ndarray,
+    metadata: Sequence[Dict],
+) -> List[Dict[str, Any]]:
+    results: List[Dict[str, Any]] = []
+    labels = np.atleast_1d(labels)
+    distances = np.atleast_1d(distances)
+    if usearch_index.dtype != ScalarKind.F32 and labels.size:
+        labels, distances = _rescore_quantized_matches(usearch_index, query_embedding, labels)
+    for rank, (idx, dist) in enumerate(zip(labels, distances), start=1):
+        if idx == -1:
+            continue
+        distance = float(dist)
+        if distance < DISTANCE_THRESHOLD:
+            results.append(
+                {
+                    "rank": rank,
+                    "distance": distance,
+                    "doc_index": int(idx),
+                    "metadata": metadata[int(idx)],
+                }
+            )
+    return results
 
 
 def embedding_search(
     query: str,
     usearch_index: Optional[Index],
-    metadata: List[Dict],
+    metadata: Sequence[Dict],
     embedding_model: SentenceTransformer,
     k: int = K_RESULTS,
+    timer: Optional[StageTimer] = None,
 ) -> List[Dict[str, Any]]:
     """Search the USearch index with a text query."""
     if usearch_index is None:
         return []
-    query_embedding = embedding_model.encode([query])[0]
-    matches = usearch_index.search(query_embedding, k)
-    results: List[Dict[str, Any]] = []
+    with timed(timer, "encode"):
+        query_embedding = embedding_model.encode([query])[0]
+    with timed(timer, "dense"):
+        matches = usearch_index.search(query_embedding, k)
+        if matches is None:
+            return []
+
+        try:
+            labels, distances = _match_arrays(matches)
+            if labels is None or distances is None:
+                return []
+            return _dense_results(usearch_index, query_embedding, labels, distances, metadata)
+        except Exception as exc:
+            print(f"Error processing dense matches: {exc}")
+        return []
+
+
+def embedding_search_many(
+    queries: Sequence[str],
+    usearch_index: Optional[Index],
+    metadata: Sequence[Dict],
+    embedding_model: SentenceTransformer,
+    k: int = K_RESULTS,
+) -> List[List[Dict[str, Any]]]:
+    """embedding_search for several queries: one batched encode and one 2-D index search."""
+    if usearch_index is None or not queries:
+        return [[] for _ in queries]
+    query_embeddings = np.atleast_2d(embedding_model.encode(list(queries)))
+    matches = usearch_index.search(query_embeddings, k)
     if matches is None:
-        return results
-
-    try:
-        labels = getattr(matches, "keys", None)
-        distances = getattr(matches, "distances", None)
-        if labels is None or distances is None:
-            if isinstance(matches, tuple) and len(matches) == 2:
-                labels, distances = matches
-            elif isinstance(matches, dict):
-                labels = matches.get("labels", matches.get("indices"))
-                distances = matches.get("distances")
-        if labels is None or distances is None:
-            return results
-
-        labels = np.atleast_1d(labels)
-        distances = np.atleast_1d(distances)
-        for rank, (idx, dist) in enumerate(zip(labels, distances), start=1):
-            if idx == -1:
-                continue
-            distance = float(dist)
-            if distance < DISTANCE_THRESHOLD:
-                results.append(
-                    {
-                        "rank": rank,
-                        "distance": distance,
-                        "metadata": metadata[int(idx)],
-                    }
+        return [[] for _ in queries]
+
+    batch_results: List[List[Dict[str, Any]]] = []
+    labels, distances = _match_arrays(matches)
+    if labels is None or distances is None:
+        return [[] for _ in queries]
+    labels = np.atleast_2d(labels)
+    distances = np.atleast_2d(distances)
+    # BatchMatches rows are padded to k; counts says how many entries of each row are real.
+    counts = getattr(matches, "counts", None)
+    for row, query_embedding in enumerate(query_embeddings):
+        count = int(np.atleast_1d(counts)[row]) if counts is not None else labels.shape[1]
+        try:
+            batch_results.append(
+                _dense_results(
+                    usearch_index,
+                    query_embedding,
+                    labels[row][:count],
+                    distances[row][:count],
+                    metadata,
                 )
-    except Exception as exc:
-        print(f"Error processing dense matches: {exc}")
-    return results
+            )
+        except Exception as exc:
+            print(f"Error processing dense matches: {exc}")
+            batch_results.append([])
+    return batch_results
 
 
 def bm25_search(
     query: str,
-    metadata: List[Dict],
-    bm25_index: Optional[BM25Okapi],
+    metadata: Sequence[Dict],
+    bm25_index: Optional[SparseBM25Index],
     k: int = K_RESULTS,
+    analysis: Optional[QueryAnalysis] = None,
 ) -> List[Dict[str, Any]]:
     if bm25_index is None:
         return []
-    tokens = tokenize_for_search(query)
+    tokens = analysis.tokens if analysis is not None else tokenize_for_search(query)
     if not tokens:
         return []
-    scores = bm25_index.get_scores(tokens)
-    ranking = np.argsort(scores)[::-1]
+    doc_ids, scores = bm25_index.top_k(tokens, k)
+    return _bm25_results(doc_ids, scores, metadata)
+
+
+def bm25_search_many(
+    queries: Sequence[str],
+    metadata: Sequence[Dict],
+    bm25_index: Optional[SparseBM25Index],
+    k: int = K_RESULTS,
+    analyses: Optional[Sequence[QueryAnalysis]] = None,
+) -> List[List[Dict[str, Any]]]:
+    """bm25_search for several queries, scored together by SparseBM25Index.top_k_many."""
+    if bm25_index is None:
+        return [[] for _ in queries]
+    token_lists = (
+        [analysis.tokens for analysis in analyses]
+        if analyses is not None
+        else [tokenize_for_search(query) for query in queries]
+    )
+    return [
+        _bm25_results(doc_ids, scores, metadata)
+        for doc_ids, scores in bm25_index.top_k_many(token_lists, k)
+    ]
+
+
+def _bm25_results(doc_ids: np.ndarray, scores: np.ndarray, metadata: Sequence[Dict]) -> List[Dict[str, Any]]:
     results: List[Dict[str, Any]] = []
-    for rank, idx in enumerate(ranking[:k], start=1):
-        score = float(scores[idx])
-        if score <= 0:
-            continue
+    for rank, (idx, score) in enumerate(zip(doc_ids, scores), start=1):
+        score = float(score)
         results.append(
             {
                 "rank": rank,
                 "bm25_score": score,
+                "doc_index": int(idx),
                 "metadata": metadata[int(idx)],
             }
         )
@@ -364,60 +621,66 @@ def _field_phrase_bonus(query_terms: List[str], field_text: str) -> float:
     return min(0.40, bonus)
 
 
-def rerank_candidates(query: str, candidates: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
-    query_tokens = set(tokenize_for_search(query))
+def rerank_candidates(
+    query: str,
+    candidates: List[Dict[str, Any]],
+    field_tokens: Optional[FieldTokenIndex] = None,
+    analysis: Optional[QueryAnalysis] = None,
+) -> List[Dict[str, Any]]:
+    analysis = analysis or analyze_query(query)
+    query_tokens = analysis.token_set
     if not query_tokens:
         return candidates
-    salient_query_tokens = set(salient_tokens(query))
-    direct_query_terms = direct_intent_tokens(query)
-    direct_query_tokens = set(direct_query_terms)
-    scoring_query_tokens = direct_query_tokens or salient_query_tokens or query_tokens
-    prefers_tuning_guide = bool(query_tokens & TUNING_INTENT_TOKENS)
-    prefers_reference_architecture = bool(query_tokens & REFERENCE_ARCHITECTURE_INTENT_TOKENS)
-    prefers_tutorial = bool(query_tokens & TUTORIAL_INTENT_TOKENS)
+    salient_query_tokens = analysis.salient_set
+    direct_query_terms = analysis.direct_terms
+    direct_query_tokens = analysis.direct_set
+    scoring_query_tokens = analysis.scoring_set
+    prefers_tuning_guide = analysis.prefers_tuning_guide
+    prefers_reference_architecture = analysis.prefers_reference_architecture
+    prefers_tutorial = analysis.prefers_tutorial
+    compiler_guide_query = analysis.compiler_guide_query
 
     reranked: List[Dict[str, Any]] = []
     for candidate in candidates:
         metadata = candidate["metadata"]
-        full_text_tokens = set(tokenize_for_search(metadata.get("search_text", "")))
-        title_text = _metadata_text(metadata, ("title",))
-        heading_text = _metadata_text(metadata, ("heading", "heading_path"))
-        url_text = _metadata_text(metadata, ("url", "resolved_url"))
-        title_tokens = set(tokenize_for_search(title_text))
-        heading_tokens = set(tokenize_for_search(heading_text))
-        url_tokens = set(tokenize_url_for_search(url_text))
-        resolved_url_tokens = set(tokenize_url_for_search(metadata.get("resolved_url", "")))
-        title_url_tokens = title_tokens | url_tokens | resolved_url_tokens
+        tokens = _candidate_field_tokens(candidate, field_tokens)
+        full_text_tokens = tokens.search_text
+        title_tokens = tokens.title
+        heading_tokens = tokens.heading
+        url_tokens = tokens.url
+        title_url_tokens = tokens.title_url
         doc_type = (metadata.get("doc_type", "") or "").strip().lower()
         source_url = metadata.get("url", "") or ""
         provider_doc_bonus = 0.0
-        if (query_tokens & PROVIDER_DOCUMENTATION_TOKENS) and doc_type in {"google cloud documentation"}:
+        if analysis.provider_documentation_query and doc_type in {"google cloud documentation"}:
             provider_doc_bonus = 0.18
         parent_learning_path_bonus = 0.0
         support_evidence_bonus = _support_evidence_score(
-            query_tokens,
-            full_text_tokens | title_tokens | heading_tokens | url_tokens | resolved_url_tokens,
-            _metadata_text(metadata, ("search_text", "title", "heading", "heading_path", "url", "resolved_url")),
+            analysis,
+            tokens.support_text,
+            tokens.rerank_negative_support,
         )
 
         body_overlap = _overlap_ratio(scoring_query_tokens, full_text_tokens)
         title_overlap = _overlap_ratio(scoring_query_tokens, title_tokens)
         heading_overlap = _overlap_ratio(scoring_query_tokens, heading_tokens)
         title_url_overlap = _overlap_ratio(scoring_query_tokens, title_url_tokens)
-        url_overlap = _overlap_ratio(scoring_query_tokens, url_tokens | resolved_url_tokens)
+        url_overlap = _overlap_ratio(scoring_query_tokens, url_tokens)
         if len(scoring_query_tokens) <= 3 and _is_learning_path_root_url(source_url):
             parent_learning_path_bonus = 0.85 if title_url_overlap >= 0.60 else 0.25
 
         entity_overlap = 0.0
         if salient_query_tokens:
-            entity_space = title_tokens | url_tokens | resolved_url_tokens
-            entity_overlap = _overlap_ratio(salient_query_tokens, entity_space)
+            entity_overlap = _overlap_ratio(salient_query_tokens, title_url_tokens)
 
         direct_match_bonus = 0.0
         if scoring_query_tokens:
             direct_match_bonus += 0.35 * title_url_overlap
             direct_match_bonus += 0.15 * url_overlap
-            direct_match_bonus += _field_phrase_bonus(direct_query_terms or list(scoring_query_tokens), f"{title_text} {url_text}")
+            direct_match_bonus += _field_phrase_bonus(
+                direct_query_terms or list(scoring_query_tokens),
+                f"{_metadata_text(metadata, ('title',))} {_metadata_text(metadata, ('url', 'resolved_url'))}",
+            )
             if title_url_overlap >= 0.75:
                 direct_match_bonus += 0.20
             if len(scoring_query_tokens) <= 3 and title_url_overlap >= 0.60:
@@ -439,7 +702,6 @@ def rerank_candidates(query: str, candidates: List[Dict[str, Any]]) -> List[Dict
         if candidate.get("pinned_lexical"):
             lexical_prepass_bonus += 1 / (RRF_K + candidate.get("lexical_prepass_rank", RRF_K))
         doc_type_bonus = 0.0
-        compiler_guide_query = bool((query_tokens & COMPILER_GUIDE_TOKENS) and "guide" in query_tokens)
         if prefers_tuning_guide and not compiler_guide_query:
             if doc_type == "tuning guide":
                 doc_type_bonus += 0.30
@@ -516,22 +778,90 @@ def deduplication_candidate_count(k: int) -> int:
 def hybrid_search(
     query: str,
     usearch_index: Optional[Index],
-    metadata: List[Dict],
+    metadata: Sequence[Dict],
     embedding_model: SentenceTransformer,
-    bm25_index: Optional[BM25Okapi],
+    bm25_index: Optional[SparseBM25Index],
     k: int = K_RESULTS,
     candidate_depth: Optional[int] = None,
+    field_tokens: Optional[FieldTokenIndex] = None,
+    timer: Optional[StageTimer] = None,
 ) -> List[Dict[str, Any]]:
+    """Fuse BM25 and dense candidates and rerank them; timer, if given, records each stage."""
     candidate_depth = candidate_depth or max(k * 20, 100)
-    lexical_results = lexical_prepass_search(
-        query,
+    with timed(timer, "bm25"):
+        analysis = analyze_query(query)
+        # One sparse pass at prepass depth feeds both the pinned lexical stage and the RRF sparse list;
+        # bm25_search rankings are prefix-stable, so the first candidate_depth results are the shallow list.
+        bm25_results = bm25_search(
+            query,
+            metadata,
+            bm25_index,
+            _bm25_depth(k, candidate_depth),
+            analysis=analysis,
+        )
+    dense_results = embedding_search(query, usearch_index, metadata, embedding_model, candidate_depth, timer=timer)
+    return _fuse_candidates(analysis, bm25_results, dense_results, k, candidate_depth, field_tokens, timer)
+
+
+def hybrid_search_many(
+    queries: Sequence[str],
+    usearch_index: Optional[Index],
+    metadata: Sequence[Dict],
+    embedding_model: SentenceTransformer,
+    bm25_index: Optional[SparseBM25Index],
+    k: int = K_RESULTS,
+    candidate_depth: Optional[int] = None,
+    field_tokens: Optional[FieldTokenIndex] = None,
+) -> List[List[Dict[str, Any]]]:
+    """hybrid_search for several queries, batching the embedding forward pass, ANN search and BM25."""
+    candidate_depth = candidate_depth or max(k * 20, 100)
+    analyses = [analyze_query(query) for query in queries]
+    bm25_batches = bm25_search_many(
+        queries,
         metadata,
         bm25_index,
-        k=max(k * 3, PINNED_LEXICAL_CANDIDATES),
-        candidate_depth=max(candidate_depth, LEXICAL_PREPASS_DEPTH),
+        _bm25_depth(k, candidate_depth),
+        analyses=analyses,
     )
-    dense_results = embedding_search(query, usearch_index, metadata, embedding_model, candidate_depth)
-    sparse_results = bm25_search(query, metadata, bm25_index, candidate_depth)
+    dense_batches = embedding_search_many(queries, usearch_index, metadata, embedding_model, candidate_depth)
+    return [
+        _fuse_candidates(analysis, bm25_results, dense_results, k, candidate_depth, field_tokens)
+        for analysis, bm25_results, dense_results in zip(analyses, bm25_batches, dense_batches)
+    ]
+
+
+def _bm25_depth(k: int, candidate_depth: int) -> int:
+    return max(candidate_depth, LEXICAL_PREPASS_DEPTH, k * 3, PINNED_LEXICAL_CANDIDATES)
+
+
+def _fuse_candidates(
+    analysis: QueryAnalysis,
+    bm25_results: List[Dict[str, Any]],
+    dense_results: List[Dict[str, Any]],
+    k: int,
+    candidate_depth: int,
+    field_tokens: Optional[FieldTokenIndex],
+    timer: Optional[StageTimer] = None,
+) -> List[Dict[str, Any]]:
+    with timed(timer, "prepass"):
+        lexical_results = _pin_lexical_candidates(
+            analysis,
+            bm25_results,
+            k=max(k * 3, PINNED_LEXICAL_CANDIDATES),
+            field_tokens=field_tokens,
+        )
+    with timed(timer, "rerank"):
+        return _merge_and_rerank(analysis, lexical_results, bm25_results[:candidate_depth], dense_results, k, field_tokens)
+
+
+def _merge_and_rerank(
+    analysis: QueryAnalysis,
+    lexical_results: List[Dict[str, Any]],
+    sparse_results: List[Dict[str, Any]],
+    dense_results: List[Dict[str, Any]],
+    k: int,
+    field_tokens: Optional[FieldTokenIndex],
+) -> List[Dict[str, Any]]:
 
     candidates: Dict[str, Dict[str, Any]] = {}
     for result in lexical_results:
@@ -543,7 +873,10 @@ def hybrid_search(
 
     for result in dense_results:
         candidate_key = _candidate_key(result)
-        existing = candidates.get(candidate_key, {"metadata": result["metadata"], "rrf_score": 0.0})
+        existing = candidates.get(
+            candidate_key,
+            {"metadata": result["metadata"], "doc_index": result["doc_index"], "rrf_score": 0.0},
+        )
         existing["rank"] = min(existing.get("rank", result["rank"]), result["rank"])
         existing["distance"] = result["distance"]
         existing["rrf_score"] += 1 / (RRF_K + result["rank"])
@@ -551,13 +884,16 @@ def hybrid_search(
 
     for result in sparse_results:
         candidate_key = _candidate_key(result)
-        existing = candidates.get(candidate_key, {"metadata": result["metadata"], "rrf_score": 0.0})
+        existing = candidates.get(
+            candidate_key,
+            {"metadata": result["metadata"], "doc_index": result["doc_index"], "rrf_score": 0.0},
+        )
         existing["rank"] = min(existing.get("rank", result["rank"]), result["rank"])
         existing["bm25_score"] = result["bm25_score"]
         existing["rrf_score"] += 1 / (RRF_K + result["rank"])
         candidates[candidate_key] = existing
 
-    combined = rerank_candidates(query, list(candidates.values()))
+    combined = rerank_candidates(analysis.query, list(candidates.values()), field_tokens, analysis)
     return combined[:k]
 
 
@@ -0,0 +1,86 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Per-stage timing of one search call, and the latency and memory helpers built on it.
+
+Shared by the benchmark harness and the MCP server's per-tool metrics; this module only
+uses the standard library, so the server can use it without loading the harness.
+"""
+
+from __future__ import annotations
+
+from contextlib import contextmanager, nullcontext
+from typing import ContextManager, Iterator
+import math
+import os
+import resource
+import sys
+import time
+
+# Stages search() reports, in pipeline order.
+SEARCH_STAGES = ("cache", "encode", "dense", "bm25", "prepass", "rerank", "dedup")
+
+
+class StageTimer:
+    """Accumulates wall time per named stage, in milliseconds."""
+
+    def __init__(self) -> None:
+        self.stages_ms: dict[str, float] = {}
+
+    @contextmanager
+    def stage(self, name: str) -> Iterator[None]:
+        started = time.perf_counter()
+        try:
+            yield
+        finally:
+            elapsed_ms = (time.perf_counter() - started) * 1000
+            self.stages_ms[name] = self.stages_ms.get(name, 0.0) + elapsed_ms
+
+
+def timed(timer: StageTimer | None, name: str) -> ContextManager[None]:
+    """timer.stage(name), or a no-op when the caller is not timing."""
+    return timer.stage(name) if timer is not None else nullcontext()
+
+
+def latency_percentile(samples_ms: list[float], percentile: float) -> float:
+    """Nearest-rank percentile; 0 for an empty sample."""
+    if not samples_ms:
+        return 0
+    ordered = sorted(samples_ms)
+    rank = max(1, math.ceil(percentile / 100 * len(ordered)))
+    return ordered[rank - 1]
+
+
+def rss_bytes() -> int | None:
+    """Current resident set size, from /proc on Linux."""
+    try:
+        with open("/proc/self/statm", "r") as file:
+            return int(file.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+    except (OSError, ValueError, IndexError):
+        return None
+
+
+def _max_rss_bytes(who: int) -> int:
+    peak = resource.getrusage(who).ru_maxrss
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+    return peak if sys.platform == "darwin" else peak * 1024
+
+
+def peak_rss_bytes() -> int:
+    return _max_rss_bytes(resource.RUSAGE_SELF)
+
+
+def children_peak_rss_bytes() -> int:
+    """Largest peak RSS of any child process waited for so far."""
+    return _max_rss_bytes(resource.RUSAGE_CHILDREN)
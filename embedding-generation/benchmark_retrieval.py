@@ -0,0 +1,111 @@
+"""Benchmark search latency and throughput over the local metadata and index."""
+
+from __future__ import annotations
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[1]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
+
+from arm_kb_search import load_search_resources  # noqa: E402
+from arm_kb_search.benchmark import (  # noqa: E402
+    exceeded_budgets,
+    find_regressions,
+    print_benchmark,
+    run_benchmark,
+)
+from arm_kb_search.config import EMBEDDING_BACKENDS  # noqa: E402
+from arm_kb_search.evaluation import load_eval_rows  # noqa: E402
+
+
+def gate(report: dict, baseline_path: Path | None, budget_path: Path | None, max_regression: float, min_slack_ms: float) -> int:
+    """Print and count the regressions against a baseline report and the breaches of a budget file."""
+    failures: list[str] = []
+    if baseline_path:
+        with baseline_path.open() as file:
+            failures += find_regressions(report, json.load(file), max_regression, min_slack_ms)
+    if budget_path:
+        with budget_path.open() as file:
+            failures += exceeded_budgets(report, json.load(file))
+    if failures:
+        print()
+        print("Benchmark regressions:")
+        for failure in failures:
+            print(f"  {failure}")
+    return 1 if failures else 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Benchmark retrieval latency and throughput over the local knowledge base.")
+    parser.add_argument("--index-path", default="usearch_index.bin")
+    parser.add_argument("--metadata-path", default="metadata.json")
+    parser.add_argument(
+        "--search-artifacts-dir",
+        default="search_artifacts",
+        help="Memory-mapped metadata/BM25 artifacts; falls back to --metadata-path when absent.",
+    )
+    parser.add_argument("--eval-path", default="eval_questions.json")
+    parser.add_argument("--model-name", default="all-MiniLM-L6-v2")
+    parser.add_argument("--embedding-backend", choices=EMBEDDING_BACKENDS, default="torch")
+    parser.add_argument("--usearch-view", action="store_true", help="Memory-map the index, as the MCP server does.")
+    parser.add_argument("--query-cache-size", type=int, default=0, help="Query cache entries; 0 disables the cache.")
+    parser.add_argument("--top-k", type=int, default=5)
+    parser.add_argument("--queries", type=int, default=200, help="Queries in the synthetic mix.")
+    parser.add_argument("--concurrency", default="1,4", help="Comma-separated thread counts for the QPS runs.")
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--output", help="Write the report as JSON; use it as a later --baseline.")
+    parser.add_argument("--baseline", help="Fail when a metric is more than --max-regression worse than this report.")
+    parser.add_argument("--budget", help="Fail when a metric is past the limit given for it in this JSON file.")
+    parser.add_argument("--max-regression", type=float, default=0.25)
+    parser.add_argument("--min-slack-ms", type=float, default=1.0, help="Latency changes smaller than this never fail.")
+    args = parser.parse_args()
+    try:
+        concurrency_levels = [int(value) for value in args.concurrency.split(",") if value.strip()]
+    except ValueError:
+        parser.error("--concurrency must be comma-separated integers.")
+
+    metadata_path = Path(args.metadata_path)
+    artifacts_dir = Path(args.search_artifacts_dir) if args.search_artifacts_dir else None
+    if not metadata_path.exists() and not (artifacts_dir and artifacts_dir.exists()):
+        print(f"Metadata not found: {metadata_path}")
+        return 1
+
+    def load_resources():
+        return load_search_resources(
+            metadata_path=str(metadata_path),
+            usearch_index_path=args.index_path,
+            model_name=args.model_name,
+            search_artifacts_dir=str(artifacts_dir) if artifacts_dir else None,
+            usearch_view=args.usearch_view,
+            query_cache_size=args.query_cache_size,
+            embedding_backend=args.embedding_backend,
+        )
+
+    report = run_benchmark(
+        load_resources,
+        load_eval_rows(Path(args.eval_path)),
+        query_count=args.queries,
+        concurrency_levels=concurrency_levels,
+        k=args.top_k,
+        seed=args.seed,
+    )
+    print_benchmark(report)
+    if args.output:
+        with open(args.output, "w") as file:
+            json.dump(report, file, indent=2)
+        print(f"Report written to {args.output}")
+    return gate(
+        report,
+        Path(args.baseline) if args.baseline else None,
+        Path(args.budget) if args.budget else None,
+        args.max_regression,
+        args.min_slack_ms,
+    )
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
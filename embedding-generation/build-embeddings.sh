@@ -0,0 +1,33 @@
+#!/bin/sh
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Generate chunks and build the vector store in the current directory (/embedding-data in
+# the image). CACHE_DIR keeps the chunks, the resume checkpoint, the embedding cache and
+# the keyed index between runs; with the same CHUNK_RUN_ID an interrupted run resumes.
+#
+# Usage: build-embeddings.sh CACHE_DIR [SOURCES_FILE]
+set -eu
+
+cache_dir="${1:?usage: build-embeddings.sh CACHE_DIR [SOURCES_FILE]}"
+sources_file="${2:-vector-db-sources.csv}"
+
+mkdir -p "$cache_dir/chunk-cache" "$cache_dir/embedding-cache"
+export CHUNKS_FILE="$cache_dir/chunk-cache/chunks.jsonl" \
+       CHUNK_DETAILS_FILE="$cache_dir/chunk-cache/chunk_details.csv" \
+       CHUNK_CHECKPOINT_FILE="$cache_dir/chunk-cache/chunk_checkpoint.jsonl" \
+       EMBEDDING_CACHE_DIR="$cache_dir/embedding-cache"
+
+python3 generate-chunks.py --resume "$sources_file"
+python3 local_vectorstore_creation.py
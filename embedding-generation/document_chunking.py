@@ -987,3 +987,42 @@ def chunk_parsed_document(
                 }
             )
     return chunks
+
+
+def parse_and_chunk_document(
+    response_content: bytes,
+    source_url: str,
+    resolved_url: str,
+    fallback_title: str,
+    doc_type: str,
+    keywords: List[str],
+    content_type: str = "",
+    arm_documentation_api: bool = False,
+    display_url: Optional[str] = None,
+) -> tuple[ParsedDocument, List[Dict[str, str]]]:
+    """Parse one fetched document and chunk it.
+
+    This is the CPU-bound half of chunking a source, kept at module level so a process pool
+    can run it. ``display_url`` replaces the parsed document's URL before chunking, for
+    documents fetched on behalf of another source (transcripts).
+    """
+    if arm_documentation_api:
+        parsed_document = parse_arm_documentation_api_json(
+            response_content=response_content,
+            source_url=source_url,
+            resolved_url=resolved_url,
+            fallback_title=fallback_title,
+        )
+    else:
+        parsed_document = parse_document_content(
+            source_url=source_url,
+            resolved_url=resolved_url,
+            response_content=response_content,
+            content_type=content_type,
+            fallback_title=fallback_title,
+        )
+    if display_url:
+        parsed_document.source_url = display_url
+    if not parsed_document.sections:
+        return parsed_document, []
+    return parsed_document, chunk_parsed_document(parsed_document, doc_type=doc_type, keywords=keywords)
@@ -0,0 +1,130 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Chunk embeddings cached across builds, so only new or changed chunks are encoded.
+
+A model's cache is <cache_dir>/<model name>/embeddings.npy: a structured array with a
+"hash" field (SHA-256 digest of the chunk content, S32, sorted) and a "vector" field (the
+float32 embedding). One file is replaced in one rename, so hashes and vectors always agree.
+"""
+
+from typing import Callable, List, Optional, Sequence
+import hashlib
+import os
+
+import numpy as np
+
+EMBEDDINGS_FILENAME = "embeddings.npy"
+
+
+def content_hash(content: str) -> bytes:
+    return hashlib.sha256(content.encode("utf-8")).digest()
+
+
+def content_hashes(contents: Sequence[str]) -> np.ndarray:
+    return np.array([content_hash(content) for content in contents], dtype="S32")
+
+
+def save_array(path: str, array: np.ndarray) -> None:
+    """np.save to path through a temporary file, so readers never see a partial array."""
+    temp_path = f"{path}.tmp"
+    with open(temp_path, "wb") as file:
+        np.save(file, array)
+    os.replace(temp_path, path)
+
+
+class EmbeddingCache:
+    """Embeddings of one model keyed by chunk content hash, memory-mapped from disk.
+
+    embed() encodes only the contents whose hash is not cached. save() then replaces the
+    cache with the embeddings of the last embed() call, so entries of chunks that are gone
+    are dropped and the cache stays the size of the corpus.
+    """
+
+    def __init__(self, cache_dir: str, model_name: str):
+        self.directory = os.path.join(cache_dir, model_name.replace("/", "__"))
+        self.hashes = np.empty(0, dtype="S32")
+        self.vectors: Optional[np.ndarray] = None
+        self.encoded = 0
+        self._pending = None
+
+    def load(self) -> int:
+        """Map the cached embeddings; a missing or inconsistent cache loads as empty."""
+        path = os.path.join(self.directory, EMBEDDINGS_FILENAME)
+        if not os.path.exists(path):
+            return 0
+        entries = np.load(path, mmap_mode="r")
+        names = entries.dtype.names or ()
+        if "hash" not in names or "vector" not in names or entries["vector"].ndim != 2:
+            print(f"Ignoring embedding cache in {self.directory}: unexpected layout")
+            return 0
+        self.hashes, self.vectors = entries["hash"], entries["vector"]
+        return len(entries)
+
+    def lookup(self, hashes: np.ndarray) -> np.ndarray:
+        """Row of each hash in the cached vectors, or -1 when it is not cached."""
+        if not len(self.hashes):
+            return np.full(len(hashes), -1, dtype=np.int64)
+        rows = np.minimum(np.searchsorted(self.hashes, hashes), len(self.hashes) - 1)
+        rows[self.hashes[rows] != hashes] = -1
+        return rows.astype(np.int64)
+
+    def embed(
+        self,
+        contents: Sequence[str],
+        encode: Callable[[List[str]], np.ndarray],
+        hashes: Optional[np.ndarray] = None,
+    ) -> np.ndarray:
+        """Embeddings of contents, calling encode once with the contents not in the cache.
+
+        hashes are the content_hashes() of contents, when the caller has them already.
+        Contents that occur more than once are encoded once. Returns float32 rows in the
+        order of contents; the number encoded is left in self.encoded.
+        """
+        if hashes is None:
+            hashes = content_hashes(contents)
+        unique, first, inverse = np.unique(hashes, return_index=True, return_inverse=True)
+        rows = self.lookup(unique)
+        missing = np.flatnonzero(rows < 0)
+        encoded = None
+        if missing.size:
+            encoded = np.asarray(encode([contents[first[i]] for i in missing]), dtype=np.float32)
+        ndim = encoded.shape[1] if encoded is not None else (self.vectors.shape[1] if self.vectors is not None else 0)
+        if self.vectors is not None and self.vectors.shape[1] != ndim:
+            raise ValueError(
+                f"Cached embeddings in {self.directory} have {self.vectors.shape[1]} dimensions, "
+                f"the model produced {ndim}; clear the cache."
+            )
+
+        unique_vectors = np.empty((len(unique), ndim), dtype=np.float32)
+        cached = rows >= 0
+        if cached.any():
+            unique_vectors[cached] = self.vectors[rows[cached]]
+        if encoded is not None:
+            unique_vectors[missing] = encoded
+        self.encoded = int(missing.size)
+        self._pending = (unique, unique_vectors)
+        return unique_vectors[inverse.reshape(-1)]
+
+    def save(self) -> None:
+        if self._pending is None:
+            return
+        hashes, vectors = self._pending
+        entries = np.empty(len(hashes), dtype=[("hash", "S32"), ("vector", np.float32, (vectors.shape[1],))])
+        entries["hash"] = hashes
+        entries["vector"] = vectors
+        os.makedirs(self.directory, exist_ok=True)
+        save_array(os.path.join(self.directory, EMBEDDINGS_FILENAME), entries)
+        self.hashes, self.vectors = hashes, vectors
+        self._pending = None
@@ -3,9 +3,13 @@
 from __future__ import annotations
 
 import argparse
+import dataclasses
 import sys
+import time
 from pathlib import Path
 
+import numpy as np
+
 REPO_ROOT = Path(__file__).resolve().parents[1]
 if str(REPO_ROOT) not in sys.path:
     sys.path.insert(0, str(REPO_ROOT))
@@ -14,10 +18,148 @@ from arm_kb_search import (  # noqa: E402
     load_search_resources,
     search,
 )
-from arm_kb_search.evaluation import evaluate_retrieval, load_eval_rows, print_evaluation  # noqa: E402
+from arm_kb_search.config import EMBEDDING_BACKENDS, USEARCH_SUPPORTED_DTYPES  # noqa: E402
+from arm_kb_search.evaluation import (  # noqa: E402
+    EvaluationResult,
+    HnswGridResult,
+    IndexVariantResult,
+    ann_recall_at_k,
+    evaluate_retrieval,
+    load_eval_rows,
+    print_evaluation,
+    print_hnsw_grid,
+    print_index_variants,
+)
+from arm_kb_search.loaders import load_usearch_config  # noqa: E402
+from arm_kb_search.timing import latency_percentile  # noqa: E402
+from local_vectorstore_creation import create_usearch_index  # noqa: E402
+
+
+def _search_keys(index, query: np.ndarray, k: int) -> list[int]:
+    matches = index.search(query, k)
+    return [int(key) for key in np.atleast_1d(matches.keys)]
+
+
+def _exact_reference(resources, eval_rows, recall_k: int) -> tuple[np.ndarray, np.ndarray, list[list[int]]]:
+    """The loaded index's vectors, the encoded questions, and each question's exact top recall_k."""
+    base_index = resources.usearch_index
+    keys = np.arange(len(base_index), dtype=np.uint64)
+    vectors = np.asarray(base_index.get(keys, dtype=np.float32), dtype=np.float32).reshape(len(keys), -1)
+    if base_index.dtype.name.lower() != "f32":
+        print(f"Note: base index is {base_index.dtype.name}; recall is measured against its dequantized vectors.")
+
+    questions = [str(row["question"]) for row in eval_rows]
+    query_vectors = np.asarray(resources.embedding_model.encode(questions), dtype=np.float32)
+    # Exact l2sq neighbours by brute force are the recall reference for every variant.
+    exact_distances = (
+        (vectors ** 2).sum(axis=1)[None, :]
+        - 2 * query_vectors @ vectors.T
+        + (query_vectors ** 2).sum(axis=1)[:, None]
+    )
+    exact_keys = np.argsort(exact_distances, axis=1, kind="stable")[:, :recall_k].tolist()
+    return vectors, query_vectors, exact_keys
+
+
+def _timed_searches(index, query_vectors: np.ndarray, recall_k: int) -> tuple[list[list[int]], list[float]]:
+    latencies_ms: list[float] = []
+    approximate_keys: list[list[int]] = []
+    for query_vector in query_vectors:
+        started = time.perf_counter()
+        approximate_keys.append(_search_keys(index, query_vector, recall_k))
+        latencies_ms.append((time.perf_counter() - started) * 1000)
+    return approximate_keys, latencies_ms
+
+
+def _retrieval_with_index(resources, index, eval_rows, top_k: int) -> EvaluationResult:
+    variant_resources = dataclasses.replace(resources, usearch_index=index)
+
+    def retrieve_urls(question: str, top_k: int) -> list[str | None]:
+        return [item.get("url") for item in search(question, variant_resources, k=top_k)]
+
+    return evaluate_retrieval(eval_rows, retrieve_urls, top_k)
 
 
-def evaluate(index_path: Path, metadata_path: Path, eval_path: Path, model_name: str, top_k: int) -> int:
+def evaluate_index_variants(resources, eval_rows, dtypes: list[str], top_k: int, recall_k: int) -> list[IndexVariantResult]:
+    """Rebuild the loaded index at each dtype and compare ANN recall, latency, and retrieval hit rates."""
+    vectors, query_vectors, exact_keys = _exact_reference(resources, eval_rows, recall_k)
+
+    results: list[IndexVariantResult] = []
+    for dtype in dtypes:
+        index, _ = create_usearch_index(vectors, list(resources.metadata), dtype=dtype)
+        approximate_keys, latencies_ms = _timed_searches(index, query_vectors, recall_k)
+        results.append(
+            IndexVariantResult(
+                dtype=dtype,
+                recall_k=recall_k,
+                recall_at_k=ann_recall_at_k(approximate_keys, exact_keys, recall_k),
+                mean_latency_ms=sum(latencies_ms) / len(latencies_ms) if latencies_ms else 0,
+                p95_latency_ms=latency_percentile(latencies_ms, 95),
+                memory_bytes=getattr(index, "memory_usage", None),
+                retrieval=_retrieval_with_index(resources, index, eval_rows, top_k),
+            )
+        )
+    return results
+
+
+def evaluate_hnsw_grid(
+    resources,
+    eval_rows,
+    connectivities: list[int],
+    expansion_adds: list[int],
+    expansion_searches: list[int],
+    top_k: int,
+    recall_k: int,
+    dtype: str,
+    threads: int = 0,
+) -> list[HnswGridResult]:
+    """Rebuild the loaded index for each connectivity and expansion_add, then search it at each expansion_search.
+
+    expansion_search only changes queries, so each graph is built once and searched at every
+    value; build_seconds is the batch insert time of that graph.
+    """
+    vectors, query_vectors, exact_keys = _exact_reference(resources, eval_rows, recall_k)
+
+    results: list[HnswGridResult] = []
+    for connectivity in connectivities:
+        for expansion_add in expansion_adds:
+            params = {"connectivity": connectivity, "expansion_add": expansion_add, "expansion_search": expansion_searches[0]}
+            started = time.perf_counter()
+            index, _ = create_usearch_index(vectors, [], dtype=dtype, params=params, threads=threads)
+            build_seconds = time.perf_counter() - started
+            for expansion_search in expansion_searches:
+                index.expansion_search = expansion_search
+                approximate_keys, latencies_ms = _timed_searches(index, query_vectors, recall_k)
+                results.append(
+                    HnswGridResult(
+                        connectivity=connectivity,
+                        expansion_add=expansion_add,
+                        expansion_search=expansion_search,
+                        build_seconds=build_seconds,
+                        recall_k=recall_k,
+                        recall_at_k=ann_recall_at_k(approximate_keys, exact_keys, recall_k),
+                        mean_latency_ms=sum(latencies_ms) / len(latencies_ms) if latencies_ms else 0,
+                        p95_latency_ms=latency_percentile(latencies_ms, 95),
+                        memory_bytes=getattr(index, "memory_usage", None),
+                        retrieval=_retrieval_with_index(resources, index, eval_rows, top_k),
+                    )
+                )
+    return results
+
+
+def evaluate(
+    index_path: Path,
+    metadata_path: Path,
+    eval_path: Path,
+    model_name: str,
+    top_k: int,
+    search_artifacts_dir: Path | None = None,
+    index_variants: list[str] | None = None,
+    recall_k: int = 100,
+    embedding_backend: str = "torch",
+    hnsw_grid: dict[str, list[int]] | None = None,
+    min_recall: float = 0.95,
+    threads: int = 0,
+) -> int:
     if not metadata_path.exists() or metadata_path.stat().st_size == 0:
         print(f"Metadata not found or empty: {metadata_path}")
         return 1
@@ -26,6 +168,8 @@ def evaluate(index_path: Path, metadata_path: Path, eval_path: Path, model_name:
         metadata_path=str(metadata_path),
         usearch_index_path=str(index_path),
         model_name=model_name,
+        search_artifacts_dir=str(search_artifacts_dir) if search_artifacts_dir else None,
+        embedding_backend=embedding_backend,
     )
     eval_rows = load_eval_rows(eval_path)
 
@@ -34,6 +178,29 @@ def evaluate(index_path: Path, metadata_path: Path, eval_path: Path, model_name:
 
     result = evaluate_retrieval(eval_rows, retrieve_urls, top_k)
     print_evaluation(result)
+
+    if index_variants:
+        if resources.usearch_index is None:
+            print(f"Cannot compare index variants without a loaded index: {index_path}")
+            return 1
+        print()
+        print_index_variants(evaluate_index_variants(resources, eval_rows, index_variants, top_k, recall_k))
+
+    if hnsw_grid:
+        if resources.usearch_index is None:
+            print(f"Cannot run the HNSW grid without a loaded index: {index_path}")
+            return 1
+        print()
+        grid = evaluate_hnsw_grid(
+            resources,
+            eval_rows,
+            top_k=top_k,
+            recall_k=recall_k,
+            dtype=load_usearch_config(str(index_path))["dtype"],
+            threads=threads,
+            **hnsw_grid,
+        )
+        print_hnsw_grid(grid, min_recall)
     return 1 if result.errors else 0
 
 
@@ -41,10 +208,60 @@ def main() -> int:
     parser = argparse.ArgumentParser(description="Evaluate retrieval over the generated local knowledge base.")
     parser.add_argument("--index-path", default="usearch_index.bin")
     parser.add_argument("--metadata-path", default="metadata.json")
+    parser.add_argument(
+        "--search-artifacts-dir",
+        default="search_artifacts",
+        help="Memory-mapped metadata/BM25 artifacts; falls back to --metadata-path when absent.",
+    )
     parser.add_argument("--eval-path", default="eval_questions.json")
     parser.add_argument("--model-name", default="all-MiniLM-L6-v2")
     parser.add_argument("--top-k", type=int, default=5)
+    parser.add_argument(
+        "--embedding-backend",
+        choices=EMBEDDING_BACKENDS,
+        default="torch",
+        help="Query encoder backend; compare against torch to check ONNX/int8 embeddings against the index.",
+    )
+    parser.add_argument(
+        "--index-variants",
+        default="",
+        help=f"Comma-separated USearch dtypes to rebuild and compare, e.g. {','.join(USEARCH_SUPPORTED_DTYPES)}.",
+    )
+    parser.add_argument("--recall-k", type=int, default=100, help="Neighbours compared for ANN recall@k.")
+    parser.add_argument(
+        "--hnsw-grid",
+        action="store_true",
+        help="Rebuild the index over --connectivity x --expansion-add and search it at each --expansion-search.",
+    )
+    parser.add_argument("--connectivity", default="8,16,32", help="Comma-separated connectivity values for --hnsw-grid.")
+    parser.add_argument("--expansion-add", default="64,128,256", help="Comma-separated expansion_add values for --hnsw-grid.")
+    parser.add_argument(
+        "--expansion-search", default="16,32,64,128", help="Comma-separated expansion_search values for --hnsw-grid."
+    )
+    parser.add_argument(
+        "--min-recall", type=float, default=0.95, help="recall@k the recommended --hnsw-grid setting must reach."
+    )
+    parser.add_argument("--threads", type=int, default=0, help="Threads for index builds; 0 uses every core.")
     args = parser.parse_args()
+    index_variants = [dtype.strip() for dtype in args.index_variants.split(",") if dtype.strip()]
+    unsupported = sorted(set(index_variants) - set(USEARCH_SUPPORTED_DTYPES))
+    if unsupported:
+        parser.error(f"Unsupported index variants {unsupported}; choose from {list(USEARCH_SUPPORTED_DTYPES)}.")
+    hnsw_grid = None
+    if args.hnsw_grid:
+        try:
+            hnsw_grid = {
+                name: [int(value) for value in values.split(",") if value.strip()]
+                for name, values in (
+                    ("connectivities", args.connectivity),
+                    ("expansion_adds", args.expansion_add),
+                    ("expansion_searches", args.expansion_search),
+                )
+            }
+        except ValueError as exc:
+            parser.error(f"--hnsw-grid values must be comma-separated integers: {exc}")
+        if not all(hnsw_grid.values()):
+            parser.error("--connectivity, --expansion-add and --expansion-search each need at least one value.")
 
     return evaluate(
         index_path=Path(args.index_path),
@@ -52,6 +269,13 @@ def main() -> int:
         eval_path=Path(args.eval_path),
         model_name=args.model_name,
         top_k=args.top_k,
+        search_artifacts_dir=Path(args.search_artifacts_dir) if args.search_artifacts_dir else None,
+        index_variants=index_variants,
+        recall_k=args.recall_k,
+        embedding_backend=args.embedding_backend,
+        hnsw_grid=hnsw_grid,
+        min_recall=args.min_recall,
+        threads=args.threads,
     )
 
 
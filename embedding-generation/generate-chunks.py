@@ -17,9 +17,13 @@ import json
 import os
 import re
 import uuid
-import yaml
 import csv
 import datetime
+import hashlib
+import threading
+import time
+from concurrent.futures import ProcessPoolExecutor, ThreadPoolExecutor, as_completed
+from contextlib import nullcontext
 
 import boto3
 from botocore.exceptions import NoCredentialsError, ClientError
@@ -37,14 +41,21 @@ from document_chunking import (
     is_arm_developer_documentation_url,
     learn_learning_path_step_urls,
     normalize_source_url,
-    parse_arm_documentation_api_json,
+    parse_and_chunk_document,
     parse_document_content,
     source_to_fetch_url,
 )
 
 
+# Sources fetched concurrently, and processes parsing the fetched documents.
+FETCH_WORKERS = max(1, int(os.getenv('FETCH_WORKERS', '8')))
+PARSE_WORKERS = max(0, int(os.getenv('PARSE_WORKERS', str(os.cpu_count() or 1))))
+# Requests per second to any one host, shared by all fetch workers (0 disables the limit).
+FETCH_HOST_RATE_LIMIT = float(os.getenv('FETCH_HOST_RATE_LIMIT', '4'))
+
+
 # Create a session with retry logic for resilient HTTP requests
-def create_retry_session(retries=5, backoff_factor=1, status_forcelist=(500, 502, 503, 504)):
+def create_retry_session(retries=5, backoff_factor=1, status_forcelist=(500, 502, 503, 504), pool_maxsize=10):
     """Create a requests session with automatic retry on failures."""
     session = requests.Session()
     retry = Retry(
@@ -55,13 +66,38 @@ def create_retry_session(retries=5, backoff_factor=1, status_forcelist=(500, 502
         status_forcelist=status_forcelist,
         allowed_methods=["HEAD", "GET", "OPTIONS"]
     )
-    adapter = HTTPAdapter(max_retries=retry)
+    adapter = HTTPAdapter(max_retries=retry, pool_connections=pool_maxsize, pool_maxsize=pool_maxsize)
     session.mount("http://", adapter)
     session.mount("https://", adapter)
     return session
 
-# Global session for all HTTP requests
-http_session = create_retry_session()
+
+class HostRateLimiter:
+    """Space requests to the same host at least 1/rate seconds apart, across threads."""
+
+    def __init__(self, rate):
+        self.interval = 1.0 / rate if rate > 0 else 0.0
+        self._next_slot = {}
+        self._lock = threading.Lock()
+
+    def wait(self, url):
+        if not self.interval:
+            return
+        host = urlparse(url).netloc
+        with self._lock:
+            now = time.monotonic()
+            slot = max(now, self._next_slot.get(host, now))
+            self._next_slot[host] = slot + self.interval
+        if slot > now:
+            time.sleep(slot - now)
+
+
+# Global session for all HTTP requests, sized so every fetch worker keeps its connection
+http_session = create_retry_session(pool_maxsize=FETCH_WORKERS)
+host_rate_limiter = HostRateLimiter(FETCH_HOST_RATE_LIMIT)
+# Process pool for parse_and_chunk; None parses in the calling thread.
+parse_pool = None
+errors_lock = threading.Lock()
 
 
 def ensure_intrinsic_chunks_from_s3(local_folder='intrinsic_chunks',
@@ -101,8 +137,11 @@ To fix:
 2. Learning Path titles must come from index page...send through function along with Graviton.
 '''
 
-yaml_dir = os.getenv('YAML_OUTPUT_DIR', 'yaml_data')
+# Every generated chunk, one JSON record per line (read by local_vectorstore_creation.py)
+chunks_file = os.getenv('CHUNKS_FILE', 'chunks/chunks.jsonl')
 details_file = os.getenv('CHUNK_DETAILS_FILE', 'info/chunk_details.csv')
+# Sources whose chunks are all written, so an interrupted run can resume (see --resume)
+checkpoint_file = os.getenv('CHUNK_CHECKPOINT_FILE', 'info/chunk_checkpoint.jsonl')
 
 chunk_index = 1
 
@@ -112,6 +151,7 @@ cross_platform_lps_dont_duplicate = []
 # Cache the ecosystem dashboard page so package entries do not re-fetch the same
 # multi-megabyte HTML document for every source row.
 ecosystem_dashboard_entries = None
+ecosystem_dashboard_lock = threading.Lock()
 
 # Global tracking for vector-db-sources.csv
 # Set of URLs already in the CSV (for deduplication)
@@ -248,7 +288,7 @@ class Chunk:
         """Format keywords list into a lowercase, comma-separated string."""
         return ', '.join(k.strip() for k in keywords).lower()
 
-    # Used to dump into a yaml file without difficulty
+    # Used to write the chunk record to the chunk store
     def toDict(self):
         return {
             'title': self.title,
@@ -273,6 +313,13 @@ def build_ecosystem_dashboard_entries():
     global ecosystem_dashboard_entries
     if ecosystem_dashboard_entries is not None:
         return ecosystem_dashboard_entries
+    with ecosystem_dashboard_lock:
+        if ecosystem_dashboard_entries is None:
+            ecosystem_dashboard_entries = _fetch_ecosystem_dashboard_entries()
+    return ecosystem_dashboard_entries
+
+
+def _fetch_ecosystem_dashboard_entries():
 
     def create_text_snippet(main_row):
         package_name = main_row.get('data-title')
@@ -341,8 +388,7 @@ def build_ecosystem_dashboard_entries():
             "content": create_text_snippet(row),
         }
 
-    ecosystem_dashboard_entries = entries
-    return ecosystem_dashboard_entries
+    return entries
 
 
 def ecosystem_dashboard_slug_from_url(source_url):
@@ -778,29 +824,34 @@ def URLIsValidCheck(url):
         return False
 
 
+def log_fetch_error(url, err):
+    with errors_lock:
+        with open('info/errors.csv', 'a', newline='') as csvfile:
+            csv_writer = csv.writer(csvfile)
+            csv_writer.writerow([url, str(err)])
+
+
 def fetch_with_logging(url):
+    host_rate_limiter.wait(url)
     try:
         response = http_session.get(url, timeout=60)
         response.raise_for_status()
         return response
     except requests.exceptions.HTTPError as http_err:
         print(f"HTTP error occurred: {http_err}")
-        with open('info/errors.csv', 'a', newline='') as csvfile:
-            csv_writer = csv.writer(csvfile)
-            csv_writer.writerow([url, str(http_err)])
+        log_fetch_error(url, http_err)
         return None
     except Exception as err:
         print(f"Other error occurred: {err}")
-        with open('info/errors.csv', 'a', newline='') as csvfile:
-            csv_writer = csv.writer(csvfile)
-            csv_writer.writerow([url, str(err)])
+        log_fetch_error(url, err)
         return None
-    except Exception as err:
-        print(f"Other error occurred: {err}")
-        with open('info/errors.csv', 'a', newline='') as csvfile:
-            csv_writer = csv.writer(csvfile)
-            csv_writer.writerow([url,str(err)])
-        return False
+
+
+def parse_and_chunk(**kwargs):
+    """Run document_chunking.parse_and_chunk_document, in the parse pool when there is one."""
+    if parse_pool is None:
+        return parse_and_chunk_document(**kwargs)
+    return parse_pool.submit(parse_and_chunk_document, **kwargs).result()
 
 
 def obtainMarkdownContentFromGitHubMDFile(gh_url):
@@ -914,21 +965,23 @@ def create_transcript_chunks(source_url, transcript_url, source_name, doc_type,
         return []
 
     keywords = parse_keywords(keywords_value, source_name)
-    parsed_document = parse_document_content(
+    # Keep the primary URL as the user-facing link while still using the transcript
+    # URL as the base for resolving any relative links inside the transcript content.
+    parsed_document, payloads = parse_and_chunk(
+        response_content=response.content,
         source_url=normalize_source_url(transcript_url),
         resolved_url=response.url,
-        response_content=response.content,
-        content_type=response.headers.get("content-type", ""),
         fallback_title=source_name,
+        doc_type=doc_type or "Transcript",
+        keywords=keywords,
+        content_type=response.headers.get("content-type", ""),
+        display_url=normalized_source_url,
     )
-    # Keep the primary URL as the user-facing link while still using the transcript
-    # URL as the base for resolving any relative links inside the transcript content.
-    parsed_document.source_url = normalized_source_url
     if log_no_parsed_sections(parsed_document, normalized_source_url, source_name, transcript_url):
         return []
 
     chunks = []
-    for payload in chunk_parsed_document(parsed_document, doc_type=doc_type or "Transcript", keywords=keywords):
+    for payload in payloads:
         chunks.append(
             createChunk(
                 text_snippet=payload["content"],
@@ -974,16 +1027,18 @@ def create_chunks_for_source(source_url, source_name, doc_type, keywords_value,
     keywords = parse_keywords(keywords_value, source_name)
     chunks = []
     for display_url, source_response in sources_to_parse:
-        parsed_document = parse_document_content(
+        parsed_document, payloads = parse_and_chunk(
+            response_content=source_response.content,
             source_url=display_url,
             resolved_url=source_response.url,
-            response_content=source_response.content,
-            content_type=source_response.headers.get("content-type", ""),
             fallback_title=source_name,
+            doc_type=doc_type or "Documentation",
+            keywords=keywords,
+            content_type=source_response.headers.get("content-type", ""),
         )
         if log_no_parsed_sections(parsed_document, display_url, source_name):
             continue
-        for payload in chunk_parsed_document(parsed_document, doc_type=doc_type or "Documentation", keywords=keywords):
+        for payload in payloads:
             chunks.append(
                 createChunk(
                     text_snippet=payload["content"],
@@ -1041,15 +1096,18 @@ def create_arm_documentation_chunks(source_url, source_name, doc_type, keywords_
                 continue
 
         display_url = arm_service_url_to_developer_url(response.url, source_url)
-        parsed_document = parse_arm_documentation_api_json(
+        parsed_document, payloads = parse_and_chunk(
             response_content=response.content,
             source_url=display_url,
             resolved_url=response.url,
             fallback_title=document_title,
+            doc_type=doc_type or "Documentation",
+            keywords=keywords,
+            arm_documentation_api=True,
         )
         if log_no_parsed_sections(parsed_document, display_url, document_title):
             continue
-        for payload in chunk_parsed_document(parsed_document, doc_type=doc_type or "Documentation", keywords=keywords):
+        for payload in payloads:
             chunks.append(
                 createChunk(
                     text_snippet=payload["content"],
@@ -1068,63 +1126,194 @@ def create_arm_documentation_chunks(source_url, source_name, doc_type, keywords_
     return chunks
 
 
-def chunkSaveAndTrack(url,chunk):
+class ChunkStore:
+    """Append-only JSON Lines store of generated chunks, with per-URL tracking in memory.
 
-    def addNewRow(current_date,chunk_words,chunk_id):
-        return [url,current_date,chunk_words,'1',chunk_id]
-    
-    def addToExistingRow(row,chunk_words,chunk_id):
-        url = row[0] # same URL
-        date = row[1] # same date
-        words = str(int(row[2]) + chunk_words) # update words
-        chunks = row[3] = str(int(row[3]) + 1) # update number of chunks
-        ids = row[4]+ f", {chunk_id}" # update chunk IDs
-        return [url,date,words,chunks,ids]
+    add() buffers chunks and flush() appends them with one write, once per source. Each
+    record is the chunk's toDict() plus 'source_url', the CSV URL it was generated for.
+    The chunk details CSV is derived from the tracking and written once, by write_details().
 
+    add() replaces the chunk's random uuid with one derived from the source URL, the chunk
+    URL and the chunk's position among that URL's chunks, so a rebuild gives an unchanged
+    chunk the same uuid and local_vectorstore_creation.py can update its index in place.
+    """
 
-    def recordChunk():
-        current_date = datetime.date.today().strftime('%Y-%m-%d')
-        chunk_words  = len(chunk.content.split())    
-        chunk_id     = f'chunk_{chunk.uuid}'
+    def __init__(self, path):
+        self.path = path
+        self.pending = []
+        self.sources = {}
+        self.ordinals = {}
 
-        new_rows = []
+    def _track(self, url, chunk_uuid, words):
+        source = self.sources.setdefault(
+            url, {'date': datetime.date.today().strftime('%Y-%m-%d'), 'words': 0, 'chunk_ids': []}
+        )
+        source['words'] += words
+        source['chunk_ids'].append(f'chunk_{chunk_uuid}')
+
+    def reset(self):
+        store_dir = os.path.dirname(self.path)
+        if store_dir:
+            os.makedirs(store_dir, exist_ok=True)
+        open(self.path, 'w', encoding='utf-8').close()
+        self.pending = []
+        self.sources = {}
+        self.ordinals = {}
+
+    def add(self, url, chunk):
+        ordinal = self.ordinals.get((url, chunk.url), 0)
+        self.ordinals[(url, chunk.url)] = ordinal + 1
+        chunk.uuid = str(uuid.uuid5(uuid.NAMESPACE_URL, f"{url}\n{chunk.url}\n{ordinal}"))
+        self.pending.append((url, chunk))
+
+    def flush(self):
+        if not self.pending:
+            return
+        lines = [
+            json.dumps({**chunk.toDict(), 'source_url': url}, ensure_ascii=False) + '\n'
+            for url, chunk in self.pending
+        ]
+        with open(self.path, 'a', encoding='utf-8') as file:
+            file.write(''.join(lines))
+            file.flush()
+            os.fsync(file.fileno())
+        for url, chunk in self.pending:
+            self._track(url, chunk.uuid, len(chunk.content.split()))
+        self.pending = []
+
+    def load(self, keep_urls):
+        """Reopen an existing store, keeping only the chunks of keep_urls.
+
+        Records of other URLs (sources an interrupted run did not finish) and a final line cut
+        short by the interruption are dropped. Returns the number of URLs dropped.
+        """
+        self.pending = []
+        self.sources = {}
+        self.ordinals = {}
+        if not os.path.exists(self.path):
+            self.reset()
+            return 0
+        dropped_urls = set()
+        temp_path = f"{self.path}.tmp"
+        with open(self.path, 'r', encoding='utf-8') as source, open(temp_path, 'w', encoding='utf-8') as kept:
+            for line in source:
+                try:
+                    record = json.loads(line)
+                except json.JSONDecodeError:
+                    continue
+                url = record.get('source_url', record.get('url'))
+                if url not in keep_urls:
+                    dropped_urls.add(url)
+                    continue
+                kept.write(line if line.endswith('\n') else line + '\n')
+                self._track(url, record['uuid'], len(record.get('content', '').split()))
+        os.replace(temp_path, self.path)
+        return len(dropped_urls)
 
-        with open(details_file, mode='r', newline='', encoding='utf-8') as file:
-            csv_reader = csv.reader(file)
-            try:
-                headers = next(csv_reader)  
-                new_rows.append(headers) # keep in memory
-            except StopIteration:
-                pass
+    def write_details(self, path):
+        details_dir = os.path.dirname(path)
+        if details_dir:
+            os.makedirs(details_dir, exist_ok=True)
+        with open(path, mode='w', newline='') as file:
+            csv_writer = csv.writer(file)
+            csv_writer.writerow(['URL', 'Date', 'Number of Words', 'Number of Chunks', 'Chunk IDs'])
+            for url, source in self.sources.items():
+                csv_writer.writerow([
+                    url, source['date'], source['words'], len(source['chunk_ids']), ', '.join(source['chunk_ids'])
+                ])
 
-            url_found = False  # Track if the URL is found in any row
-            
-            # Loop through all the rows after the header
-            for row in csv_reader:
-                if row[0] == url:
-                    new_rows.append(addToExistingRow(row, chunk_words, chunk_id))  # Modify and append the row
-                    url_found = True  # Mark that the URL was found
-                else:
-                    new_rows.append(row)  # Append the row without modification
-            
-            # If the URL was not found, append a new row
-            if not url_found:
-                new_rows.append(addNewRow(current_date, chunk_words, chunk_id))
 
+chunk_store = ChunkStore(chunks_file)
+
+
+def chunkSaveAndTrack(url,chunk):
+    """Queue a chunk for the chunk store; it is written by the next chunk_store.flush()."""
+    chunk_store.add(url, chunk)
+    print(f"{chunk_store.path} <= chunk_{chunk.uuid} === {chunk.title}")
 
-        # Overwrite csv with new info
-        with open(details_file, mode='w', newline='') as file:
-            csv_writer = csv.writer(file, delimiter=',')
-            csv_writer.writerows(new_rows) 
 
-    # Save chunk
-    file_name = f"{yaml_dir}/chunk_{chunk.uuid}.yaml"
-    with open(file_name, 'w') as file:
-        yaml.dump(chunk.toDict(), file, default_flow_style=False, sort_keys=False)
+def checkpoint_run_id(sources_file):
+    """Identify a run by its sources file and CHUNK_RUN_ID, so a checkpoint only resumes the same run."""
+    digest = hashlib.sha256(os.getenv('CHUNK_RUN_ID', '').encode('utf-8'))
+    if os.path.exists(sources_file):
+        with open(sources_file, 'rb') as file:
+            digest.update(file.read())
+    return digest.hexdigest()
 
-    # Record chunk
-    recordChunk()
-    print(f"{file_name} === {chunk.title}")
+
+def load_checkpoint(path, run_id):
+    """Return {row index: chunk count} of the sources run_id finished, or None when there is nothing to resume."""
+    if not os.path.exists(path):
+        return None
+    completed = {}
+    with open(path, 'r', encoding='utf-8') as file:
+        for line_number, line in enumerate(file):
+            try:
+                record = json.loads(line)
+            except json.JSONDecodeError:
+                continue  # a line cut short by the interruption
+            if line_number == 0:
+                if record.get('run') != run_id:
+                    return None
+            elif 'row' in record:
+                completed[record['row']] = record.get('chunks')
+    return completed
+
+
+def start_checkpoint(path, run_id):
+    checkpoint_dir = os.path.dirname(path)
+    if checkpoint_dir:
+        os.makedirs(checkpoint_dir, exist_ok=True)
+    with open(path, 'w', encoding='utf-8') as file:
+        file.write(json.dumps({'run': run_id}) + '\n')
+
+
+def record_checkpoint(path, row, url, chunk_count):
+    with open(path, 'a', encoding='utf-8') as file:
+        file.write(json.dumps({'row': row, 'url': url, 'chunks': chunk_count}) + '\n')
+        file.flush()
+        os.fsync(file.fileno())
+
+
+def chunk_sources_concurrently(csv_dict, rows, on_source_done):
+    """Chunk the given CSV rows with FETCH_WORKERS threads and PARSE_WORKERS parse processes.
+
+    Fetching is I/O bound and runs in threads, rate limited per host. Parsing and chunking
+    are CPU bound and go to the process pool. on_source_done(row, url, chunks) is called on
+    this thread as each source finishes, so chunk files are only ever written from here.
+    Returns the rows that failed.
+    """
+    global parse_pool
+    failed = []
+    process_pool = ProcessPoolExecutor(max_workers=PARSE_WORKERS) if PARSE_WORKERS > 0 else nullcontext()
+    with process_pool as pool, ThreadPoolExecutor(max_workers=FETCH_WORKERS) as fetch_pool:
+        parse_pool = pool
+        try:
+            futures = {
+                fetch_pool.submit(
+                    create_chunks_for_source,
+                    csv_dict['urls'][i],
+                    csv_dict['source_names'][i],
+                    csv_dict['site_names'][i],
+                    csv_dict['focus'][i],
+                    csv_dict['transcript_urls'][i],
+                ): i
+                for i in rows
+            }
+            for future in as_completed(futures):
+                i = futures[future]
+                url = csv_dict['urls'][i]
+                try:
+                    chunks = future.result()
+                except Exception as err:
+                    print(f"[SOURCE FAILED] {url}: {err}")
+                    log_fetch_error(url, err)
+                    failed.append(i)
+                    continue
+                on_source_done(i, url, chunks)
+        finally:
+            parse_pool = None
+    return failed
 
 
 def main():
@@ -1145,6 +1334,13 @@ def main():
              "(to avoid duplicates) and WILL BE OVERWRITTEN with the combined list "
              "of existing + newly discovered sources."
     )
+    parser.add_argument(
+        "--resume",
+        action="store_true",
+        default=os.getenv("RESUME_CHUNKS", "").lower() in {"1", "true", "yes"},
+        help="Keep the chunks of an interrupted run of the same sources file (and CHUNK_RUN_ID) "
+             "and only chunk the sources it did not finish. Also enabled by RESUME_CHUNKS=1."
+    )
     args = parser.parse_args()
     sources_file = args.sources_file
 
@@ -1152,16 +1348,27 @@ def main():
     load_existing_sources(sources_file)
 
     # 0) Initialize files
-    os.makedirs(yaml_dir, exist_ok=True) # create if doesn't exist
-    details_dir = os.path.dirname(details_file)
-    if details_dir:
-        os.makedirs(details_dir, exist_ok=True)
-    for filename in os.listdir(yaml_dir):
-        if filename.startswith('chunk_') and filename.endswith('.yaml'):
-            os.remove(os.path.join(yaml_dir, filename))
-    with open(details_file, mode='w', newline='') as file:
-        writer = csv.writer(file)        
-        writer.writerow(['URL','Date', 'Number of Words', 'Number of Chunks','Chunk IDs'])
+    os.makedirs('info', exist_ok=True)
+    csv_dict, csv_length = readInCSV(sources_file)
+    run_id = checkpoint_run_id(sources_file)
+    completed_rows = load_checkpoint(checkpoint_file, run_id) if args.resume else None
+    if completed_rows is not None and os.path.exists(chunk_store.path):
+        # A URL listed on several rows shares one details row, so it is done only when all are.
+        pending_urls = {csv_dict['urls'][i] for i in range(csv_length) if i not in completed_rows}
+        completed_rows = {
+            i: chunks for i, chunks in completed_rows.items()
+            if i < csv_length and csv_dict['urls'][i] not in pending_urls
+        }
+        pruned = chunk_store.load({csv_dict['urls'][i] for i in completed_rows})
+        print(f"Resuming: {len(completed_rows)} of {csv_length} sources already chunked, "
+              f"{pruned} partially written sources discarded")
+    else:
+        completed_rows = {}
+        chunk_store.reset()
+    # (Re)start the checkpoint with only the sources whose chunks are kept
+    start_checkpoint(checkpoint_file, run_id)
+    for i, chunk_count in sorted(completed_rows.items()):
+        record_checkpoint(checkpoint_file, i, csv_dict['urls'][i], chunk_count)
 
     # 0) Obtain full database information:
     # a) Learning Paths & Install Guides
@@ -1174,19 +1381,24 @@ def main():
     # c) Intrinsics
     #createIntrinsicsDatabaseChunks()
 
-    # 1) Get URLs and details from CSV
-    csv_dict, csv_length = readInCSV(sources_file)
+    # 1) Chunk the CSV sources that are not done yet
+    pending_rows = [i for i in range(csv_length) if i not in completed_rows]
+    print(f'Chunking {len(pending_rows)} sources from {sources_file} '
+          f'({FETCH_WORKERS} fetch workers, {PARSE_WORKERS} parse processes) ......')
 
-    print(f'Starting to loop over CSV file {sources_file} ......')
-    for i in range(csv_length):
-        url = csv_dict['urls'][i]
-        source_name = csv_dict['source_names'][i]
-        doc_type = csv_dict['site_names'][i]
-        keywords_value = csv_dict['focus'][i]
-        transcript_url = csv_dict['transcript_urls'][i]
+    # Chunks emitted by the discovery stage
+    chunk_store.flush()
 
-        for chunk in create_chunks_for_source(url, source_name, doc_type, keywords_value, transcript_url):
+    def save_source_chunks(row, url, chunks):
+        for chunk in chunks:
             chunkSaveAndTrack(url, chunk)
+        chunk_store.flush()
+        record_checkpoint(checkpoint_file, row, url, len(chunks))
+
+    failed_rows = chunk_sources_concurrently(csv_dict, pending_rows, save_source_chunks)
+    if failed_rows:
+        print(f"{len(failed_rows)} sources failed and were skipped; see info/errors.csv")
+    chunk_store.write_details(details_file)
 
     # Save updated sources CSV with all discovered sources
     save_sources_csv(sources_file)
@@ -15,14 +15,37 @@
 import yaml
 import numpy as np
 import math
-from typing import List, Dict, Tuple
+from typing import List, Dict, Optional, Tuple
 import json
 import os
+import sys
 import glob
-import datetime
+from pathlib import Path
 from sentence_transformers import SentenceTransformer
 from usearch.index import Index
 
+REPO_ROOT = Path(__file__).resolve().parents[1]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
+
+from arm_kb_search import build_bm25_index, chunk_keys, write_search_artifacts  # noqa: E402
+from arm_kb_search.config import (  # noqa: E402
+    USEARCH_CONNECTIVITY,
+    USEARCH_DEFAULT_DTYPE,
+    USEARCH_EXPANSION_ADD,
+    USEARCH_EXPANSION_SEARCH,
+    USEARCH_HNSW_PARAMS,
+    USEARCH_METRIC,
+    USEARCH_SUPPORTED_DTYPES,
+)
+from arm_kb_search.loaders import USEARCH_CHUNK_KEYS, load_usearch_config, write_usearch_config  # noqa: E402
+from embedding_cache import EmbeddingCache, content_hashes  # noqa: E402
+
+EMBEDDING_MODEL = 'all-MiniLM-L6-v2'
+# The keyed index kept next to the embedding cache, and the chunk key and content hash of each vector in it
+INDEX_STATE_INDEX_FILENAME = 'index.usearch'
+INDEX_STATE_FILENAME = 'index_state.npz'
+
 
 def sentence_transformer_cache_folder():
     return os.getenv("SENTENCE_TRANSFORMERS_HOME") or None
@@ -71,7 +94,37 @@ def load_local_yaml_files() -> List[Dict]:
     return yaml_contents
 
 
-def create_embeddings(contents: List[str], model_name: str = 'all-MiniLM-L6-v2') -> np.ndarray:
+def load_chunks_file(chunks_file: str) -> List[Dict]:
+    """Stream the JSON Lines chunk store written by generate-chunks.py.
+
+    chunk_uuid keeps the form chunks had as yaml_data/chunk_<uuid>.yaml files, so ids are
+    stable across the change of format. A malformed line (an interrupted write) is skipped.
+    """
+    if not os.path.exists(chunks_file):
+        print(f"Chunk store {chunks_file} not found")
+        return []
+    chunks = []
+    with open(chunks_file, 'r', encoding='utf-8') as f:
+        for line_number, line in enumerate(f, 1):
+            if not line.strip():
+                continue
+            try:
+                record = json.loads(line)
+            except json.JSONDecodeError as e:
+                print(f"Skipping malformed line {line_number} of {chunks_file}: {e}")
+                continue
+            record['chunk_uuid'] = f"yaml_data_chunk_{record['uuid']}"
+            chunks.append(record)
+    print(f"Loaded {len(chunks)} chunks from {chunks_file}")
+    return chunks
+
+
+def load_chunks() -> List[Dict]:
+    """All chunks to index: the intrinsic (and any legacy) YAML files plus the chunk store."""
+    return load_local_yaml_files() + load_chunks_file(os.getenv("CHUNKS_FILE", "chunks/chunks.jsonl"))
+
+
+def create_embeddings(contents: List[str], model_name: str = EMBEDDING_MODEL) -> np.ndarray:
     """Create embeddings for the given contents using SentenceTransformers."""
     print(f"Creating embeddings using model: {model_name}")
     model = SentenceTransformer(
@@ -84,38 +137,204 @@ def create_embeddings(contents: List[str], model_name: str = 'all-MiniLM-L6-v2')
     return embeddings
 
 
-def create_usearch_index(embeddings: np.ndarray, metadata: List[Dict]) -> Tuple[Index, List[Dict]]:
-    """Create a USearch index with the given embeddings and metadata."""
-    print("Creating USearch index")
-    print(f"Embeddings shape: {embeddings.shape}")
-    
-    dimension = embeddings.shape[1]
-    num_vectors = embeddings.shape[0]
-    
-    # Create USearch index
-    index = Index(
+def usearch_build_params() -> Dict[str, int]:
+    """HNSW parameters for the build: USEARCH_CONNECTIVITY, USEARCH_EXPANSION_ADD and
+    USEARCH_EXPANSION_SEARCH, defaulting to arm_kb_search.config."""
+    return {
+        'connectivity': int(os.getenv('USEARCH_CONNECTIVITY', USEARCH_CONNECTIVITY)),
+        'expansion_add': int(os.getenv('USEARCH_EXPANSION_ADD', USEARCH_EXPANSION_ADD)),
+        'expansion_search': int(os.getenv('USEARCH_EXPANSION_SEARCH', USEARCH_EXPANSION_SEARCH)),
+    }
+
+
+def usearch_rebuild_fraction() -> float:
+    """Share of the last full build's vectors that may be removed or replaced in place before
+    the index is rebuilt (USEARCH_REBUILD_FRACTION, default 0.25). Removed vectors stay in
+    the graph as tombstones, so an index updated too often slows down and loses recall."""
+    return float(os.getenv('USEARCH_REBUILD_FRACTION', '0.25'))
+
+
+def usearch_build_threads() -> int:
+    """Threads for bulk inserts (USEARCH_THREADS); 0 lets USearch use every core."""
+    return int(os.getenv('USEARCH_THREADS', '0'))
+
+
+def new_usearch_index(
+    dimension: int,
+    dtype: str = USEARCH_DEFAULT_DTYPE,
+    params: Optional[Dict[str, int]] = None,
+) -> Index:
+    params = {**usearch_build_params(), **(params or {})}
+    return Index(
         ndim=dimension,
-        metric='l2sq',
-        dtype='f32',
-        connectivity=16,
-        expansion_add=128,
-        expansion_search=64
+        metric=USEARCH_METRIC,
+        dtype=dtype,
+        connectivity=params['connectivity'],
+        expansion_add=params['expansion_add'],
+        expansion_search=params['expansion_search'],
     )
-    
-    # Add vectors to the index
+
+
+def create_usearch_index(
+    embeddings: np.ndarray,
+    metadata: List[Dict],
+    dtype: str = USEARCH_DEFAULT_DTYPE,
+    keys: Optional[np.ndarray] = None,
+    params: Optional[Dict[str, int]] = None,
+    threads: Optional[int] = None,
+) -> Tuple[Index, List[Dict]]:
+    """Create a USearch index with the given embeddings and metadata.
+
+    dtype selects the stored vector precision: f32, f16 (half the memory) or i8 (a quarter;
+    assumes the normalized embeddings all-MiniLM-L6-v2 produces). keys are the vector keys;
+    by default each vector is keyed by its position. params override usearch_build_params(),
+    and the vectors are inserted in one batch on `threads` threads (usearch_build_threads()).
+    """
+    if dtype not in USEARCH_SUPPORTED_DTYPES:
+        raise ValueError(f"Unsupported USearch dtype '{dtype}'. Supported: {list(USEARCH_SUPPORTED_DTYPES)}")
+    print(f"Creating USearch index ({dtype})")
+    print(f"Embeddings shape: {embeddings.shape}")
+
+    num_vectors = embeddings.shape[0]
+    index = new_usearch_index(embeddings.shape[1], dtype, params)
+    threads = usearch_build_threads() if threads is None else threads
+
     print(f"Adding {num_vectors} vectors to the index")
-    for i, embedding in enumerate(embeddings):
-        index.add(i, embedding)
-    
+    if num_vectors:
+        keys = keys if keys is not None else np.arange(num_vectors, dtype=np.uint64)
+        index.add(keys, np.ascontiguousarray(embeddings, dtype=np.float32), threads=threads)
+
     print(f"Added {len(index)} vectors to the index")
     return index, metadata
 
 
+def _load_index_state(
+    state_dir: str,
+    dimension: int,
+    dtype: str,
+    params: Dict[str, int],
+) -> Optional[Tuple[Index, np.ndarray, np.ndarray, int, int]]:
+    """The saved keyed index with its keys and hashes, or None when it cannot be updated in place.
+
+    The last two items are the vectors removed or replaced since the last full build and the
+    size of that build; state saved before they were tracked counts as freshly built.
+
+    A graph built with other connectivity or expansion_add is rebuilt; expansion_search only
+    affects queries, so an index saved with another value is reused.
+    """
+    index_path = os.path.join(state_dir, INDEX_STATE_INDEX_FILENAME)
+    state_path = os.path.join(state_dir, INDEX_STATE_FILENAME)
+    if not (os.path.exists(index_path) and os.path.exists(state_path)):
+        return None
+    config = load_usearch_config(index_path)
+    saved = (config.get('metric'), config.get('dtype'), config.get('ndim'), config['connectivity'], config['expansion_add'])
+    if saved != (USEARCH_METRIC, dtype, dimension, params['connectivity'], params['expansion_add']):
+        print(f"Saved USearch index in {state_dir} was built with {config}; rebuilding")
+        return None
+    with np.load(state_path) as state:
+        keys, hashes = state['keys'], state['hashes']
+        churn = int(state['churn']) if 'churn' in state.files else 0
+        built_size = int(state['built_size']) if 'built_size' in state.files else len(keys)
+    index = new_usearch_index(dimension, dtype, params)
+    index.load(index_path)
+    if len(index) != len(keys):
+        print(f"Saved USearch index in {state_dir} does not match its state; rebuilding")
+        return None
+    return index, keys, hashes, churn, built_size
+
+
+def update_usearch_index(
+    state_dir: str,
+    keys: np.ndarray,
+    hashes: np.ndarray,
+    embeddings: np.ndarray,
+    dtype: str = USEARCH_DEFAULT_DTYPE,
+    rebuild: bool = False,
+    params: Optional[Dict[str, int]] = None,
+    rebuild_fraction: Optional[float] = None,
+) -> Tuple[Index, Dict[str, int]]:
+    """Bring the keyed index saved in state_dir up to date with the current chunks.
+
+    keys[i] is the chunk_key() and hashes[i] the content hash of embeddings[i]. Vectors of
+    chunks that are gone are removed, those whose content changed are replaced, and new ones
+    are added; unchanged chunks are left alone. The index is built from scratch when there is
+    no saved index for this dtype, metric, dimension and graph parameters, when rebuild
+    is set, or when this update would take the vectors removed or replaced since the last
+    full build past rebuild_fraction (usearch_rebuild_fraction()) of that build's size.
+    """
+    if dtype not in USEARCH_SUPPORTED_DTYPES:
+        raise ValueError(f"Unsupported USearch dtype '{dtype}'. Supported: {list(USEARCH_SUPPORTED_DTYPES)}")
+    dimension = int(embeddings.shape[1])
+    params = {**usearch_build_params(), **(params or {})}
+    rebuild_fraction = usearch_rebuild_fraction() if rebuild_fraction is None else rebuild_fraction
+    saved = None if rebuild else _load_index_state(state_dir, dimension, dtype, params)
+    if saved is not None:
+        index, saved_keys, saved_hashes, churn, built_size = saved
+        previous = dict(zip(saved_keys.tolist(), saved_hashes.tolist()))
+        current = set(keys.tolist())
+        added, changed = [], []
+        for row, (key, digest) in enumerate(zip(keys.tolist(), hashes.tolist())):
+            if key not in previous:
+                added.append(row)
+            elif previous[key] != digest:
+                changed.append(row)
+        stale = [key for key in previous if key not in current] + [int(keys[row]) for row in changed]
+        churn += len(stale)
+        if churn > rebuild_fraction * max(built_size, 1):
+            print(
+                f"{churn} of the {built_size} vectors of the last full build were removed or replaced; "
+                f"rebuilding the USearch index"
+            )
+            saved = None
+    stats = {'added': 0, 'updated': 0, 'removed': 0, 'unchanged': 0, 'rebuilt': int(saved is None)}
+    if saved is None:
+        index, _ = create_usearch_index(embeddings, [], dtype=dtype, keys=keys, params=params)
+        stats['added'] = len(keys)
+        churn, built_size = 0, len(keys)
+    else:
+        if stale:
+            index.remove(np.array(stale, dtype=np.uint64))
+        rows = np.array(changed + added, dtype=np.int64)
+        if rows.size:
+            index.add(keys[rows], np.ascontiguousarray(embeddings[rows], dtype=np.float32), threads=usearch_build_threads())
+        stats.update(
+            added=len(added),
+            updated=len(changed),
+            removed=len(stale) - len(changed),
+            unchanged=len(keys) - len(added) - len(changed),
+        )
+
+    os.makedirs(state_dir, exist_ok=True)
+    state_path = os.path.join(state_dir, INDEX_STATE_FILENAME)
+    # Drop the state first: an index saved without its state is rebuilt, never diffed wrongly.
+    if os.path.exists(state_path):
+        os.remove(state_path)
+    index_path = os.path.join(state_dir, INDEX_STATE_INDEX_FILENAME)
+    index.save(index_path)
+    write_usearch_config(index_path, usearch_build_config(dtype, dimension, params))
+    temp_path = f"{state_path}.tmp"
+    with open(temp_path, 'wb') as f:
+        np.savez(f, keys=keys, hashes=hashes, churn=churn, built_size=built_size)
+    os.replace(temp_path, state_path)
+    return index, stats
+
+
+def usearch_build_config(dtype: str, dimension: int, params: Dict[str, int]) -> Dict:
+    """The usearch_index.json the loader reads back for an index keyed by chunk."""
+    return {
+        'metric': USEARCH_METRIC,
+        'dtype': dtype,
+        'ndim': dimension,
+        'keys': USEARCH_CHUNK_KEYS,
+        **{name: int(params[name]) for name in USEARCH_HNSW_PARAMS},
+    }
+
+
 def main():
     print("Starting the USearch datastore creation process")
 
-    # Load local YAML files
-    yaml_contents = load_local_yaml_files()
+    # Load the intrinsic YAML files and the generated chunk store
+    yaml_contents = load_chunks()
 
     # Extract content, uuid, url, and original text from YAML files
     print("Extracting content and metadata from YAML files")
@@ -157,22 +376,40 @@ def main():
             'search_text': search_text,
         })
 
-    # Create embeddings
-    embeddings = create_embeddings(contents)
+    # Stable index keys: a rebuild gives an unchanged chunk the same key
+    keys = chunk_keys(item['chunk_uuid'] for item in metadata)
+    unique_keys, key_counts = np.unique(keys, return_counts=True)
+    if (key_counts > 1).any():
+        shared = set(unique_keys[key_counts > 1].tolist())
+        duplicates = [item['chunk_uuid'] for item, key in zip(metadata, keys.tolist()) if key in shared]
+        raise ValueError(f"Chunks share an index key: {duplicates[:10]}")
 
-    print("Saving embeddings to file")
-    timestamp = datetime.datetime.now().strftime("%Y%m%d_%H%M%S")
-    filename = f"embeddings_{timestamp}.txt"
-    np.savetxt(filename, embeddings)
+    # Create embeddings, encoding only chunks whose content is not in the cache
+    cache = EmbeddingCache(os.getenv('EMBEDDING_CACHE_DIR', 'embedding_cache'), EMBEDDING_MODEL)
+    print(f"Loaded {cache.load()} cached embeddings from {cache.directory}")
+    hashes = content_hashes(contents)
+    embeddings = cache.embed(contents, lambda texts: create_embeddings(texts, EMBEDDING_MODEL), hashes=hashes)
+    print(f"Encoded {cache.encoded} chunks; reused cached embeddings for the rest")
+    cache.save()
 
-    # Create USearch index
-    print("Creating USearch index")
-    index, metadata = create_usearch_index(embeddings, metadata)
+    # Update the keyed USearch index kept with the cache
+    usearch_dtype = os.getenv('USEARCH_DTYPE', USEARCH_DEFAULT_DTYPE)
+    rebuild = os.getenv('REBUILD_USEARCH_INDEX', '').lower() in {'1', 'true', 'yes'}
+    params = usearch_build_params()
+    print(f"USearch parameters: {params}")
+    index, stats = update_usearch_index(
+        cache.directory, keys, hashes, embeddings, dtype=usearch_dtype, rebuild=rebuild, params=params
+    )
+    print(
+        f"USearch index {'rebuilt' if stats['rebuilt'] else 'updated'}: {stats['added']} added, "
+        f"{stats['updated']} updated, {stats['removed']} removed, {stats['unchanged']} unchanged"
+    )
 
-    # Save the USearch index
+    # Save the USearch index and the build config the loader reads back
     index_filename = os.getenv('USEARCH_INDEX_FILENAME', 'usearch_index.bin')
     print(f"Saving USearch index to {index_filename}")
     index.save(index_filename)
+    write_usearch_config(index_filename, usearch_build_config(usearch_dtype, int(embeddings.shape[1]), params))
 
     # Save metadata
     metadata_filename = os.getenv('METADATA_FILENAME', 'metadata.json')
@@ -180,10 +417,18 @@ def main():
     with open(metadata_filename, 'w') as f:
         json.dump(metadata, f, indent=2)
 
+    # Save the memory-mappable metadata and BM25 index the MCP server loads at startup
+    artifacts_dir = os.getenv('SEARCH_ARTIFACTS_DIR', 'search_artifacts')
+    print(f"Saving search artifacts to {artifacts_dir}")
+    manifest = write_search_artifacts(metadata, build_bm25_index(metadata), artifacts_dir)
+    if manifest["bm25"]:
+        print(f"BM25 index: {manifest['bm25']['vocabulary_size']} terms, {manifest['bm25']['posting_count']} postings")
+
     print("USearch index and metadata have been created and saved.")
     print(f"Total documents processed: {len(contents)}")
     print(f"USearch index saved to: {os.path.abspath(index_filename)}")
     print(f"Metadata saved to: {os.path.abspath(metadata_filename)}")
+    print(f"Search artifacts saved to: {os.path.abspath(artifacts_dir)}")
 
 if __name__ == "__main__":
     main()
@@ -24,10 +24,12 @@ import sys
 
 import pytest
 
-# Add parent directory to path for imports
+# Add parent directory to path for imports, and the repository root for arm_kb_search
 _PARENT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
-if _PARENT_DIR not in sys.path:
-    sys.path.insert(0, _PARENT_DIR)
+_REPO_ROOT = os.path.dirname(_PARENT_DIR)
+for _path in (_REPO_ROOT, _PARENT_DIR):
+    if _path not in sys.path:
+        sys.path.insert(0, _path)
 
 
 def _load_generate_chunks():
@@ -0,0 +1,87 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""SparseBM25Index scores against rank_bm25.BM25Okapi, the implementation it replaced."""
+
+import numpy as np
+import pytest
+
+from arm_kb_search import SparseBM25Index
+
+rank_bm25 = pytest.importorskip("rank_bm25")
+
+# "arm" is in four of six documents, so its raw idf is negative and gets the epsilon floor;
+# one document is empty and several repeat a term.
+CORPUS = [
+    ["arm", "neon", "neon", "neon", "intrinsics"],
+    ["arm", "sve", "sve2", "vector", "length"],
+    [],
+    ["arm", "graviton", "docker", "image", "arm"],
+    ["x86", "avx", "intrinsics"],
+    ["arm", "neoverse", "n1", "neon"],
+]
+QUERIES = [
+    ["neon"],
+    ["arm"],
+    ["arm", "neon"],
+    ["neon", "neon", "intrinsics"],
+    ["sve", "unknown"],
+    ["unknown"],
+    [],
+]
+
+
+def _assert_scores_match(corpus, queries):
+    reference = rank_bm25.BM25Okapi(corpus)
+    index = SparseBM25Index.from_corpus(corpus)
+    for query in queries:
+        np.testing.assert_allclose(
+            index.get_scores(query), reference.get_scores(query), rtol=1e-12, atol=0, err_msg=str(query)
+        )
+
+
+class TestSparseBM25Parity:
+    def test_scores_match_bm25okapi(self):
+        _assert_scores_match(CORPUS, QUERIES)
+
+    def test_negative_idf_uses_the_epsilon_floor(self):
+        reference = rank_bm25.BM25Okapi(CORPUS)
+        index = SparseBM25Index.from_corpus(CORPUS)
+
+        assert reference.idf["arm"] == pytest.approx(0.25 * reference.average_idf)
+        assert index.idf[index.vocabulary["arm"]] == pytest.approx(reference.idf["arm"], rel=1e-12)
+
+    def test_scores_match_when_every_term_is_common(self):
+        corpus = [["arm", "neon"], ["arm", "neon", "neon"], ["arm"], []]
+        _assert_scores_match(corpus, [["arm"], ["neon"], ["arm", "neon", "arm"]])
+
+    def test_top_k_agrees_with_dense_scores(self):
+        index = SparseBM25Index.from_corpus(CORPUS)
+        reference = rank_bm25.BM25Okapi(CORPUS)
+        for query in QUERIES:
+            doc_ids, scores = index.top_k(query, k=3)
+            expected = reference.get_scores(query)
+            ranked = sorted(range(len(CORPUS)), key=lambda doc: (-expected[doc], doc))
+            positive = [doc for doc in ranked if expected[doc] > 0]
+
+            assert doc_ids.tolist() == positive[:3]
+            np.testing.assert_allclose(scores, expected[doc_ids], rtol=1e-12, atol=0)
+
+    def test_top_k_many_matches_top_k(self):
+        index = SparseBM25Index.from_corpus(CORPUS)
+        for query, (doc_ids, scores) in zip(QUERIES, index.top_k_many(QUERIES, k=4)):
+            expected_docs, expected_scores = index.top_k(query, k=4)
+
+            assert doc_ids.tolist() == expected_docs.tolist()
+            np.testing.assert_array_equal(scores, expected_scores)
@@ -0,0 +1,83 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for the content-hash keyed embedding cache."""
+
+import numpy as np
+
+from embedding_cache import EMBEDDINGS_FILENAME, EmbeddingCache
+
+
+class RecordingEncoder:
+    """Encodes each text as [len(text), index of its first letter], recording every call."""
+
+    def __init__(self):
+        self.calls = []
+
+    def __call__(self, texts):
+        self.calls.append(list(texts))
+        return np.array([[len(text), ord(text[0]) - ord("a")] for text in texts], dtype=np.float32)
+
+
+class TestEmbeddingCache:
+    def test_embed_encodes_each_content_once(self, tmp_path):
+        encoder = RecordingEncoder()
+        cache = EmbeddingCache(str(tmp_path), "org/model")
+
+        vectors = cache.embed(["abc", "de", "abc"], encoder)
+
+        assert len(encoder.calls) == 1
+        assert sorted(encoder.calls[0]) == ["abc", "de"]
+        assert cache.encoded == 2
+        np.testing.assert_array_equal(vectors, [[3, 0], [2, 3], [3, 0]])
+
+    def test_reload_only_encodes_new_contents(self, tmp_path):
+        first = EmbeddingCache(str(tmp_path), "org/model")
+        first.embed(["abc", "de"], RecordingEncoder())
+        first.save()
+        assert (tmp_path / "org__model" / EMBEDDINGS_FILENAME).exists()
+
+        encoder = RecordingEncoder()
+        second = EmbeddingCache(str(tmp_path), "org/model")
+        assert second.load() == 2
+        vectors = second.embed(["de", "fghi"], encoder)
+
+        assert encoder.calls == [["fghi"]]
+        np.testing.assert_array_equal(vectors, [[2, 3], [4, 5]])
+
+    def test_save_prunes_contents_not_in_the_last_embed(self, tmp_path):
+        cache = EmbeddingCache(str(tmp_path), "model")
+        cache.embed(["abc", "de"], RecordingEncoder())
+        cache.save()
+        cache.embed(["de"], RecordingEncoder())
+        cache.save()
+
+        reloaded = EmbeddingCache(str(tmp_path), "model")
+        assert reloaded.load() == 1
+        encoder = RecordingEncoder()
+        reloaded.embed(["abc"], encoder)
+        assert encoder.calls == [["abc"]]
+
+    def test_nothing_changed_does_not_encode(self, tmp_path):
+        cache = EmbeddingCache(str(tmp_path), "model")
+        cache.embed(["abc"], RecordingEncoder())
+        cache.save()
+
+        def fail(texts):
+            raise AssertionError("encode should not be called")
+
+        reloaded = EmbeddingCache(str(tmp_path), "model")
+        reloaded.load()
+        np.testing.assert_array_equal(reloaded.embed(["abc"], fail), [[3, 0]])
+        assert reloaded.encoded == 0
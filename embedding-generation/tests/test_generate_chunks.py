@@ -1277,3 +1277,222 @@ class TestCreateRetrySession:
         )
         
         assert session is not None
+
+
+class TestHostRateLimiter:
+    """Tests for the per-host request spacing shared by fetch workers."""
+
+    def test_same_host_requests_are_spaced(self, gc, monkeypatch):
+        sleeps = []
+        monkeypatch.setattr(gc.time, "sleep", sleeps.append)
+        monkeypatch.setattr(gc.time, "monotonic", lambda: 100.0)
+        limiter = gc.HostRateLimiter(rate=4)
+
+        limiter.wait("https://learn.arm.com/a")
+        limiter.wait("https://learn.arm.com/b")
+        limiter.wait("https://learn.arm.com/c")
+
+        assert sleeps == [0.25, 0.5]
+
+    def test_other_hosts_are_not_delayed(self, gc, monkeypatch):
+        sleeps = []
+        monkeypatch.setattr(gc.time, "sleep", sleeps.append)
+        monkeypatch.setattr(gc.time, "monotonic", lambda: 100.0)
+        limiter = gc.HostRateLimiter(rate=4)
+
+        limiter.wait("https://learn.arm.com/a")
+        limiter.wait("https://developer.arm.com/a")
+
+        assert sleeps == []
+
+    def test_zero_rate_disables_limit(self, gc, monkeypatch):
+        sleeps = []
+        monkeypatch.setattr(gc.time, "sleep", sleeps.append)
+        limiter = gc.HostRateLimiter(rate=0)
+
+        for _ in range(3):
+            limiter.wait("https://learn.arm.com/a")
+
+        assert sleeps == []
+
+
+class TestCheckpoint:
+    """Tests for the resumable chunking checkpoint."""
+
+    def test_roundtrip(self, gc, tmp_path):
+        path = str(tmp_path / "checkpoint.jsonl")
+        gc.start_checkpoint(path, "run-1")
+        gc.record_checkpoint(path, 0, "https://example.com/a", 3)
+        gc.record_checkpoint(path, 2, "https://example.com/c", 0)
+
+        assert gc.load_checkpoint(path, "run-1") == {0: 3, 2: 0}
+
+    def test_other_run_is_not_resumed(self, gc, tmp_path):
+        path = str(tmp_path / "checkpoint.jsonl")
+        gc.start_checkpoint(path, "run-1")
+        gc.record_checkpoint(path, 0, "https://example.com/a", 3)
+
+        assert gc.load_checkpoint(path, "run-2") is None
+        assert gc.load_checkpoint(str(tmp_path / "missing.jsonl"), "run-1") is None
+
+    def test_truncated_last_line_is_ignored(self, gc, tmp_path):
+        path = tmp_path / "checkpoint.jsonl"
+        gc.start_checkpoint(str(path), "run-1")
+        gc.record_checkpoint(str(path), 0, "https://example.com/a", 3)
+        with open(path, "a", encoding="utf-8") as file:
+            file.write('{"row": 1, "url": "https://exa')
+
+        assert gc.load_checkpoint(str(path), "run-1") == {0: 3}
+
+    def test_run_id_changes_with_sources_and_chunk_run_id(self, gc, tmp_path, monkeypatch):
+        sources = tmp_path / "sources.csv"
+        sources.write_text("Site Name,License Type,Display Name,URL,Keywords\n", encoding="utf-8")
+        monkeypatch.delenv("CHUNK_RUN_ID", raising=False)
+        first = gc.checkpoint_run_id(str(sources))
+
+        monkeypatch.setenv("CHUNK_RUN_ID", "1234")
+        assert gc.checkpoint_run_id(str(sources)) != first
+
+        monkeypatch.delenv("CHUNK_RUN_ID")
+        sources.write_text("Site Name,License Type,Display Name,URL,Keywords\nA,B,C,https://x,k\n", encoding="utf-8")
+        assert gc.checkpoint_run_id(str(sources)) != first
+
+
+class TestChunkStore:
+    """Tests for the append-only JSON Lines chunk store."""
+
+    def _chunk(self, gc, url, text):
+        return gc.createChunk(text, url, ["arm"], "Title")
+
+    def test_flush_appends_records_and_tracks_sources(self, gc, tmp_path):
+        store = gc.ChunkStore(str(tmp_path / "chunks" / "chunks.jsonl"))
+        store.reset()
+        first = self._chunk(gc, "https://example.com/a#intro", "one two three")
+        second = self._chunk(gc, "https://example.com/a#usage", "four five")
+        store.add("https://example.com/a", first)
+        store.add("https://example.com/a", second)
+
+        assert (tmp_path / "chunks" / "chunks.jsonl").read_text() == ""
+        store.flush()
+
+        lines = (tmp_path / "chunks" / "chunks.jsonl").read_text().splitlines()
+        records = [json.loads(line) for line in lines]
+        assert [record["uuid"] for record in records] == [first.uuid, second.uuid]
+        assert records[0]["source_url"] == "https://example.com/a"
+        assert records[0]["url"] == "https://example.com/a#intro"
+        assert records[0]["content"] == "one two three"
+        assert store.sources["https://example.com/a"]["words"] == 5
+
+    def test_write_details(self, gc, tmp_path):
+        store = gc.ChunkStore(str(tmp_path / "chunks.jsonl"))
+        store.reset()
+        chunk = self._chunk(gc, "https://example.com/a", "one two three")
+        store.add("https://example.com/a", chunk)
+        store.flush()
+
+        store.write_details(str(tmp_path / "info" / "chunk_details.csv"))
+
+        with open(tmp_path / "info" / "chunk_details.csv", newline="") as file:
+            rows = list(csv.reader(file))
+        assert rows[0] == ["URL", "Date", "Number of Words", "Number of Chunks", "Chunk IDs"]
+        assert rows[1][0] == "https://example.com/a"
+        assert rows[1][2:] == ["3", "1", f"chunk_{chunk.uuid}"]
+
+    def test_load_drops_unfinished_sources_and_truncated_line(self, gc, tmp_path):
+        path = tmp_path / "chunks.jsonl"
+        store = gc.ChunkStore(str(path))
+        store.reset()
+        for url in ("https://example.com/a", "https://example.com/a", "https://example.com/b"):
+            store.add(url, self._chunk(gc, url, "some words here"))
+        store.flush()
+        with open(path, "a", encoding="utf-8") as file:
+            file.write('{"uuid": "partial", "source_url": "https://exa')
+
+        reopened = gc.ChunkStore(str(path))
+        assert reopened.load({"https://example.com/a"}) == 1
+
+        records = [json.loads(line) for line in path.read_text().splitlines()]
+        assert {record["source_url"] for record in records} == {"https://example.com/a"}
+        assert len(records) == 2
+        assert len(reopened.sources["https://example.com/a"]["chunk_ids"]) == 2
+
+    def test_add_assigns_stable_uuids(self, gc, tmp_path):
+        def uuids():
+            store = gc.ChunkStore(str(tmp_path / "chunks.jsonl"))
+            store.reset()
+            chunks = [
+                self._chunk(gc, "https://example.com/a#intro", "one"),
+                self._chunk(gc, "https://example.com/a#intro", "two"),
+                self._chunk(gc, "https://example.com/a#usage", "three"),
+            ]
+            for chunk in chunks:
+                store.add("https://example.com/a", chunk)
+            return [chunk.uuid for chunk in chunks]
+
+        first_run = uuids()
+        assert uuids() == first_run
+        assert len(set(first_run)) == 3
+
+    def test_chunk_save_and_track_buffers_until_flush(self, gc, tmp_path, monkeypatch):
+        store = gc.ChunkStore(str(tmp_path / "chunks.jsonl"))
+        store.reset()
+        monkeypatch.setattr(gc, "chunk_store", store)
+
+        gc.chunkSaveAndTrack("https://example.com/a", self._chunk(gc, "https://example.com/a", "text"))
+
+        assert store.pending
+        assert (tmp_path / "chunks.jsonl").read_text() == ""
+
+
+class TestChunkSourcesConcurrently:
+    """Tests for the concurrent fetch and chunk stage of main()."""
+
+    def _csv_dict(self, urls):
+        return {
+            "urls": urls,
+            "focus": ["arm"] * len(urls),
+            "source_names": [f"Source {i}" for i in range(len(urls))],
+            "site_names": ["Documentation"] * len(urls),
+            "license_types": [""] * len(urls),
+            "transcript_urls": [""] * len(urls),
+        }
+
+    def test_reports_each_source_once_and_skips_failures(self, gc, monkeypatch, tmp_path):
+        monkeypatch.chdir(tmp_path)
+        (tmp_path / "info").mkdir()
+        monkeypatch.setattr(gc, "PARSE_WORKERS", 0)
+        urls = [f"https://example.com/{i}" for i in range(6)]
+
+        def fake_create_chunks(source_url, source_name, doc_type, keywords_value, transcript_url=""):
+            if source_url.endswith("/3"):
+                raise ValueError("bad payload")
+            return [source_url]
+
+        monkeypatch.setattr(gc, "create_chunks_for_source", fake_create_chunks)
+        done = []
+
+        failed = gc.chunk_sources_concurrently(
+            self._csv_dict(urls), [0, 1, 2, 3, 5], lambda row, url, chunks: done.append((row, url, chunks))
+        )
+
+        assert failed == [3]
+        assert sorted(done) == [(i, urls[i], [urls[i]]) for i in (0, 1, 2, 5)]
+        assert gc.parse_pool is None
+        assert "bad payload" in (tmp_path / "info" / "errors.csv").read_text()
+
+    def test_parse_and_chunk_without_pool_runs_inline(self, gc, monkeypatch):
+        monkeypatch.setattr(gc, "parse_pool", None)
+        parsed_document, payloads = gc.parse_and_chunk(
+            response_content=("Arm Neoverse cores run cloud workloads efficiently. " * 40).encode("utf-8"),
+            source_url="https://example.com/doc",
+            resolved_url="https://example.com/doc.md",
+            fallback_title="Neoverse",
+            doc_type="Documentation",
+            keywords=["neoverse"],
+            content_type="text/markdown",
+            display_url="https://example.com/primary",
+        )
+
+        assert parsed_document.source_url == "https://example.com/primary"
+        assert payloads
+        assert all(payload["url"].startswith("https://example.com/primary") for payload in payloads)
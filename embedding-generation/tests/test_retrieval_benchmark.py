@@ -0,0 +1,158 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Retrieval benchmark harness and its latency gate, over a synthetic corpus.
+
+The corpus and encoder are synthetic so the gate runs without the embedding model or a
+built index; the budgets in retrieval_benchmark_budget.json are generous absolute limits
+that catch order-of-magnitude regressions in the search pipeline, not small drifts.
+"""
+
+import copy
+import hashlib
+import json
+import random
+from pathlib import Path
+
+import numpy as np
+import pytest
+from usearch.index import Index
+
+from arm_kb_search import (
+    SEARCH_STAGES,
+    SearchResources,
+    StageTimer,
+    build_bm25_index,
+    build_field_token_index,
+    search,
+)
+from arm_kb_search.benchmark import exceeded_budgets, find_regressions, run_benchmark
+from arm_kb_search.config import USEARCH_METRIC
+
+BUDGET_PATH = Path(__file__).parent / "retrieval_benchmark_budget.json"
+DIMENSION = 64
+DOCUMENTS = 2000
+WORDS = [f"{prefix}{suffix}" for prefix in ("neon", "sve", "gcc", "kernel", "docker", "cache", "llvm", "graviton") for suffix in range(40)]
+
+
+class HashingEncoder:
+    """Bag-of-words embedding: each token adds a hashed unit vector; rows are normalized."""
+
+    def encode(self, sentences, **kwargs):
+        vectors = np.zeros((len(sentences), DIMENSION), dtype=np.float32)
+        for row, sentence in enumerate(sentences):
+            for token in sentence.lower().split():
+                digest = hashlib.blake2b(token.encode("utf-8"), digest_size=8).digest()
+                vectors[row, int.from_bytes(digest, "little") % DIMENSION] += 1.0
+        norms = np.linalg.norm(vectors, axis=1, keepdims=True)
+        return vectors / np.maximum(norms, 1e-6)
+
+
+def _synthetic_metadata():
+    rng = random.Random(7)
+    metadata = []
+    for position in range(DOCUMENTS):
+        title = " ".join(rng.sample(WORDS, 3))
+        heading = " ".join(rng.sample(WORDS, 2))
+        text = " ".join(rng.choice(WORDS) for _ in range(60))
+        metadata.append({
+            "uuid": f"uuid-{position}",
+            "url": f"https://example.com/docs/{position // 4}",
+            "resolved_url": f"https://example.com/docs/{position // 4}",
+            "original_text": text,
+            "title": title,
+            "keywords": " ".join(rng.sample(WORDS, 2)),
+            "chunk_uuid": f"chunk-{position}",
+            "heading": heading,
+            "heading_path": [title, heading],
+            "doc_type": "guide",
+            "search_text": f"{title} {heading} {text}",
+        })
+    return metadata
+
+
+@pytest.fixture(scope="module")
+def load_resources():
+    metadata = _synthetic_metadata()
+    encoder = HashingEncoder()
+
+    def load():
+        index = Index(ndim=DIMENSION, metric=USEARCH_METRIC, dtype="f32")
+        index.add(np.arange(len(metadata), dtype=np.uint64), encoder.encode([item["search_text"] for item in metadata]))
+        return SearchResources(
+            metadata=metadata,
+            embedding_model=encoder,
+            usearch_index=index,
+            bm25_index=build_bm25_index(metadata),
+            field_tokens=build_field_token_index(metadata),
+            include_disclaimers=False,
+        )
+
+    return load
+
+
+@pytest.fixture(scope="module")
+def report(load_resources):
+    eval_rows = [{"question": f"How do I use {word} with {other}?"} for word, other in zip(WORDS[::7], WORDS[3::7])]
+    return run_benchmark(load_resources, eval_rows, query_count=120, concurrency_levels=(1, 2))
+
+
+class TestRetrievalBenchmark:
+    def test_report_times_every_search_stage(self, report):
+        for phase in ("cold", "warm"):
+            assert report[phase]["queries"] == 120
+            assert set(report[phase]["stages"]) == set(SEARCH_STAGES) - {"cache"}
+        assert [entry["concurrency"] for entry in report["throughput"]] == [1, 2]
+        assert all(entry["qps"] > 0 for entry in report["throughput"])
+        assert report["query_mix"]["miss"] > 0
+        json.dumps(report)
+
+    def test_timer_does_not_change_results(self, load_resources):
+        resources = load_resources()
+        query = f"{WORDS[0]} {WORDS[50]} {WORDS[100]}"
+        timer = StageTimer()
+
+        assert search(query, resources, timer=timer) == search(query, resources)
+        assert sum(timer.stages_ms.values()) > 0
+
+    def test_within_budget(self, report):
+        """The gate the unit test workflow runs; loosen a budget only with a reason."""
+        with BUDGET_PATH.open() as file:
+            budgets = json.load(file)
+        assert exceeded_budgets(report, budgets) == []
+
+
+class TestFindRegressions:
+    def test_same_report_passes(self, report):
+        assert find_regressions(report, report) == []
+
+    def test_slower_latency_and_lower_qps_fail(self, report):
+        slower = copy.deepcopy(report)
+        slower["warm"]["total"]["p95_ms"] = report["warm"]["total"]["p95_ms"] * 2 + 10
+        slower["throughput"][0]["qps"] = report["throughput"][0]["qps"] / 2
+
+        regressions = find_regressions(slower, report, max_regression=0.25)
+
+        assert any(line.startswith("warm.total.p95_ms") for line in regressions)
+        assert any(line.startswith("qps@1") for line in regressions)
+
+    def test_changes_within_slack_pass(self, report):
+        jittered = copy.deepcopy(report)
+        for summary in jittered["warm"]["stages"].values():
+            summary["p99_ms"] = min(summary["p99_ms"] * 3, summary["p99_ms"] + 0.5)
+
+        assert not any(line.startswith("warm.") for line in find_regressions(jittered, report, min_slack_ms=1.0))
+
+    def test_missing_budgeted_metric_fails(self, report):
+        assert exceeded_budgets(report, {"warm.unknown.p95_ms": 1}) == ["warm.unknown.p95_ms: not measured"]
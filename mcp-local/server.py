@@ -12,36 +12,113 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from fastmcp import FastMCP
+from fastmcp import Context, FastMCP
+import asyncio
+import atexit
+from concurrent.futures import ThreadPoolExecutor
+import functools
 import os
-from typing import List, Dict, Any, Optional
+import signal
+import time
+from typing import List, Dict, Any, Optional, Union
 import arm_kb_search
-from utils.config import METADATA_PATH, USEARCH_INDEX_PATH, MODEL_NAME, SUPPORTED_SCANNERS, DEFAULT_ARCH
-from utils.docker_utils import check_docker_image_architectures
+from utils.config import (
+    METADATA_PATH,
+    USEARCH_INDEX_PATH,
+    SEARCH_ARTIFACTS_DIR,
+    USEARCH_INDEX_VIEW,
+    SEARCH_CACHE_SIZE,
+    SEARCH_CACHE_PATH,
+    MODEL_NAME,
+    SEARCH_WORKERS,
+    EMBEDDING_BACKEND,
+    ONNX_MODEL_DIR,
+    SUPPORTED_SCANNERS,
+    DEFAULT_ARCH,
+    TOOL_METRICS_PATH,
+)
+from utils.cli_utils import OutputCallback
+from utils.docker_utils import check_docker_image_architectures, check_images_architectures
 from utils.apx import (
     prepare_target,
     run_workload,
     get_results,
     resolve_apx_ssh_mount_env,
+    resolve_recipes,
     build_apx_ssh_mount_help,
+    decode_results_cursor,
+    list_recipe_queries,
+    APX_RESULTS_PAGE_SIZE,
 )
-from utils.migrate_ease_utils import run_migrate_ease_scan
-from utils.skopeo_tool import skopeo_help, skopeo_inspect
-from utils.llvm_mca_tool import mca_help, llvm_mca_analyze
+from utils.apx_session import TargetSessionCache
+from utils.apx_compare import compare_runs
+from utils.migrate_ease_utils import resolve_scanners, run_migrate_ease_scan
+from utils.skopeo_tool import skopeo_help, skopeo_inspect, skopeo_inspect_images
+from utils.llvm_mca_tool import mca_help, llvm_mca_analyze, llvm_mca_sweep
+from utils.mca_compile import compile_and_analyze, hotspot_functions
 from utils.invocation_logger import log_invocation_reason
 from utils.error_handling import format_tool_error
+from utils.background_writer import LOG_WRITER
+from utils.jobs import FINISHED_STATES, JobManager
+from utils.tool_metrics import ToolMetrics, record_stages
 
 # Initialize the MCP server
 mcp = FastMCP("arm-mcp")
+# Every tool registered below is timed: wall time, subprocess time, RSS and response size (see server_stats).
+TOOL_METRICS = ToolMetrics(log_path=TOOL_METRICS_PATH)
+mcp.tool = TOOL_METRICS.instrument(mcp.tool)
 
 
 # Load USearch index and metadata at module load time
 SEARCH_RESOURCES = arm_kb_search.load_search_resources(
     metadata_path=METADATA_PATH,
     usearch_index_path=USEARCH_INDEX_PATH,
-    model_name=MODEL_NAME,
+    model_name=ONNX_MODEL_DIR if EMBEDDING_BACKEND != "torch" and os.path.isdir(ONNX_MODEL_DIR) else MODEL_NAME,
+    embedding_backend=EMBEDDING_BACKEND,
     utm_source="arm-mcp",
+    search_artifacts_dir=SEARCH_ARTIFACTS_DIR,
+    usearch_view=USEARCH_INDEX_VIEW,
+    query_cache_size=SEARCH_CACHE_SIZE,
+    query_cache_path=SEARCH_CACHE_PATH,
 )
+if SEARCH_RESOURCES.cache is not None and SEARCH_CACHE_PATH:
+    # The stdio transport exits normally when the client disconnects, so atexit covers warm restarts.
+    atexit.register(SEARCH_RESOURCES.cache.save)
+
+# Knowledge base search is CPU-bound; a bounded pool keeps it off the event loop so long-running
+# scans and APX runs never delay it, and caps how many searches compete for cores.
+SEARCH_EXECUTOR = ThreadPoolExecutor(max_workers=SEARCH_WORKERS, thread_name_prefix="kb-search")
+
+
+async def _run_search(func, *args):
+    return await asyncio.get_running_loop().run_in_executor(SEARCH_EXECUTOR, func, *args)
+
+
+JOBS = JobManager()
+# Upper bound for one job_status long-poll, so a waiting call stays inside typical client timeouts.
+JOB_STATUS_MAX_WAIT_SECONDS = 120
+
+# Prepared APX targets keyed by (host, user, SSH key fingerprint), shared by apx_recipe_run and its job.
+APX_SESSIONS = TargetSessionCache()
+PROGRESS_MESSAGE_MAX_CHARS = 500
+
+
+def _progress_reporter(ctx: Optional[Context]) -> Optional[OutputCallback]:
+    """Forward subprocess output lines as MCP progress notifications on the current request."""
+    if ctx is None:
+        return None
+    lines = 0
+
+    async def report(stream: str, line: str) -> None:
+        nonlocal lines
+        lines += 1
+        try:
+            await ctx.report_progress(progress=lines, message=line[:PROGRESS_MESSAGE_MAX_CHARS])
+        except Exception:
+            # Progress is best effort; never fail the tool because a notification could not be sent.
+            pass
+
+    return report
 
 
 # error formatter now lives in utils/error_handling.py
@@ -50,7 +127,7 @@ SEARCH_RESOURCES = arm_kb_search.load_search_resources(
 @mcp.tool(
     description="If a user asks to migrate a codebase to Arm, strongly consider using this tool as a part of your strategy. Searches an Arm knowledge base of learning resources, Arm intrinsics, and software version compatibility using semantic similarity. Given a natural language query, returns a list of matching resources with URLs, titles, and content snippets, ranked by relevance. Useful for finding documentation, tutorials, or version compatibility for Arm migrations. Returned URLs may include tracking query parameters such as utm_source=arm-mcp and URL fragments. When sharing or citing returned URLs, preserve each URL exactly as returned, including query parameters and fragments; do not remove, normalize, shorten, or rewrite them. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context."
 )
-def knowledge_base_search(query: str, invocation_reason: Optional[str] = None) -> List[Dict[str, Any]]:
+async def knowledge_base_search(query: str, invocation_reason: Optional[str] = None) -> List[Dict[str, Any]]:
     # Log invocation reason if provided
     log_invocation_reason(
         tool="knowledge_base_search",
@@ -67,7 +144,10 @@ def knowledge_base_search(query: str, invocation_reason: Optional[str] = None) -
         List of dictionaries with metadata including url and text snippets.
     """
     try:
-        return arm_kb_search.search(query, SEARCH_RESOURCES)
+        timer = arm_kb_search.StageTimer()
+        results = await _run_search(functools.partial(arm_kb_search.search, timer=timer), query, SEARCH_RESOURCES)
+        record_stages(timer.stages_ms)
+        return results
     except Exception as e:
         return format_tool_error(
             tool="knowledge_base_search",
@@ -76,10 +156,42 @@ def knowledge_base_search(query: str, invocation_reason: Optional[str] = None) -
         )
 
 
+@mcp.tool(
+    description="Batched form of knowledge_base_search. Use this instead of several back-to-back knowledge_base_search calls, for example when checking the Arm compatibility of each package in a Dockerfile or requirements.txt, or looking up Arm equivalents for a list of intrinsics. Accepts up to 32 natural language queries and returns one entry per query, in the same order, with the query and its matching resources (URLs, titles, and content snippets ranked by relevance). Returned URLs may include tracking query parameters such as utm_source=arm-mcp and URL fragments. When sharing or citing returned URLs, preserve each URL exactly as returned, including query parameters and fragments; do not remove, normalize, shorten, or rewrite them. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context."
+)
+async def knowledge_base_search_batch(queries: List[str], invocation_reason: Optional[str] = None) -> List[Dict[str, Any]]:
+    log_invocation_reason(
+        tool="knowledge_base_search_batch",
+        reason=invocation_reason,
+        args={"queries": queries},
+    )
+    """
+    Search the knowledge base for several queries with one batched embedding and index pass.
+
+    Args:
+        queries: The search strings
+
+    Returns:
+        List of {"query", "results"} dictionaries, one per query in input order.
+    """
+    try:
+        batch_results = await _run_search(arm_kb_search.search_many, queries, SEARCH_RESOURCES)
+        return [
+            {"query": query, "results": results}
+            for query, results in zip(queries, batch_results)
+        ]
+    except Exception as e:
+        return format_tool_error(
+            tool="knowledge_base_search_batch",
+            exc=e,
+            args={"queries": queries},
+        )
+
+
 @mcp.tool(
     description="Check Docker image architectures. Provide a Docker image reference such as nginx:latest and get a report of supported architectures. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context."
 )
-def check_image(image: str, invocation_reason: Optional[str] = None) -> dict:
+async def check_image(image: str, invocation_reason: Optional[str] = None) -> dict:
     log_invocation_reason(
         tool="check_image",
         reason=invocation_reason,
@@ -94,7 +206,7 @@ def check_image(image: str, invocation_reason: Optional[str] = None) -> dict:
         Dictionary with architecture information
     """
     try:
-        return check_docker_image_architectures(image)
+        return await check_docker_image_architectures(image)
     except Exception as e:
         return format_tool_error(
             tool="check_image",
@@ -103,10 +215,29 @@ def check_image(image: str, invocation_reason: Optional[str] = None) -> dict:
         )
 
 
+@mcp.tool(
+    description="Check the architectures of many container images at once, e.g. every image of a docker-compose file, Kubernetes manifest or Helm chart. Accepts Docker Hub names (nginx:latest) and other registries (ghcr.io/org/app:1.0, quay.io/org/app, public.ecr.aws/org/app), by tag or @sha256 digest. Images are checked concurrently with cached registry tokens and manifests. Returns per-image results, counts, and the images missing arm64. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context."
+)
+async def check_images(images: List[str], invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    log_invocation_reason(
+        tool="check_images",
+        reason=invocation_reason,
+        args={"images": images},
+    )
+    try:
+        return await check_images_architectures(images)
+    except Exception as e:
+        return format_tool_error(
+            tool="check_images",
+            exc=e,
+            args={"images": images},
+        )
+
+
 @mcp.tool(
     description="Provides instructions for installing and using sysreport, a tool that obtains system information related to system architecture, CPU, memory, and other hardware details. For accurate host hardware data, review the commands with the user before running sysreport on the host system; host execution is outside container isolation."
 )
-def sysreport_instructions(invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+async def sysreport_instructions(invocation_reason: Optional[str] = None) -> Dict[str, Any]:
     log_invocation_reason(
         tool="sysreport_instructions",
         reason=invocation_reason,
@@ -153,18 +284,20 @@ Run these commands directly on your host system (not in a container) to get accu
     description=(
         "If a user asks to migrate a codebase to Arm, strongly consider using this tool as a part of your overall strategy. "
         "Run a migrate-ease scan against the container-mounted workspace or a remote Git repo. "
-        "Supported scanners: cpp, python, go, js, java. "
+        "Supported scanners: cpp, python, go, js, java. Pass scanner='all' or a list of scanners to scan a polyglot codebase in one call; the scanners then run concurrently over one workspace view and return a merged report with per-scanner results and timings. "
         "Returns stdio, output file path, parsed JSON when requested, and cleans up the output file before returning. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context."
-        " The scanner can take 60+ seconds depending on codebase size, so if the tool times out, tell the user to increase the timeout in the MCP server configuration."
+        " The scanner can take 60+ seconds depending on codebase size. For large codebases prefer start_migrate_ease_scan, which runs the same scan as a background job that survives client timeouts; otherwise, if the tool times out, tell the user to increase the timeout in the MCP server configuration."
     )
 )
-def migrate_ease_scan(
-    scanner: str,
+async def migrate_ease_scan(
+    scanner: Union[str, List[str]],
     arch: str = DEFAULT_ARCH,
     git_repo: Optional[str] = None,
     output_format: str = "json",
     extra_args: Optional[List[str]] = None,
+    git_ref: Optional[str] = None,
     invocation_reason: Optional[str] = None,
+    ctx: Context = None,
 ) -> Dict[str, Any]:
     log_invocation_reason(
         tool="migrate_ease_scan",
@@ -175,37 +308,57 @@ def migrate_ease_scan(
             "git_repo": git_repo,
             "output_format": output_format,
             "extra_args": extra_args,
+            "git_ref": git_ref,
         },
     )
     """
     Args:
-        scanner: One of cpp, python, go, js, java (case-insensitive).
+        scanner: One of cpp, python, go, js, java (case-insensitive), "all", or a list of them.
         arch: Architecture for the scan (default: armv8-a).
         git_repo: Remote Git repo URL to scan. Local scans always target the mounted
-            workspace directory. When git_repo is set, the scan clones the
-            repository into a temporary directory that is cleaned up automatically.
+            workspace directory. When git_repo is set, the scan checks the repository out
+            from a cached shallow clone into a temporary directory that is cleaned up automatically.
         output_format: One of json, txt, csv, html. Defaults to json.
         extra_args: Optional list of additional flags passed through to the scanner.
+        git_ref: Branch, tag, or commit of git_repo to scan (default: the remote's default branch).
 
     Returns:
         A dictionary with status, returncode, command, stdio, output file path (for traceability),
         parsed_results (for JSON), a flag indicating if the output file was deleted, and a
         workspace directory listing when running a local scan, for troubleshooting purposes. Tell the user when the directory is empty,
-        as it indicates a misconfigured docker volume mount.
+        as it indicates a misconfigured docker volume mount. Local JSON scans reuse cached per-file findings
+        and only rescan changed files; scan_cache reports how many files were scanned and reused.
     """
+    return await _migrate_ease_scan(
+        scanner, arch, git_repo, output_format, extra_args, on_output=_progress_reporter(ctx), git_ref=git_ref
+    )
+
+
+async def _migrate_ease_scan(
+    scanner: Union[str, List[str]],
+    arch: str,
+    git_repo: Optional[str],
+    output_format: str,
+    extra_args: Optional[List[str]],
+    on_output: Optional[OutputCallback] = None,
+    git_ref: Optional[str] = None,
+) -> Dict[str, Any]:
     try:
-        if scanner.lower() not in SUPPORTED_SCANNERS:
+        scanners = resolve_scanners(scanner)
+        if not scanners or any(name not in SUPPORTED_SCANNERS for name in scanners):
             return {
                 "status": "error",
-                "message": f"Unsupported scanner '{scanner}'. Supported: {sorted(SUPPORTED_SCANNERS)}"
+                "message": f"Unsupported scanner '{scanner}'. Supported: {sorted(SUPPORTED_SCANNERS)} or 'all'"
             }
 
-        return run_migrate_ease_scan(
+        return await run_migrate_ease_scan(
             scanner=scanner,
             arch=arch,
             git_repo=git_repo,
             output_format=output_format,
             extra_args=extra_args,
+            on_output=on_output,
+            git_ref=git_ref,
         )
     except Exception as e:
         return format_tool_error(
@@ -217,11 +370,12 @@ def migrate_ease_scan(
                 "git_repo": git_repo,
                 "output_format": output_format,
                 "extra_args": extra_args,
+                "git_ref": git_ref,
             },
         )
 
 @mcp.tool()
-def apx_recipe_run(cmd:str, remote_ip_addr:str, remote_usr:str, recipe:str="code_hotspots", invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+async def apx_recipe_run(cmd:str, remote_ip_addr:str, remote_usr:str, recipe: Union[str, List[str]] = "code_hotspots", invocation_reason: Optional[str] = None, ctx: Context = None) -> Dict[str, Any]:
     """
     Run a sample workload on the given target using a Performix recipe, 
     and interpret the results. Some example user requests: 
@@ -244,10 +398,16 @@ def apx_recipe_run(cmd:str, remote_ip_addr:str, remote_usr:str, recipe:str="code
         cmd: absolute path to the executable or the command to run on the remote machine (with absolute paths)
         remote_ip_addr: IP address of the remote machine
         remote_usr: username for SSH access to the remote machine
-        recipe: the APX recipe to run (must be one of ["code_hotspots", "instruction_mix", "cpu_microarchitecture", "memory_access"], or "all" if unsure)
+        recipe: the APX recipe to run (must be one of ["code_hotspots", "instruction_mix", "cpu_microarchitecture", "memory_access"], or "all" if unsure).
+            Pass a list (or "all") to collect several recipes in one call. The workload still runs once per
+            recipe, one after another, since each recipe programs its own PMU counters: expect roughly one
+            workload duration per recipe. What the call shares is target preparation and tool deployment,
+            and each recipe's results are fetched while the next one runs. The result holds each recipe's
+            results keyed by recipe, with per-recipe timings.
 
     Returns:
-        JSON with the results of the workload. 
+        JSON with the results of the workload. Rows come in pages of 100; when has_more is true,
+        pass next_cursor to apx_query_results for the next page instead of rerunning the workload.
     """
     log_invocation_reason(
         tool="apx_recipe_run",
@@ -259,6 +419,16 @@ def apx_recipe_run(cmd:str, remote_ip_addr:str, remote_usr:str, recipe:str="code
             "recipe": recipe,
         },
     )
+    return await _apx_recipe_run(cmd, remote_ip_addr, remote_usr, recipe, on_output=_progress_reporter(ctx))
+
+
+async def _apx_recipe_run(
+    cmd: str,
+    remote_ip_addr: str,
+    remote_usr: str,
+    recipe: Union[str, List[str]],
+    on_output: Optional[OutputCallback] = None,
+) -> Dict[str, Any]:
     apx_dir = os.environ.get("APX_HOME", "/opt/apx")
     include_debug_trace = os.getenv("APX_DEBUG_TRACE", "").strip().lower() in {"1", "true", "yes", "on"}
     ssh_mount_env = resolve_apx_ssh_mount_env()
@@ -280,7 +450,14 @@ def apx_recipe_run(cmd:str, remote_ip_addr:str, remote_usr:str, recipe:str="code
             "details": mount_help["details"],
         }
 
-    target_add_res = prepare_target(remote_ip_addr, remote_usr, key_path, apx_dir)
+    # A target prepared by an earlier call is reused while its SSH health check passes.
+    session, target_add_res = await APX_SESSIONS.acquire(
+        remote_ip_addr,
+        remote_usr,
+        key_path,
+        known_hosts_path,
+        lambda: prepare_target(remote_ip_addr, remote_usr, key_path, apx_dir),
+    )
     if "error" in target_add_res:
         error_response = {
             "status": "error",
@@ -298,38 +475,342 @@ def apx_recipe_run(cmd:str, remote_ip_addr:str, remote_usr:str, recipe:str="code
             error_response["debug_trace"] = target_add_res.get("debug_trace", [])
         return error_response
     prepare_debug_trace = target_add_res.get("debug_trace", [])
-    
-    run_res = run_workload(cmd, target_add_res["target_id"], recipe, apx_dir)
+    target_id = target_add_res["target_id"]
+    recipes = resolve_recipes(recipe)
+    if len(recipes) > 1:
+        return await _apx_multi_recipe_run(
+            cmd, session, target_add_res, recipes, apx_dir, prepare_debug_trace, include_debug_trace, on_output
+        )
+
+    run_res = await _run_recipe_workload(cmd, session, target_id, recipes[0], apx_dir, on_output)
     if "error" in run_res:
-        error_response = {
-            "status": "error",
-            "recipe": recipe,
-            "stage": "workload_run",
-            "message": run_res.get("error", "Failed to run APX workload."),
-            "suggestion": (
-                "Confirm the workload command is valid on the target machine and that the selected recipe "
-                "is supported for your PMU permissions."
-            ),
-            "details": run_res.get("details", ""),
+        # The target may have changed under us; prepare it again on the next call.
+        APX_SESSIONS.invalidate(session)
+        return _workload_error_response(recipes[0], run_res, prepare_debug_trace, include_debug_trace)
+
+    results = await _recipe_results(run_res, recipes[0], apx_dir, prepare_debug_trace, include_debug_trace)
+    results["target_session"] = target_add_res.get("session")
+    return results
+
+
+async def _run_recipe_workload(
+    cmd: str,
+    session,
+    target_id: str,
+    recipe: str,
+    apx_dir: str,
+    on_output: Optional[OutputCallback],
+) -> Dict[str, Any]:
+    run_res = await run_workload(
+        cmd,
+        target_id,
+        recipe,
+        apx_dir,
+        on_output=on_output,
+        check_ready=recipe not in session.ready_recipes,
+    )
+    if "error" not in run_res:
+        session.ready_recipes.add(recipe)
+    return run_res
+
+
+def _workload_error_response(
+    recipe: str, run_res: Dict[str, Any], prepare_debug_trace: List[Dict[str, Any]], include_debug_trace: bool
+) -> Dict[str, Any]:
+    error_response = {
+        "status": "error",
+        "recipe": recipe,
+        "stage": "workload_run",
+        "message": run_res.get("error", "Failed to run APX workload."),
+        "suggestion": (
+            "Confirm the workload command is valid on the target machine and that the selected recipe "
+            "is supported for your PMU permissions."
+        ),
+        "details": run_res.get("details", ""),
+    }
+    if include_debug_trace:
+        error_response["debug_trace"] = {
+            "prepare_target": prepare_debug_trace,
+            "run_workload": run_res.get("debug_trace", []),
         }
-        if include_debug_trace:
-            error_response["debug_trace"] = {
-                "prepare_target": prepare_debug_trace,
-                "run_workload": run_res.get("debug_trace", []),
-            }
-        return error_response
-    
-    results = get_results(run_res["run_id"], recipe, apx_dir)
+    return error_response
+
+
+async def _recipe_results(
+    run_res: Dict[str, Any],
+    recipe: str,
+    apx_dir: str,
+    prepare_debug_trace: List[Dict[str, Any]],
+    include_debug_trace: bool,
+) -> Dict[str, Any]:
+    results = await get_results(run_res["run_id"], recipe, apx_dir)
     if include_debug_trace:
         results["debug_trace"] = {
             "prepare_target": prepare_debug_trace,
             "run_workload": run_res.get("debug_trace", []),
         }
-    
     return results
 
+
+async def _apx_multi_recipe_run(
+    cmd: str,
+    session,
+    target_add_res: Dict[str, Any],
+    recipes: List[str],
+    apx_dir: str,
+    prepare_debug_trace: List[Dict[str, Any]],
+    include_debug_trace: bool,
+    on_output: Optional[OutputCallback],
+) -> Dict[str, Any]:
+    """
+    Collect several recipes against one prepared target, sharing preparation and tool deployment.
+
+    This does not merge collections: APX takes one recipe per 'recipe run' and each recipe
+    programs its own PMU counter groups, so the workload runs once per recipe, one at a time;
+    running them concurrently would multiplex the counters and skew every result. Tools
+    deployed by the first run are reused by the later ones, and each recipe's results are
+    rendered and queried while the next recipe's workload runs.
+    """
+    started = time.monotonic()
+    timings: Dict[str, Dict[str, float]] = {}
+    results: Dict[str, Dict[str, Any]] = {}
+    fetches: Dict[str, asyncio.Task] = {}
+
+    async def fetch(name: str, run_res: Dict[str, Any]) -> Dict[str, Any]:
+        fetch_started = time.monotonic()
+        try:
+            return await _recipe_results(run_res, name, apx_dir, prepare_debug_trace, include_debug_trace)
+        finally:
+            timings[name]["results_seconds"] = round(time.monotonic() - fetch_started, 3)
+
+    try:
+        for name in recipes:
+            async def prefixed(stream: str, line: str, name: str = name) -> None:
+                await on_output(stream, f"[{name}] {line}")
+
+            run_started = time.monotonic()
+            run_res = await _run_recipe_workload(
+                cmd, session, target_add_res["target_id"], name, apx_dir,
+                prefixed if on_output is not None else None,
+            )
+            timings[name] = {"run_seconds": round(time.monotonic() - run_started, 3)}
+            if "error" in run_res:
+                results[name] = _workload_error_response(name, run_res, prepare_debug_trace, include_debug_trace)
+                continue
+            fetches[name] = asyncio.create_task(fetch(name, run_res))
+
+        for name, outcome in zip(fetches, await asyncio.gather(*fetches.values(), return_exceptions=True)):
+            if isinstance(outcome, BaseException):
+                outcome = format_tool_error(tool="apx_recipe_run", exc=outcome, args={"recipe": name})
+            results[name] = outcome
+    finally:
+        for task in fetches.values():
+            task.cancel()
+
+    if not fetches:
+        # No recipe ran at all, so the target may have changed; prepare it again on the next call.
+        APX_SESSIONS.invalidate(session)
+    statuses = [results[name].get("status") for name in recipes]
+    if all(status == "success" for status in statuses):
+        overall = "success"
+    elif all(status == "error" for status in statuses):
+        overall = "error"
+    else:
+        overall = "partial"
+    return {
+        "status": overall,
+        "recipes": recipes,
+        "results": {name: results[name] for name in recipes},
+        "workload_runs": len(timings),
+        "timings": timings,
+        "elapsed_seconds": round(time.monotonic() - started, 3),
+        "target_session": target_add_res.get("session"),
+    }
+
+
+@mcp.tool()
+async def apx_query_results(
+    cursor: Optional[str] = None,
+    run_id: Optional[str] = None,
+    recipe: str = "code_hotspots",
+    query: str = "default",
+    params: Optional[Dict[str, Any]] = None,
+    offset: int = 0,
+    limit: int = APX_RESULTS_PAGE_SIZE,
+    order_by: Optional[str] = None,
+    group_by: Optional[str] = None,
+    aggregate: Optional[str] = None,
+    aggregate_function: str = "sum",
+    invocation_reason: Optional[str] = None,
+) -> Dict[str, Any]:
+    """
+    Query the results of an earlier apx_recipe_run without running the workload again.
+
+    Pass the next_cursor returned by apx_recipe_run (or by this tool) to fetch the next page.
+    Alternatively pass the run_id and recipe of an earlier run with a named query from
+    apx_query_catalog (e.g. "inclusive", "call_paths", "per_thread") and its parameters, plus
+    an explicit page, ordering or aggregation; rows are sorted and aggregated in the APX
+    database, not in this response.
+
+    Args:
+        cursor: next_cursor from an earlier result; when set, the other paging arguments are ignored
+        run_id: run ID reported by apx_recipe_run
+        recipe: the recipe the run was collected with
+        query: named query of that recipe, as listed by apx_query_catalog
+        params: values for the query's typed parameters, e.g. {"top_n": 20, "symbol": "%memcpy%"}
+        offset: number of rows to skip
+        limit: rows per page (default 100, at most 5000)
+        order_by: column to sort by, e.g. "samples DESC" or "-samples"
+        group_by: column to group rows by; combine with aggregate
+        aggregate: numeric column to aggregate per group
+        aggregate_function: one of sum, avg, min, max, count
+
+    Returns:
+        One page of rows with has_more and, when more rows follow, next_cursor.
+    """
+    log_invocation_reason(
+        tool="apx_query_results",
+        reason=invocation_reason,
+        args={
+            "cursor": cursor,
+            "run_id": run_id,
+            "recipe": recipe,
+            "query": query,
+            "params": params,
+            "offset": offset,
+            "limit": limit,
+            "order_by": order_by,
+            "group_by": group_by,
+            "aggregate": aggregate,
+            "aggregate_function": aggregate_function,
+        },
+    )
+    try:
+        apx_dir = os.environ.get("APX_HOME", "/opt/apx")
+        session_id = None
+        tiebreak_columns = 0
+        if cursor:
+            page = decode_results_cursor(cursor)
+            run_id = page["run_id"]
+            recipe = page["recipe"]
+            query = page.get("query_name", "default")
+            params = page.get("params")
+            session_id = page.get("session_id")
+            offset = page.get("offset", 0)
+            limit = page.get("limit", APX_RESULTS_PAGE_SIZE)
+            order_by = page.get("order_by")
+            group_by = page.get("group_by")
+            aggregate = page.get("aggregate")
+            aggregate_function = page.get("aggregate_function", "sum")
+            tiebreak_columns = page.get("tiebreak_columns", 0)
+        if not run_id:
+            return {"status": "error", "message": "Pass either a cursor or the run_id of an earlier apx_recipe_run."}
+        return await get_results(
+            {"value": run_id},
+            recipe,
+            apx_dir,
+            offset=offset,
+            limit=limit,
+            order_by=order_by,
+            group_by=group_by,
+            aggregate=aggregate,
+            aggregate_function=aggregate_function,
+            session_id=session_id,
+            query_name=query,
+            params=params,
+            tiebreak_columns=tiebreak_columns,
+        )
+    except Exception as exc:
+        return format_tool_error(
+            tool="apx_query_results",
+            exc=exc,
+            args={"run_id": run_id, "recipe": recipe, "query": query, "offset": offset, "limit": limit},
+        )
+
+
+@mcp.tool()
+async def apx_compare_runs(
+    run_a: str,
+    run_b: str,
+    recipe: str = "code_hotspots",
+    threshold: float = 1.0,
+    relative_threshold_percent: float = 10.0,
+    top_n: int = 50,
+    invocation_reason: Optional[str] = None,
+) -> Dict[str, Any]:
+    """
+    Compare two earlier apx_recipe_run results of the same recipe, e.g. x86 baseline vs Arm
+    candidate, or before vs after an optimization. Use the run_id of each apx_recipe_run result.
+
+    Functions (or metrics) are aligned across the runs, so compiler clone suffixes such as
+    .constprop.0 or .isra.0 do not split one function in two. Each metric gets the value in both
+    runs, the delta, and the relative change. Sample shares are compared in percentage points,
+    because raw sample counts depend on run length and sampling rate.
+
+    A function is a regression when its self-sample share grows by at least `threshold`
+    percentage points. A microarchitecture metric is a regression when it moves by at least
+    `relative_threshold_percent` in the worse direction; IPC and retiring improve as they grow.
+
+    Args:
+        run_a: baseline run ID
+        run_b: candidate run ID
+        recipe: recipe both runs were collected with ("code_hotspots" or "cpu_microarchitecture" are aligned per function / metric)
+        threshold: percentage-point change of a sample share that counts as a regression or improvement
+        relative_threshold_percent: relative change of other metrics that counts as a regression or improvement
+        top_n: rows returned in each of rows, regressions and improvements
+
+    Returns:
+        JSON with matched/only-in-one-run counts, regressions, improvements and the largest deltas.
+    """
+    log_invocation_reason(
+        tool="apx_compare_runs",
+        reason=invocation_reason,
+        args={
+            "run_a": run_a,
+            "run_b": run_b,
+            "recipe": recipe,
+            "threshold": threshold,
+            "relative_threshold_percent": relative_threshold_percent,
+            "top_n": top_n,
+        },
+    )
+    try:
+        apx_dir = os.environ.get("APX_HOME", "/opt/apx")
+        return await compare_runs(run_a, run_b, recipe, apx_dir, threshold, relative_threshold_percent, top_n)
+    except Exception as exc:
+        return format_tool_error(
+            tool="apx_compare_runs",
+            exc=exc,
+            args={"run_a": run_a, "run_b": run_b, "recipe": recipe},
+        )
+
+
+@mcp.tool()
+async def apx_query_catalog(recipe: Optional[str] = None, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    """
+    List the named APX queries that apx_query_results can run against an existing run.
+
+    Each entry gives the recipe, query name, a description, and its typed parameters with
+    defaults (for example top_n, symbol, min_percent, thread).
+
+    Args:
+        recipe: only list this recipe's queries
+
+    Returns:
+        JSON with the list of queries.
+    """
+    log_invocation_reason(
+        tool="apx_query_catalog",
+        reason=invocation_reason,
+        args={"recipe": recipe},
+    )
+    try:
+        return {"status": "success", "queries": list_recipe_queries(recipe)}
+    except Exception as exc:
+        return format_tool_error(tool="apx_query_catalog", exc=exc, args={"recipe": recipe})
+
 @mcp.tool(description="If a user asks to migrate a codebase to Arm, strongly consider using this tool as a part of your overall strategy. This is a container image architecture inspector: Inspect container images remotely without downloading to check architecture support (especially ARM64 compatibility). Useful before migrating workloads to ARM-based infrastructure. Set 'image' (e.g. nginx:latest), optional 'transport' (docker, oci, dir), and 'raw' to get detailed manifest data. Shows available architectures, OS support, and image metadata. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context.")
-def skopeo(image: Optional[str] = None, transport: str = "docker", raw: bool = False, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+async def skopeo(image: Optional[str] = None, transport: str = "docker", raw: bool = False, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
     log_invocation_reason(
         tool="skopeo",
         reason=invocation_reason,
@@ -337,8 +818,8 @@ def skopeo(image: Optional[str] = None, transport: str = "docker", raw: bool = F
     )
     try:
         if not image:
-            return skopeo_help()
-        return skopeo_inspect(image=image, transport=transport, raw=raw)
+            return await skopeo_help()
+        return await skopeo_inspect(image=image, transport=transport, raw=raw)
     except Exception as e:
         return format_tool_error(
             tool="skopeo",
@@ -347,8 +828,25 @@ def skopeo(image: Optional[str] = None, transport: str = "docker", raw: bool = F
         )
 
 
+@mcp.tool(description="Batch container image inspector: inspect many images at once with skopeo (e.g. every base and dependency image of a project) and get a compact per-platform summary for each: os, architecture, variant, digest, layer count and compressed size, plus whether arm64 is available. Images are inspected concurrently with a per-call timeout, and results are cached by image digest. Set 'images' (e.g. [\"nginx:latest\", \"quay.io/org/app:1.2\"]), optional 'transport' (docker, oci, dir) and 'timeout_seconds'. Use the skopeo tool with raw=true when the full manifest of one image is needed. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context.")
+async def skopeo_batch(images: List[str], transport: str = "docker", timeout_seconds: Optional[float] = None, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    log_invocation_reason(
+        tool="skopeo_batch",
+        reason=invocation_reason,
+        args={"images": images, "transport": transport, "timeout_seconds": timeout_seconds},
+    )
+    try:
+        return await skopeo_inspect_images(images, transport=transport, timeout=timeout_seconds)
+    except Exception as e:
+        return format_tool_error(
+            tool="skopeo_batch",
+            exc=e,
+            args={"images": images, "transport": transport, "timeout_seconds": timeout_seconds},
+        )
+
+
 @mcp.tool(description="Assembly Code Performance Analyzer: Analyze assembly code to predict performance on different CPU architectures and identify bottlenecks. Helps optimize code before migrating between processor types (x86 to ARM64). Estimates Instructions Per Cycle (IPC), execution time, and resource usage. Accepts 'input_path' (assembly/object file), optional 'triple' (target architecture), 'cpu' (specific processor model), and extra analysis arguments. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context.")
-def mca(input_path: Optional[str] = None, triple: Optional[str] = None, cpu: Optional[str] = None, extra_args: Optional[List[str]] = None, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+async def mca(input_path: Optional[str] = None, triple: Optional[str] = None, cpu: Optional[str] = None, extra_args: Optional[List[str]] = None, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
     log_invocation_reason(
         tool="mca",
         reason=invocation_reason,
@@ -356,8 +854,8 @@ def mca(input_path: Optional[str] = None, triple: Optional[str] = None, cpu: Opt
     )
     try:
         if not input_path:
-            return mca_help()
-        return llvm_mca_analyze(input_path=input_path, triple=triple, cpu=cpu, extra_args=extra_args)
+            return await mca_help()
+        return await llvm_mca_analyze(input_path=input_path, triple=triple, cpu=cpu, extra_args=extra_args)
     except Exception as e:
         return format_tool_error(
             tool="mca",
@@ -366,5 +864,249 @@ def mca(input_path: Optional[str] = None, triple: Optional[str] = None, cpu: Opt
         )
 
 
+@mcp.tool(description="Assembly Code Performance Sweep: analyze the same assembly kernel with llvm-mca on several CPUs in parallel (by default Arm Neoverse N1, N2, V1 and V2) and compare them side by side. Set 'input_path' (AArch64 assembly), optional 'cpus' (llvm-mca CPU names), and 'x86_input_path' (an x86-64 build of the same kernel) with optional 'x86_cpus' to add an x86 baseline. Returns structured IPC, block RThroughput, uOps and per-resource pressure for each target, a ranking by cycles per iteration with the bottleneck of each target (a named resource, or a dependency chain), and a markdown comparison table. CPUs this llvm-mca does not model are reported as errors rather than analyzed with a generic model. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context.")
+async def mca_sweep(input_path: str, cpus: Optional[List[str]] = None, x86_input_path: Optional[str] = None, x86_cpus: Optional[List[str]] = None, extra_args: Optional[List[str]] = None, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    args = {"input_path": input_path, "cpus": cpus, "x86_input_path": x86_input_path, "x86_cpus": x86_cpus, "extra_args": extra_args}
+    log_invocation_reason(
+        tool="mca_sweep",
+        reason=invocation_reason,
+        args=args,
+    )
+    try:
+        return await llvm_mca_sweep(input_path=input_path, cpus=cpus, x86_input_path=x86_input_path, x86_cpus=x86_cpus, extra_args=extra_args)
+    except Exception as e:
+        return format_tool_error(
+            tool="mca_sweep",
+            exc=e,
+            args=args,
+        )
+
+
+@mcp.tool(description="Compile and Analyze Hot Functions: compile a C/C++ source file for an Arm CPU and run llvm-mca on its hot code, without writing assembly by hand. Set 'source_path' and either 'functions' (names as a profiler reports them, e.g. 'Matrix::multiply(float*, int)'), 'run_id' (an APX code_hotspots run; its 'top_n' hottest functions are analyzed), or LLVM-MCA-BEGIN/LLVM-MCA-END markers in the source. 'cpu' is used for both -mcpu and the llvm-mca model (default neoverse-v1), 'opt_level' is O1/O2/O3/Ofast, 'vector' is auto, neon, sve, sve2 or none, and 'compiler' is clang or gcc. Each innermost loop of a function (or the whole function when it has no loop) is analyzed as its own region; returns the region's instructions with IPC, cycles per iteration, resource pressure and bottleneck. Functions not defined in the source (library calls) are listed in 'not_found'. Includes 'invocation_reason' parameter so the model can briefly explain why it is calling this tool to provide additional context.")
+async def mca_compile_analyze(source_path: str, functions: Optional[List[str]] = None, run_id: Optional[str] = None, top_n: int = 5, cpu: str = "neoverse-v1", opt_level: str = "O3", vector: str = "auto", compiler: str = "clang", extra_flags: Optional[List[str]] = None, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    args = {"source_path": source_path, "functions": functions, "run_id": run_id, "top_n": top_n, "cpu": cpu, "opt_level": opt_level, "vector": vector, "compiler": compiler, "extra_flags": extra_flags}
+    log_invocation_reason(
+        tool="mca_compile_analyze",
+        reason=invocation_reason,
+        args=args,
+    )
+    try:
+        names = list(functions or [])
+        if run_id:
+            apx_dir = os.environ.get("APX_HOME", "/opt/apx")
+            hot, error = await hotspot_functions(run_id, apx_dir, top_n=top_n)
+            if error is not None:
+                return {"status": "error", "stage": "hotspots", "message": f"Could not read code_hotspots results for run {run_id}.", "details": error}
+            names += hot
+        return await compile_and_analyze(source_path, functions=names, cpu=cpu, opt_level=opt_level, vector=vector, compiler=compiler, extra_flags=extra_flags)
+    except Exception as e:
+        return format_tool_error(
+            tool="mca_compile_analyze",
+            exc=e,
+            args=args,
+        )
+
+
+def _unknown_job(job_id: str) -> Dict[str, Any]:
+    return {
+        "status": "error",
+        "message": f"Unknown job_id '{job_id}'. It may have expired; finished jobs are kept for a limited time.",
+    }
+
+
+@mcp.tool()
+async def start_migrate_ease_scan(
+    scanner: Union[str, List[str]],
+    arch: str = DEFAULT_ARCH,
+    git_repo: Optional[str] = None,
+    output_format: str = "json",
+    extra_args: Optional[List[str]] = None,
+    git_ref: Optional[str] = None,
+    invocation_reason: Optional[str] = None,
+) -> Dict[str, Any]:
+    """
+    Start a migrate-ease scan as a background job and return its job_id immediately.
+
+    Takes the same arguments as migrate_ease_scan. Use this for large codebases or when several
+    scans should run concurrently; poll with job_status (which streams scanner output as progress),
+    fetch the report with job_result, and stop it with job_cancel.
+
+    Returns:
+        JSON with the job_id and the job's initial status.
+    """
+    args = {
+        "scanner": scanner,
+        "arch": arch,
+        "git_repo": git_repo,
+        "output_format": output_format,
+        "extra_args": extra_args,
+        "git_ref": git_ref,
+    }
+    log_invocation_reason(tool="start_migrate_ease_scan", reason=invocation_reason, args=args)
+    job = JOBS.start(
+        "migrate_ease_scan",
+        args,
+        lambda on_output: _migrate_ease_scan(
+            scanner, arch, git_repo, output_format, extra_args, on_output=on_output, git_ref=git_ref
+        ),
+    )
+    return job.summary()
+
+
+@mcp.tool()
+async def start_apx_recipe_run(cmd: str, remote_ip_addr: str, remote_usr: str, recipe: Union[str, List[str]] = "code_hotspots", invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    """
+    Start an APX (Arm Performix) recipe run as a background job and return its job_id immediately.
+
+    Takes the same arguments as apx_recipe_run and follows the same guidance on targets, SSH access,
+    and recipes. Use this for long workloads so a client timeout does not discard the run; poll with
+    job_status (which streams APX output as progress), fetch the results with job_result, and stop it
+    with job_cancel.
+
+    Returns:
+        JSON with the job_id and the job's initial status.
+    """
+    args = {
+        "cmd": cmd,
+        "remote_ip_addr": remote_ip_addr,
+        "remote_usr": remote_usr,
+        "recipe": recipe,
+    }
+    log_invocation_reason(tool="start_apx_recipe_run", reason=invocation_reason, args=args)
+    job = JOBS.start(
+        "apx_recipe_run",
+        args,
+        lambda on_output: _apx_recipe_run(cmd, remote_ip_addr, remote_usr, recipe, on_output=on_output),
+    )
+    return job.summary()
+
+
+@mcp.tool()
+async def job_status(job_id: Optional[str] = None, wait_seconds: float = 0, tail_lines: int = 20, invocation_reason: Optional[str] = None, ctx: Context = None) -> Dict[str, Any]:
+    """
+    Report the status of a background job started by start_migrate_ease_scan or start_apx_recipe_run:
+    pending, running, succeeded, failed, or cancelled, with elapsed time and the latest output lines.
+
+    Args:
+        job_id: the job to report on; omit it to list all known jobs
+        wait_seconds: wait up to this long (at most 120) for the job to finish; new output is
+            streamed as progress notifications while waiting
+        tail_lines: how many of the latest output lines to include
+
+    Returns:
+        JSON with the job's status, or the list of jobs when job_id is omitted.
+    """
+    args = {"job_id": job_id, "wait_seconds": wait_seconds, "tail_lines": tail_lines}
+    log_invocation_reason(tool="job_status", reason=invocation_reason, args=args)
+    try:
+        if not job_id:
+            return {"status": "ok", "jobs": [job.summary(tail=0) for job in JOBS.list()]}
+        job = JOBS.get(job_id)
+        if job is None:
+            return _unknown_job(job_id)
+
+        report = _progress_reporter(ctx)
+        seen_lines = job.output_lines
+        deadline = asyncio.get_running_loop().time() + min(max(wait_seconds, 0), JOB_STATUS_MAX_WAIT_SECONDS)
+        while job.status not in FINISHED_STATES:
+            remaining = deadline - asyncio.get_running_loop().time()
+            if not await JOBS.wait(job, remaining):
+                break
+            if report is not None and job.output_lines > seen_lines:
+                new_lines = list(job.output_tail)[-min(job.output_lines - seen_lines, len(job.output_tail)):]
+                for line in new_lines:
+                    await report("stdout", line)
+            seen_lines = job.output_lines
+        return job.summary(tail=tail_lines)
+    except Exception as exc:
+        return format_tool_error(tool="job_status", exc=exc, args=args)
+
+
+@mcp.tool()
+async def job_result(job_id: str, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    """
+    Fetch the result of a finished background job: the same payload migrate_ease_scan or
+    apx_recipe_run would have returned.
+
+    Args:
+        job_id: the job returned by start_migrate_ease_scan or start_apx_recipe_run
+
+    Returns:
+        JSON with the job's status and result. If the job is still running, returns its status
+        instead; use job_status with 'wait_seconds' to wait for it.
+    """
+    log_invocation_reason(tool="job_result", reason=invocation_reason, args={"job_id": job_id})
+    try:
+        job = JOBS.get(job_id)
+        if job is None:
+            return _unknown_job(job_id)
+        if job.status not in FINISHED_STATES:
+            return {**job.summary(), "message": "Job has not finished yet."}
+        return {**job.summary(tail=0), "result": job.result}
+    except Exception as exc:
+        return format_tool_error(tool="job_result", exc=exc, args={"job_id": job_id})
+
+
+@mcp.tool()
+async def job_cancel(job_id: str, invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    """
+    Cancel a pending or running background job. Its child process is killed and temporary files
+    are cleaned up; the job is then reported as cancelled.
+
+    Args:
+        job_id: the job returned by start_migrate_ease_scan or start_apx_recipe_run
+
+    Returns:
+        JSON with the job's final status.
+    """
+    log_invocation_reason(tool="job_cancel", reason=invocation_reason, args={"job_id": job_id})
+    try:
+        job = JOBS.cancel(job_id)
+        if job is None:
+            return _unknown_job(job_id)
+        if job.task is not None and not job.task.done():
+            # Let the cancellation reach the job so its final state is reported.
+            await asyncio.wait([job.task], timeout=10)
+        return job.summary()
+    except Exception as exc:
+        return format_tool_error(tool="job_cancel", exc=exc, args={"job_id": job_id})
+
+
+@mcp.tool()
+async def server_stats(format: str = "json", invocation_reason: Optional[str] = None) -> Dict[str, Any]:
+    """
+    Report how long each tool of this MCP server has taken since it started: per tool call count,
+    errors, wall time percentiles over recent calls, time spent in child processes, response size
+    (bytes and an approximate token count), process RSS, and for knowledge base search the time per
+    search stage. Tools are listed slowest (by total wall time) first.
+
+    Args:
+        format: "json", or "openmetrics" to get the same data as OpenMetrics text for Prometheus
+
+    Returns:
+        JSON with the per-tool statistics, or {"format": "openmetrics", "text": ...}.
+    """
+    log_invocation_reason(tool="server_stats", reason=invocation_reason, args={"format": format})
+    try:
+        if format == "openmetrics":
+            return {"format": "openmetrics", "text": TOOL_METRICS.openmetrics()}
+        if format != "json":
+            return {"status": "error", "message": f"Unknown format {format!r}; use 'json' or 'openmetrics'."}
+        stats = TOOL_METRICS.snapshot()
+        if SEARCH_RESOURCES.cache is not None:
+            stats["search_cache"] = SEARCH_RESOURCES.cache.stats()
+        return stats
+    except Exception as exc:
+        return format_tool_error(tool="server_stats", exc=exc, args={"format": format})
+
+
+def _exit_on_sigterm(signum, frame) -> None:
+    # docker stop sends SIGTERM, which would end the process without running atexit: write the
+    # queued invocation, error and metrics log lines now, then exit so the atexit handlers run too.
+    LOG_WRITER.close()
+    raise SystemExit(128 + signum)
+
+
 if __name__ == "__main__":
+    signal.signal(signal.SIGTERM, _exit_on_sigterm)
     mcp.run(transport="stdio")
@@ -1,40 +1,193 @@
--- name: code_hotspots.default
+-- name: code_hotspots.function_samples
+-- description: Self and inclusive periodic samples per function and node type. Other code_hotspots queries build on it.
+-- order: periodic_samples_self DESC, function_name ASC, node_type ASC
 WITH per_node AS (
     SELECT
         COALESCE(NULLIF(s.name, ''), 'EMPTY_SYMBOLS') AS function_name,
         d.node_type,
         d.call_tree_id,
         MAX(CASE WHEN m.name = 'Periodic Samples (self)' THEN d.measurement_value ELSE 0 END) AS periodic_samples_self,
-        MAX(CASE WHEN m.name = 'Periodic Samples (self) - percentage' THEN d.measurement_value ELSE 0 END) AS periodic_samples_self_percent
+        MAX(CASE WHEN m.name = 'Periodic Samples (self) - percentage' THEN d.measurement_value ELSE 0 END) AS periodic_samples_self_percent,
+        MAX(CASE WHEN m.name = 'Periodic Samples (total)' THEN d.measurement_value ELSE 0 END) AS periodic_samples_total,
+        MAX(CASE WHEN m.name = 'Periodic Samples (total) - percentage' THEN d.measurement_value ELSE 0 END) AS periodic_samples_total_percent
     FROM drilldown_1 d
     LEFT JOIN symbols s
         ON d.symbol_id = s.symbol_id
     LEFT JOIN drilldown_measurements_1 m
         ON d.measurement_id = m.measurement_id
     GROUP BY d.call_tree_id, s.name, d.node_type
-),
-agg AS (
-    SELECT
-        function_name,
-        node_type,
-        SUM(periodic_samples_self)         AS periodic_samples_self,
-        SUM(periodic_samples_self_percent) AS periodic_samples_self_percent
-    FROM per_node
-    GROUP BY function_name, node_type
 )
+SELECT
+    function_name,
+    node_type,
+    SUM(periodic_samples_self)          AS periodic_samples_self,
+    SUM(periodic_samples_self_percent)  AS periodic_samples_self_percent,
+    SUM(periodic_samples_total)         AS periodic_samples_total,
+    SUM(periodic_samples_total_percent) AS periodic_samples_total_percent
+FROM per_node
+GROUP BY function_name, node_type;
+
+-- name: code_hotspots.default
+-- description: Functions ranked by self samples, busiest first.
+-- order: periodic_samples_self DESC, function_name ASC, node_type ASC
+-- param: symbol str null SQL LIKE pattern the function name must match, e.g. '%memcpy%'.
+-- param: min_percent float 0 Minimum self-sample percentage.
+-- uses: code_hotspots.function_samples AS agg
+SELECT
+    a.function_name,
+    a.node_type,
+    a.periodic_samples_self,
+    a.periodic_samples_self_percent
+FROM agg a
+WHERE (:symbol IS NULL OR a.function_name LIKE :symbol)
+    AND a.periodic_samples_self_percent >= :min_percent
+ORDER BY a.periodic_samples_self DESC;
+
+-- name: code_hotspots.top_functions
+-- description: The top_n functions by self samples.
+-- order: periodic_samples_self DESC, function_name ASC, node_type ASC
+-- param: top_n int 10 Number of functions to return.
+-- param: symbol str null SQL LIKE pattern the function name must match.
+-- param: min_percent float 0 Minimum self-sample percentage.
+-- uses: code_hotspots.function_samples AS agg
+SELECT
+    a.function_name,
+    a.node_type,
+    a.periodic_samples_self,
+    a.periodic_samples_self_percent
+FROM agg a
+WHERE (:symbol IS NULL OR a.function_name LIKE :symbol)
+    AND a.periodic_samples_self_percent >= :min_percent
+ORDER BY a.periodic_samples_self DESC
+LIMIT :top_n;
+
+-- name: code_hotspots.inclusive
+-- description: Functions ranked by inclusive samples (the function plus everything it calls).
+-- order: periodic_samples_total DESC, function_name ASC, node_type ASC
+-- param: top_n int 10 Number of functions to return.
+-- param: symbol str null SQL LIKE pattern the function name must match.
+-- param: min_percent float 0 Minimum inclusive-sample percentage.
+-- uses: code_hotspots.function_samples AS agg
 SELECT
     a.function_name,
     a.node_type,
+    a.periodic_samples_total,
+    a.periodic_samples_total_percent,
     a.periodic_samples_self,
     a.periodic_samples_self_percent
 FROM agg a
-ORDER BY a.periodic_samples_self DESC LIMIT 10;
+WHERE (:symbol IS NULL OR a.function_name LIKE :symbol)
+    AND a.periodic_samples_total_percent >= :min_percent
+ORDER BY a.periodic_samples_total DESC
+LIMIT :top_n;
+
+-- name: code_hotspots.call_tree_nodes
+-- description: One row per call tree node with its parent, symbol and sample counts. call_paths and per_thread build on it.
+-- order: call_tree_id ASC
+SELECT
+    d.call_tree_id,
+    MAX(d.parent_call_tree_id) AS parent_call_tree_id,
+    MAX(d.node_type) AS node_type,
+    MAX(COALESCE(NULLIF(s.name, ''), 'EMPTY_SYMBOLS')) AS function_name,
+    MAX(CASE WHEN m.name = 'Periodic Samples (self)' THEN d.measurement_value ELSE 0 END) AS periodic_samples_self,
+    MAX(CASE WHEN m.name = 'Periodic Samples (total)' THEN d.measurement_value ELSE 0 END) AS periodic_samples_total,
+    MAX(CASE WHEN m.name = 'Periodic Samples (total) - percentage' THEN d.measurement_value ELSE 0 END) AS periodic_samples_total_percent
+FROM drilldown_1 d
+LEFT JOIN symbols s
+    ON d.symbol_id = s.symbol_id
+LEFT JOIN drilldown_measurements_1 m
+    ON d.measurement_id = m.measurement_id
+GROUP BY d.call_tree_id;
+
+-- name: code_hotspots.call_paths
+-- description: Hottest call paths from the root, by inclusive samples of the path's last function.
+-- order: periodic_samples_total DESC, depth ASC, call_path ASC
+-- param: top_n int 20 Number of call paths to return.
+-- param: symbol str null SQL LIKE pattern the last function of the path must match.
+-- param: min_percent float 1 Minimum inclusive-sample percentage.
+-- param: max_depth int 32 Deepest call path returned.
+-- uses: code_hotspots.call_tree_nodes AS nodes
+WITH RECURSIVE paths AS (
+    SELECT n.call_tree_id, n.function_name AS call_path, 0 AS depth
+    FROM nodes n
+    WHERE n.parent_call_tree_id IS NULL
+    UNION ALL
+    SELECT n.call_tree_id, p.call_path || ' > ' || n.function_name, p.depth + 1
+    FROM nodes n
+    JOIN paths p
+        ON n.parent_call_tree_id = p.call_tree_id
+    WHERE p.depth < :max_depth
+)
+SELECT
+    p.call_path,
+    p.depth,
+    n.function_name,
+    n.periodic_samples_total,
+    n.periodic_samples_total_percent,
+    n.periodic_samples_self
+FROM paths p
+JOIN nodes n
+    ON n.call_tree_id = p.call_tree_id
+WHERE (:symbol IS NULL OR n.function_name LIKE :symbol)
+    AND n.periodic_samples_total_percent >= :min_percent
+ORDER BY n.periodic_samples_total DESC, p.depth
+LIMIT :top_n;
+
+-- name: code_hotspots.per_thread
+-- description: Self samples per thread and function; each call tree node counts toward its nearest THREAD ancestor.
+-- order: thread_samples_self DESC, thread ASC, rank_in_thread ASC
+-- param: thread str null SQL LIKE pattern the thread name must match.
+-- param: symbol str null SQL LIKE pattern the function name must match.
+-- param: top_n int 10 Number of functions returned per thread.
+-- uses: code_hotspots.call_tree_nodes AS nodes
+WITH RECURSIVE thread_of AS (
+    SELECT n.call_tree_id, n.call_tree_id AS thread_node_id
+    FROM nodes n
+    WHERE UPPER(n.node_type) = 'THREAD'
+    UNION ALL
+    SELECT n.call_tree_id, t.thread_node_id
+    FROM nodes n
+    JOIN thread_of t
+        ON n.parent_call_tree_id = t.call_tree_id
+    WHERE UPPER(n.node_type) <> 'THREAD'
+),
+per_thread AS (
+    SELECT
+        th.function_name AS thread,
+        n.function_name,
+        SUM(n.periodic_samples_self) AS periodic_samples_self
+    FROM thread_of t
+    JOIN nodes n
+        ON n.call_tree_id = t.call_tree_id
+    JOIN nodes th
+        ON th.call_tree_id = t.thread_node_id
+    WHERE n.call_tree_id <> t.thread_node_id
+    GROUP BY th.function_name, n.function_name
+),
+ranked AS (
+    SELECT
+        *,
+        ROW_NUMBER() OVER (PARTITION BY thread ORDER BY periodic_samples_self DESC) AS rank_in_thread,
+        SUM(periodic_samples_self) OVER (PARTITION BY thread) AS thread_samples_self
+    FROM per_thread
+)
+SELECT thread, rank_in_thread, function_name, periodic_samples_self, thread_samples_self
+FROM ranked
+WHERE (:thread IS NULL OR thread LIKE :thread)
+    AND (:symbol IS NULL OR function_name LIKE :symbol)
+    AND rank_in_thread <= :top_n
+ORDER BY thread_samples_self DESC, thread, rank_in_thread;
 
 -- name: instruction_mix.default
 SELECT *
 FROM flat_table;
 
 -- name: cpu_microarchitecture.default
+-- description: Top-down metrics for one call tree node (0 is the whole program), largest first.
+-- order: value DESC, metric ASC, units ASC
+-- param: call_tree_id int 0 Call tree node to report.
+-- param: metric str null SQL LIKE pattern the metric name must match, e.g. '%Bound%'.
+-- param: min_value float null Smallest metric value returned.
 SELECT
     dm1.NAME AS metric,
     dm1.UNITS AS units,
@@ -42,9 +195,36 @@ SELECT
 FROM drilldown_1 d1
 JOIN drilldown_measurements_1 dm1
     ON d1.MEASUREMENT_ID = dm1.MEASUREMENT_ID
-WHERE d1.CALL_TREE_ID = 0
+WHERE d1.CALL_TREE_ID = :call_tree_id
+    AND (:metric IS NULL OR dm1.NAME LIKE :metric)
+    AND (:min_value IS NULL OR d1.MEASUREMENT_VALUE >= :min_value)
 ORDER BY value DESC;
 
+-- name: cpu_microarchitecture.function_metrics
+-- description: One top-down metric per function, for the top_n functions by that metric.
+-- order: value DESC, function_name ASC, metric ASC, units ASC
+-- param: metric str null SQL LIKE pattern of the metric to rank by; all metrics when unset.
+-- param: symbol str null SQL LIKE pattern the function name must match.
+-- param: top_n int 10 Number of rows to return.
+-- param: min_value float null Smallest metric value returned.
+SELECT
+    COALESCE(NULLIF(s.name, ''), 'EMPTY_SYMBOLS') AS function_name,
+    dm1.NAME AS metric,
+    dm1.UNITS AS units,
+    SUM(d1.MEASUREMENT_VALUE) AS value
+FROM drilldown_1 d1
+JOIN drilldown_measurements_1 dm1
+    ON d1.MEASUREMENT_ID = dm1.MEASUREMENT_ID
+LEFT JOIN symbols s
+    ON d1.SYMBOL_ID = s.SYMBOL_ID
+WHERE d1.CALL_TREE_ID <> 0
+    AND (:metric IS NULL OR dm1.NAME LIKE :metric)
+    AND (:symbol IS NULL OR s.name LIKE :symbol)
+GROUP BY s.name, dm1.NAME, dm1.UNITS
+HAVING (:min_value IS NULL OR SUM(d1.MEASUREMENT_VALUE) >= :min_value)
+ORDER BY value DESC
+LIMIT :top_n;
+
 -- name: memory_access.default
 SELECT *
 FROM drilldown;
@@ -106,6 +106,18 @@ EXPECTED_CHECK_NGINX_RESPONSE = [
     "https://learn.arm.com/learning-paths/servers-and-cloud-computing/nginx_tune",
     ]
 
+CHECK_KB_BATCH_REQUEST = {
+            "jsonrpc": "2.0",
+            "id": 10,
+            "method": "tools/call",
+            "params": {
+                "name": "knowledge_base_search_batch",
+                "arguments": {
+                    "queries": ["nginx performance tweaks", "Is redis compatible with Arm architecture?"],
+                },
+            },
+        }
+
 CHECK_MIGRATE_EASE_TOOL_REQUEST = {
             "jsonrpc": "2.0",
             "id": 5,
@@ -198,6 +210,46 @@ EXPECTED_CHECK_MIGRATE_EASE_TOOL_RESPONSE = {
 
 EXPECTED_CHECK_MIGRATE_EASE_TOOL_RESPONSE_STATUS = "success"
 
+START_MIGRATE_EASE_JOB_REQUEST = {
+            "jsonrpc": "2.0",
+            "id": 11,
+            "method": "tools/call",
+            "params": {
+                "name": "start_migrate_ease_scan",
+                "arguments": {
+                    "scanner": "java",
+                },
+            },
+        }
+
+# job_id is filled in by the test from the start_migrate_ease_scan response.
+JOB_STATUS_REQUEST = {
+            "jsonrpc": "2.0",
+            "id": 12,
+            "method": "tools/call",
+            "params": {
+                "name": "job_status",
+                "arguments": {
+                    "job_id": None,
+                    "wait_seconds": 60,
+                },
+            },
+        }
+
+JOB_RESULT_REQUEST = {
+            "jsonrpc": "2.0",
+            "id": 13,
+            "method": "tools/call",
+            "params": {
+                "name": "job_result",
+                "arguments": {
+                    "job_id": None,
+                },
+            },
+        }
+
+EXPECTED_JOB_FINAL_STATUS = "succeeded"
+
 CHECK_SYSREPORT_TOOL_REQUEST = {
             "jsonrpc": "2.0",
             "id": 6,
@@ -245,6 +297,31 @@ EXPECTED_CHECK_MCA_TOOL_RESPONSE = {
 
 EXPECTED_CHECK_MCA_TOOL_RESPONSE_STATUS = "ok"     
 
+CHECK_MCA_SWEEP_REQUEST = {
+            "jsonrpc": "2.0",
+            "id": 14,
+            "method": "tools/call",
+            "params": {
+                "name": "mca_sweep",
+                "arguments": {
+                    "input_path": "/workspace/tests/sum_test.s",
+                    "invocation_reason": "Comparing the sum_test.s kernel across Neoverse N1, N2, V1 and V2 with llvm-mca"
+                },
+            },
+        }
+
+EXPECTED_MCA_SWEEP_CPUS = {"neoverse-n1", "neoverse-n2", "neoverse-v1", "neoverse-v2"}
+
+SERVER_STATS_REQUEST = {
+            "jsonrpc": "2.0",
+            "id": 15,
+            "method": "tools/call",
+            "params": {
+                "name": "server_stats",
+                "arguments": {},
+            },
+        }
+
 CHECK_APX_CPU_HOTSPOTS_JAVA_REQUEST = {
             "jsonrpc": "2.0",
             "id": 9,
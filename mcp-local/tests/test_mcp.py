@@ -202,6 +202,26 @@ def test_mcp_stdio_transport_responds(platform):
             assert expected_nginx_urls & actual_nginx_urls, "Test Failed: MCP check_nginx tool failed: content mismatch., Expected one of: {}, Received: {}".format(json.dumps(constants.EXPECTED_CHECK_NGINX_RESPONSE,indent=2), json.dumps(check_nginx_response.get("result")["structuredContent"],indent=2))
             print("\n***Test Passed: MCP check_nginx tool succeeded")
 
+            #Check Batched Knowledge Base Search Test
+            raw_socket.sendall(_encode_mcp_message(constants.CHECK_KB_BATCH_REQUEST))
+            check_kb_batch_response = _read_response(10, timeout=60)
+            kb_batch_result = check_kb_batch_response["result"]["structuredContent"].get("result", [])
+            expected_queries = constants.CHECK_KB_BATCH_REQUEST["params"]["arguments"]["queries"]
+            assert [entry.get("query") for entry in kb_batch_result] == expected_queries, "Test Failed: MCP knowledge_base_search_batch tool failed: query order mismatch. Expected: {}, Received: {}".format(expected_queries, json.dumps(kb_batch_result, indent=2))
+            batch_nginx_urls = {_base_url(item.get("url")) for item in kb_batch_result[0].get("results", []) if item.get("url")}
+            assert expected_nginx_urls & batch_nginx_urls, "Test Failed: MCP knowledge_base_search_batch tool failed: content mismatch., Expected one of: {}, Received: {}".format(json.dumps(constants.EXPECTED_CHECK_NGINX_RESPONSE,indent=2), json.dumps(kb_batch_result[0],indent=2))
+            print("\n***Test Passed: MCP knowledge_base_search_batch tool succeeded")
+
+            #Check Server Stats Tool Test - the searches above must have been recorded
+            raw_socket.sendall(_encode_mcp_message(constants.SERVER_STATS_REQUEST))
+            server_stats_response = _read_response(15, timeout=60)
+            tool_stats = server_stats_response["result"]["structuredContent"].get("tools", {})
+            kb_stats = tool_stats.get("knowledge_base_search", {})
+            assert kb_stats.get("calls", 0) >= 1 and kb_stats.get("response_bytes_max", 0) > 0, "Test Failed: MCP server_stats tool failed: knowledge_base_search not recorded. Received: {}".format(json.dumps(tool_stats, indent=2))
+            assert "dense" in kb_stats.get("stages_ms_mean", {}), "Test Failed: MCP server_stats tool failed: missing search stage timings. Received: {}".format(json.dumps(kb_stats, indent=2))
+            assert tool_stats.get("check_image", {}).get("calls", 0) >= 1, "Test Failed: MCP server_stats tool failed: check_image not recorded. Received: {}".format(json.dumps(tool_stats, indent=2))
+            print("\n***Test Passed: MCP server_stats tool succeeded")
+
             #Check Migrate Ease Tool Test
             raw_socket.sendall(_encode_mcp_message(constants.CHECK_MIGRATE_EASE_TOOL_REQUEST))
             check_migrate_ease_tool_response = _read_response(5, timeout=60)
@@ -209,6 +229,27 @@ def test_mcp_stdio_transport_responds(platform):
             assert check_migrate_ease_tool_response.get("result")["structuredContent"]["status"] == constants.EXPECTED_CHECK_MIGRATE_EASE_TOOL_RESPONSE_STATUS, "Test Failed: MCP check_migrate_ease_tool tool failed: status mismatch. Expected: {}, Received: {}".format(constants.EXPECTED_CHECK_MIGRATE_EASE_TOOL_RESPONSE_STATUS, check_migrate_ease_tool_response.get("result")["structuredContent"]["status"])
             print("\n***Test Passed: MCP check_migrate_ease_tool tool succeeded")
 
+            #Check Background Job Tools Test - same scan as above, run as a job
+            raw_socket.sendall(_encode_mcp_message(constants.START_MIGRATE_EASE_JOB_REQUEST))
+            start_job_response = _read_response(11, timeout=60)
+            job_id = start_job_response["result"]["structuredContent"].get("job_id")
+            assert job_id, "Test Failed: MCP start_migrate_ease_scan tool failed: missing job_id. Received: {}".format(json.dumps(start_job_response.get("result"), indent=2))
+
+            job_status_request = json.loads(json.dumps(constants.JOB_STATUS_REQUEST))
+            job_status_request["params"]["arguments"]["job_id"] = job_id
+            raw_socket.sendall(_encode_mcp_message(job_status_request))
+            job_status_response = _read_response(12, timeout=90)
+            job_state = job_status_response["result"]["structuredContent"].get("status")
+            assert job_state == constants.EXPECTED_JOB_FINAL_STATUS, "Test Failed: MCP job_status tool failed: status mismatch. Expected: {}, Received: {}".format(constants.EXPECTED_JOB_FINAL_STATUS, json.dumps(job_status_response.get("result"), indent=2))
+
+            job_result_request = json.loads(json.dumps(constants.JOB_RESULT_REQUEST))
+            job_result_request["params"]["arguments"]["job_id"] = job_id
+            raw_socket.sendall(_encode_mcp_message(job_result_request))
+            job_result_response = _read_response(13, timeout=60)
+            job_scan_status = job_result_response["result"]["structuredContent"].get("result", {}).get("status")
+            assert job_scan_status == constants.EXPECTED_CHECK_MIGRATE_EASE_TOOL_RESPONSE_STATUS, "Test Failed: MCP job_result tool failed: scan status mismatch. Expected: {}, Received: {}".format(constants.EXPECTED_CHECK_MIGRATE_EASE_TOOL_RESPONSE_STATUS, job_scan_status)
+            print("\n***Test Passed: MCP background job tools succeeded")
+
             #Check Sysreport Tool Test
             raw_socket.sendall(_encode_mcp_message(constants.CHECK_SYSREPORT_TOOL_REQUEST))
             check_sysreport_response = _read_response(6, timeout=60)
@@ -224,6 +265,15 @@ def test_mcp_stdio_transport_responds(platform):
             else:
                 print("\n***Test NA: MCP mca tool is not supported on this platform: {}".format(platform))
 
+            #Check MCA Sweep Tool Test - every target sets its own triple, so it runs on any platform
+            raw_socket.sendall(_encode_mcp_message(constants.CHECK_MCA_SWEEP_REQUEST))
+            check_mca_sweep_response = _read_response(14, timeout=120)
+            mca_sweep_content = check_mca_sweep_response.get("result")["structuredContent"]
+            ranked_cpus = {row.get("cpu") for row in mca_sweep_content.get("comparison", [])}
+            assert ranked_cpus == constants.EXPECTED_MCA_SWEEP_CPUS, "Test Failed: MCP mca_sweep tool failed: ranked targets mismatch. Expected: {}, Received: {}".format(sorted(constants.EXPECTED_MCA_SWEEP_CPUS), json.dumps(mca_sweep_content, indent=2))
+            assert all(row.get("bottleneck") for row in mca_sweep_content["comparison"]), "Test Failed: MCP mca_sweep tool failed: missing bottleneck. Received: {}".format(json.dumps(mca_sweep_content["comparison"], indent=2))
+            print("\n***Test Passed: MCP mca_sweep tool succeeded")
+
             #Check APX Recipe Run Tool Test
             apx_request = json.loads(json.dumps(constants.CHECK_APX_RECIPE_RUN_REQUEST))
             apx_args = apx_request["params"]["arguments"]
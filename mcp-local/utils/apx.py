@@ -1,11 +1,17 @@
+import base64
 import json
+import math
 import subprocess
 import os
 import re
 import shutil
+from collections import deque
+from dataclasses import dataclass, field
 from textwrap import dedent
 from pathlib import Path
-from typing import Any, Dict, List, Optional, Tuple
+from typing import Any, Dict, List, Optional, Tuple, Union
+
+from .cli_utils import OutputCallback, run_process
 
 
 QUERY_REGISTRY_PATH = Path(__file__).resolve().parent.parent / "sql" / "queries.sql"
@@ -18,18 +24,145 @@ SSH_KEY_PATH_RE = re.compile(r"(/[^\s:]+\.pem)\b")
 RUN_KEYS_DIR = Path("/run/keys")
 APX_RUNTIME_KEYS_DIR = Path("/tmp/apx-ssh")
 PROC_MOUNTS_PATH = Path("/proc/self/mounts")
+# Result rows returned per page unless a limit is given, and the largest page served.
+APX_RESULTS_PAGE_SIZE = 100
+APX_RESULTS_MAX_PAGE_SIZE = 5000
+# Functions allowed for server-side aggregation (group_by + aggregate).
+APX_AGGREGATE_FUNCTIONS = {"sum", "avg", "min", "max", "count"}
+RESULTS_CURSOR_VERSION = 1
+# Recipes collected by recipe="all", in the order they run.
+APX_RECIPES = ("code_hotspots", "instruction_mix", "cpu_microarchitecture", "memory_access")
+
+
+def resolve_recipes(recipe: Union[str, List[str]]) -> List[str]:
+    """Expand a recipe argument: "all" means every APX_RECIPES entry; lists and comma-separated names run several."""
+    names = recipe.split(",") if isinstance(recipe, str) else list(recipe)
+    resolved: List[str] = []
+    for name in names:
+        name = name.strip()
+        if not name:
+            continue
+        expanded = list(APX_RECIPES) if name.lower() == "all" else [name]
+        resolved.extend(r for r in expanded if r not in resolved)
+    return resolved or ["code_hotspots"]
+
+
+# Types a query parameter may declare, and how a value is coerced before it is rendered as SQL.
+QUERY_PARAM_TYPES = {"int": int, "float": float, "str": str, "bool": bool}
+QUERY_PARAM_RE = re.compile(r"^(?P<name>[A-Za-z_][A-Za-z0-9_]*)\s+(?P<type>\w+)(?:\s+(?P<default>\S+))?(?:\s+(?P<description>.+))?$")
+QUERY_USES_RE = re.compile(r"^(?P<key>[A-Za-z0-9_]+\.[A-Za-z0-9_]+)\s+AS\s+(?P<alias>[A-Za-z_][A-Za-z0-9_]*)$", re.IGNORECASE)
+
+
+@dataclass
+class QueryParam:
+    name: str
+    type: str
+    default: Any = None
+    description: str = ""
+
+    def coerce(self, value: Any) -> Any:
+        if value is None:
+            return None
+        if self.type == "bool" and isinstance(value, str):
+            if value.strip().lower() not in {"1", "0", "true", "false", "yes", "no", "on", "off"}:
+                raise ValueError(f"Parameter '{self.name}' expects a bool, got {value!r}.")
+            return value.strip().lower() in {"1", "true", "yes", "on"}
+        try:
+            coerced = QUERY_PARAM_TYPES[self.type](value)
+        except (TypeError, ValueError) as exc:
+            raise ValueError(f"Parameter '{self.name}' expects {self.type}, got {value!r}.") from exc
+        # nan and inf have no SQL literal; repr() would render them as bare identifiers.
+        if isinstance(coerced, float) and not math.isfinite(coerced):
+            raise ValueError(f"Parameter '{self.name}' expects a finite float, got {value!r}.")
+        return coerced
+
+
+@dataclass
+class RecipeQuery:
+    recipe: str
+    name: str
+    sql: str
+    description: str = ""
+    params: Dict[str, QueryParam] = field(default_factory=dict)
+    # (alias, "<recipe>.<query_name>") pairs prepended as CTEs when the query is built.
+    uses: List[Tuple[str, str]] = field(default_factory=list)
+    # Outer ORDER BY over the query's output columns that identifies each row, so pages are stable.
+    order: Optional[str] = None
+
+    def summary(self) -> Dict[str, Any]:
+        return {
+            "recipe": self.recipe,
+            "query": self.name,
+            "description": self.description,
+            "params": [
+                {"name": p.name, "type": p.type, "default": p.default, "description": p.description}
+                for p in self.params.values()
+            ],
+            "uses": [key for _, key in self.uses],
+            "order": self.order,
+        }
 
 
-def load_recipe_query_map(sql_file_path: Path) -> Dict[str, Dict[str, str]]:
-    recipe_query_map: Dict[str, Dict[str, str]] = {}
+def _quote_identifier(name: str) -> str:
+    if not name or not name.strip() or any(ch in name for ch in '";\0'):
+        raise ValueError(f"Invalid column name: {name!r}")
+    return f'"{name.strip()}"'
+
+
+def _order_terms(order_by: Optional[str]) -> List[str]:
+    """'col', 'col DESC', 'col asc', or '-col' (descending), comma-separated -> ORDER BY terms."""
+    terms: List[str] = []
+    for term in (order_by or "").split(","):
+        text = term.strip()
+        if not text:
+            continue
+        direction = "ASC"
+        if text.startswith("-"):
+            text, direction = text[1:], "DESC"
+        else:
+            match = re.fullmatch(r"(.+?)\s+(asc|desc)", text, re.IGNORECASE)
+            if match:
+                text, direction = match.group(1), match.group(2).upper()
+        terms.append(f"{_quote_identifier(text)} {direction}")
+    return terms
+
+
+def _order_clause(order_by: Optional[str]) -> str:
+    terms = _order_terms(order_by)
+    return f" ORDER BY {', '.join(terms)}" if terms else ""
+
+
+def _parse_query_param(block_key: str, spec: str) -> QueryParam:
+    match = QUERY_PARAM_RE.match(spec.strip())
+    if not match or match.group("type") not in QUERY_PARAM_TYPES:
+        raise ValueError(
+            f"Invalid parameter '{spec}' in SQL block '{block_key}'. "
+            f"Expected '-- param: <name> <{'|'.join(QUERY_PARAM_TYPES)}> [default|null] [description]'."
+        )
+    param = QueryParam(name=match.group("name"), type=match.group("type"), description=match.group("description") or "")
+    default = match.group("default")
+    param.default = None if default in (None, "null") else param.coerce(default)
+    return param
+
+
+def load_recipe_query_catalog(sql_file_path: Path) -> Dict[str, Dict[str, RecipeQuery]]:
+    """
+    Parse the named query catalog. Each block starts with '-- name: <recipe>.<query_name>' and
+    may declare '-- description:', typed '-- param: <name> <type> [default] [description]'
+    lines referenced in the SQL as :name, '-- uses: <recipe>.<query_name> AS <alias>' to
+    build on another named query as a CTE, and '-- order: <column> [ASC|DESC], ...' naming
+    output columns that order its rows uniquely; results pages are sorted on them.
+    """
+    catalog: Dict[str, Dict[str, RecipeQuery]] = {}
     if not sql_file_path.exists():
-        return recipe_query_map
+        return catalog
 
     content = sql_file_path.read_text(encoding="utf-8")
     current_key: Optional[str] = None
     current_lines: List[str] = []
+    current_meta: List[Tuple[str, str]] = []
 
-    def commit_block(block_key: Optional[str], block_lines: List[str]) -> None:
+    def commit_block(block_key: Optional[str], block_lines: List[str], block_meta: List[Tuple[str, str]]) -> None:
         if not block_key:
             return
 
@@ -50,24 +183,57 @@ def load_recipe_query_map(sql_file_path: Path) -> Dict[str, Dict[str, str]]:
                 f"Invalid SQL block name '{block_key}'. Recipe and query name must be non-empty."
             )
 
-        recipe_query_map.setdefault(recipe, {})[query_name] = sql_text
+        query = RecipeQuery(recipe=recipe, name=query_name, sql=sql_text)
+        for meta_key, meta_value in block_meta:
+            if meta_key == "description":
+                query.description = f"{query.description} {meta_value}".strip()
+            elif meta_key == "param":
+                param = _parse_query_param(block_key, meta_value)
+                query.params[param.name] = param
+            elif meta_key == "order":
+                _order_clause(meta_value)
+                query.order = meta_value
+            else:
+                uses_match = QUERY_USES_RE.match(meta_value)
+                if not uses_match:
+                    raise ValueError(
+                        f"Invalid '-- uses: {meta_value}' in SQL block '{block_key}'. "
+                        "Expected '-- uses: <recipe>.<query_name> AS <alias>'."
+                    )
+                query.uses.append((uses_match.group("alias"), uses_match.group("key")))
+        catalog.setdefault(recipe, {})[query_name] = query
 
     for line in content.splitlines():
         name_match = re.match(r"^\s*--\s*name\s*:\s*(.+?)\s*$", line)
         if name_match:
-            commit_block(current_key, current_lines)
+            commit_block(current_key, current_lines, current_meta)
             current_key = name_match.group(1).strip()
             current_lines = []
+            current_meta = []
+            continue
+
+        meta_match = re.match(r"^\s*--\s*(description|param|uses|order)\s*:\s*(.+?)\s*$", line)
+        if current_key and meta_match and not current_lines:
+            current_meta.append((meta_match.group(1), meta_match.group(2)))
             continue
 
         if current_key:
             current_lines.append(line)
 
-    commit_block(current_key, current_lines)
-    return recipe_query_map
+    commit_block(current_key, current_lines, current_meta)
+    return catalog
 
 
-RECIPE_QUERY_MAP = load_recipe_query_map(QUERY_REGISTRY_PATH)
+def _query_text_map(catalog: Dict[str, Dict[str, RecipeQuery]]) -> Dict[str, Dict[str, str]]:
+    return {recipe: {name: query.sql for name, query in queries.items()} for recipe, queries in catalog.items()}
+
+
+def load_recipe_query_map(sql_file_path: Path) -> Dict[str, Dict[str, str]]:
+    return _query_text_map(load_recipe_query_catalog(sql_file_path))
+
+
+RECIPE_QUERY_CATALOG = load_recipe_query_catalog(QUERY_REGISTRY_PATH)
+RECIPE_QUERY_MAP = _query_text_map(RECIPE_QUERY_CATALOG)
 
 
 def normalize_sql_query(query: str) -> str:
@@ -77,11 +243,105 @@ def normalize_sql_query(query: str) -> str:
     return normalized
 
 
-def build_recipe_query(recipe: str, default_table: str, query_name: str = "default") -> str:
-    recipe_query_set = RECIPE_QUERY_MAP.get(recipe, {})
+def list_recipe_queries(recipe: Optional[str] = None) -> List[Dict[str, Any]]:
+    """Summaries (description, typed parameters) of the named queries, optionally for one recipe."""
+    recipes = [recipe] if recipe else sorted(RECIPE_QUERY_CATALOG)
+    return [
+        query.summary()
+        for name in recipes
+        for query in RECIPE_QUERY_CATALOG.get(name, {}).values()
+    ]
+
+
+def _sql_literal(value: Any) -> str:
+    if value is None:
+        return "NULL"
+    if isinstance(value, bool):
+        return "TRUE" if value else "FALSE"
+    if isinstance(value, (int, float)):
+        return repr(value)
+    return "'" + str(value).replace("'", "''") + "'"
+
+
+def _bind_query_params(query: RecipeQuery, params: Optional[Dict[str, Any]]) -> str:
+    """
+    Render :name placeholders as SQL literals. apx render query takes only a SQL string,
+    so values are type-checked and quoted here instead of being bound by the database.
+    """
+    params = params or {}
+    values = {
+        name: spec.coerce(params[name]) if name in params else spec.default
+        for name, spec in query.params.items()
+    }
+    # '::' casts and names that are not declared parameters are left untouched.
+    return re.sub(
+        r"(?<![:\w]):([A-Za-z_][A-Za-z0-9_]*)\b",
+        lambda m: _sql_literal(values[m.group(1)]) if m.group(1) in values else m.group(0),
+        query.sql,
+    )
+
+
+def _compose_recipe_query(query: RecipeQuery, params: Optional[Dict[str, Any]], seen: Tuple[str, ...] = ()) -> str:
+    key = f"{query.recipe}.{query.name}"
+    if key in seen:
+        raise ValueError(f"Query '{key}' uses itself through {' -> '.join(seen)}.")
+    sql = _bind_query_params(query, params)
+    sql = sql.rstrip().rstrip(";").strip()
+    if not query.uses:
+        return sql
+
+    ctes: List[str] = []
+    for alias, used_key in query.uses:
+        used_recipe, used_name = used_key.split(".", 1)
+        used = RECIPE_QUERY_CATALOG.get(used_recipe, {}).get(used_name)
+        if used is None:
+            raise ValueError(f"Query '{key}' uses unknown query '{used_key}'.")
+        ctes.append(f"{alias} AS (\n{_compose_recipe_query(used, params, seen + (key,))}\n)")
+    with_match = re.match(r"^WITH\s+(RECURSIVE\s+)?", sql, re.IGNORECASE)
+    if with_match:
+        recursive = "RECURSIVE " if with_match.group(1) else ""
+        return f"WITH {recursive}{', '.join(ctes)},\n{sql[with_match.end():]}"
+    return f"WITH {', '.join(ctes)}\n{sql}"
+
+
+def recipe_query_order(recipe: str, query_name: str = "default") -> Optional[str]:
+    """The unique row order a catalog query declares with '-- order:', if any."""
+    query = RECIPE_QUERY_CATALOG.get(recipe, {}).get(query_name)
+    return query.order if query else None
+
+
+def build_recipe_query(
+    recipe: str,
+    default_table: str,
+    query_name: str = "default",
+    params: Optional[Dict[str, Any]] = None,
+) -> str:
+    recipe_query_set = RECIPE_QUERY_CATALOG.get(recipe, {})
     recipe_query = recipe_query_set.get(query_name)
     if recipe_query:
-        return normalize_sql_query(recipe_query)
+        # Parameters shared through '-- uses:' reach the used queries; any other name is an error.
+        declared = set(recipe_query.params)
+        pending = list(recipe_query.uses)
+        while pending:
+            used_recipe, used_name = pending.pop()[1].split(".", 1)
+            used = RECIPE_QUERY_CATALOG.get(used_recipe, {}).get(used_name)
+            if used is not None:
+                declared |= set(used.params)
+                pending.extend(used.uses)
+        unknown = sorted(set(params or {}) - declared)
+        if unknown:
+            raise ValueError(
+                f"Unknown parameter(s) {unknown} for query '{recipe}.{query_name}'. Supported: {sorted(declared)}."
+            )
+        return normalize_sql_query(_compose_recipe_query(recipe_query, params))
+
+    if query_name != "default":
+        raise ValueError(
+            f"Unknown query '{query_name}' for recipe '{recipe}'. "
+            f"Available: {sorted(recipe_query_set) or ['default']}."
+        )
+    if params:
+        raise ValueError(f"Recipe '{recipe}' has no named queries, so it takes no parameters.")
 
     if not re.fullmatch(r"[A-Za-z_][A-Za-z0-9_]*", default_table):
         raise ValueError(f"Invalid SQL table name for fallback query: {default_table}")
@@ -200,47 +460,49 @@ def _coerce_cell_value(value: str) -> Any:
     return text
 
 
-def parse_apx_query_table(output: str) -> Dict[str, Any]:
+class ApxTableParser:
     """
-    Parse an apx unicode table into structured columns/rows.
-    Returns best-effort results and warnings without raising.
+    Incremental parser for apx unicode result tables: feed() one output line at a time.
+    Keeps at most max_rows parsed rows (counting the rest), plus a short tail of raw lines
+    for diagnostics when no table is found.
     """
-    cleaned = _sanitize_apx_output(output)
-    lines = cleaned.splitlines()
-    table_rows: List[List[str]] = []
 
-    for line in lines:
-        stripped = line.strip()
+    def __init__(self, max_rows: Optional[int] = None, raw_tail_lines: int = 200):
+        self.max_rows = max_rows
+        self.columns: List[str] = []
+        self.rows: List[Dict[str, Any]] = []
+        self.warnings: List[str] = []
+        self.total_rows = 0
+        self.raw_tail: deque = deque(maxlen=raw_tail_lines)
+        self._have_header = False
+
+    def feed(self, line: str) -> None:
+        cleaned = _sanitize_apx_output(line)
+        self.raw_tail.append(cleaned)
+        stripped = cleaned.strip()
         if not (stripped.startswith("┃") and stripped.endswith("┃")):
-            continue
+            return
 
         inner = stripped[1:-1]
         cells = [cell.strip() for cell in inner.split("┃")]
         if len(cells) < 2:
             # Skip single-cell rows from the rendered query preview block.
-            continue
+            return
         if all(cell == "" for cell in cells):
-            continue
-        table_rows.append(cells)
-
-    if not table_rows:
-        return {
-            "columns": [],
-            "rows": [],
-            "warnings": ["No result table detected in apx query output."],
-        }
+            return
 
-    raw_headers = table_rows[0]
-    columns, header_warnings = _dedupe_headers(raw_headers)
-    expected_columns = len(columns)
-    warnings: List[str] = list(header_warnings)
-    parsed_rows: List[Dict[str, Any]] = []
+        if not self._have_header:
+            self._have_header = True
+            self.columns, header_warnings = _dedupe_headers(cells)
+            self.warnings.extend(header_warnings)
+            return
 
-    for row_idx, cells in enumerate(table_rows[1:], start=1):
+        self.total_rows += 1
+        expected_columns = len(self.columns)
         adjusted_cells = list(cells)
         if len(adjusted_cells) != expected_columns:
-            warnings.append(
-                f"Row {row_idx} has {len(adjusted_cells)} cells; expected {expected_columns}. "
+            self.warnings.append(
+                f"Row {self.total_rows} has {len(adjusted_cells)} cells; expected {expected_columns}. "
                 "Adjusted row length to match headers."
             )
             if len(adjusted_cells) < expected_columns:
@@ -248,16 +510,105 @@ def parse_apx_query_table(output: str) -> Dict[str, Any]:
             else:
                 adjusted_cells = adjusted_cells[:expected_columns]
 
-        row_obj: Dict[str, Any] = {}
-        for col_name, raw_value in zip(columns, adjusted_cells):
-            row_obj[col_name] = _coerce_cell_value(raw_value)
-        parsed_rows.append(row_obj)
+        if self.max_rows is not None and len(self.rows) >= self.max_rows:
+            return
+        self.rows.append(
+            {col_name: _coerce_cell_value(raw_value) for col_name, raw_value in zip(self.columns, adjusted_cells)}
+        )
 
-    return {
-        "columns": columns,
-        "rows": parsed_rows,
-        "warnings": warnings,
-    }
+    def result(self) -> Dict[str, Any]:
+        if not self._have_header:
+            return {
+                "columns": [],
+                "rows": [],
+                "warnings": ["No result table detected in apx query output."],
+            }
+        return {
+            "columns": self.columns,
+            "rows": self.rows,
+            "warnings": self.warnings,
+        }
+
+
+def parse_apx_query_table(output: str) -> Dict[str, Any]:
+    """
+    Parse an apx unicode table into structured columns/rows.
+    Returns best-effort results and warnings without raising.
+    """
+    parser = ApxTableParser()
+    for line in (output or "").splitlines():
+        parser.feed(line)
+    return parser.result()
+
+
+def build_paged_query(
+    query: str,
+    offset: int = 0,
+    limit: int = APX_RESULTS_PAGE_SIZE,
+    order_by: Optional[str] = None,
+    group_by: Optional[str] = None,
+    aggregate: Optional[str] = None,
+    aggregate_function: str = "sum",
+    tiebreak_columns: int = 0,
+) -> str:
+    """
+    Wrap a recipe query so the render database sorts, aggregates, and pages the rows.
+
+    One row beyond the page is requested so the caller can tell whether another page follows.
+    With group_by, rows are grouped on that column with a row_count and, when aggregate names
+    a column, <function>_<column>; groups are ordered by that value (or row_count) descending
+    unless order_by is given, and then by the group column.
+
+    The inner query's own ORDER BY does not carry over to the outer SELECT, so consecutive
+    pages only line up when this ORDER BY identifies every row. Pass tiebreak_columns (the
+    number of columns the query returns) to finish the order with all of them by position;
+    grouped pages are already unique on the group column.
+    """
+    if offset < 0 or limit < 1:
+        raise ValueError("offset must be >= 0 and limit must be >= 1.")
+    inner = normalize_sql_query(query).rstrip(";").strip()
+    select, group_clause, default_order = "*", "", ""
+    if group_by:
+        function = aggregate_function.lower()
+        if function not in APX_AGGREGATE_FUNCTIONS:
+            raise ValueError(f"Unsupported aggregate function '{aggregate_function}'. Use one of {sorted(APX_AGGREGATE_FUNCTIONS)}.")
+        group_column = _quote_identifier(group_by)
+        select = f"{group_column}, COUNT(*) AS row_count"
+        default_order = " ORDER BY row_count DESC"
+        if aggregate:
+            alias = _quote_identifier(f"{function}_{aggregate.strip()}")
+            select += f", {function.upper()}({_quote_identifier(aggregate)}) AS {alias}"
+            default_order = f" ORDER BY {alias} DESC"
+        group_clause = f" GROUP BY {group_column}"
+    elif aggregate:
+        raise ValueError("aggregate requires group_by.")
+    order_clause = _order_clause(order_by) or default_order
+    if group_by:
+        order_clause += f", {group_column}"
+    elif tiebreak_columns > 0:
+        positions = ", ".join(str(position) for position in range(1, tiebreak_columns + 1))
+        order_clause = f"{order_clause}, {positions}" if order_clause else f" ORDER BY {positions}"
+    # The source query goes on its own lines so a trailing '--' comment cannot swallow the ')'.
+    return (
+        f"SELECT {select} FROM (\n{inner}\n) AS page_source"
+        f"{group_clause}{order_clause} LIMIT {limit + 1} OFFSET {offset};"
+    )
+
+
+def encode_results_cursor(state: Dict[str, Any]) -> str:
+    payload = json.dumps({"v": RESULTS_CURSOR_VERSION, **state}, separators=(",", ":"))
+    return base64.urlsafe_b64encode(payload.encode("utf-8")).decode("ascii").rstrip("=")
+
+
+def decode_results_cursor(cursor: str) -> Dict[str, Any]:
+    try:
+        padded = cursor + "=" * (-len(cursor) % 4)
+        state = json.loads(base64.urlsafe_b64decode(padded.encode("ascii")))
+    except Exception as exc:
+        raise ValueError(f"Invalid results cursor: {exc}") from exc
+    if not isinstance(state, dict) or state.pop("v", None) != RESULTS_CURSOR_VERSION:
+        raise ValueError("Invalid results cursor: unsupported version.")
+    return state
 
 
 def _build_atp_error_response(
@@ -546,15 +897,15 @@ def extract_run_id(output: str) -> str:
             continue
     return ""
 
-def run_command(command: list, cwd: str, parse_output=None) -> tuple:
+async def run_command(command: list, cwd: str, parse_output=None, on_output: Optional[OutputCallback] = None) -> tuple:
     """
-    Run a shell command as a child process and wait for it to finish.
-    Optionally parse the output using a provided function.
+    Run a shell command as a child process and wait for it to finish without blocking the event loop.
+    Optionally parse the output using a provided function, and stream lines to on_output.
     Returns (returncode, parsed_output or combined stdout/stderr).
     """
     try:
         #print(command)
-        result = subprocess.run(command, cwd=cwd, timeout=60*60*3, capture_output=True, text=True)
+        result = await run_process(command, cwd=cwd, timeout=60*60*3, on_output=on_output)
     except subprocess.TimeoutExpired as e:
         return -1, _redact_sensitive_text(str(e))
     stdout = result.stdout or ""
@@ -572,7 +923,7 @@ def read_file_contents(file_path: str) -> str:
     with open(file_path, 'r', encoding='utf-8') as f:
         return f.read()
 
-def prepare_target(remote_ip_addr: str, remote_usr: str, ssh_key_path: str, apx_dir:str) -> dict:
+async def prepare_target(remote_ip_addr: str, remote_usr: str, ssh_key_path: str, apx_dir:str) -> dict:
     """Prepare the target machine for running workloads. 
         Returns the target ID."""
 
@@ -611,7 +962,7 @@ def prepare_target(remote_ip_addr: str, remote_usr: str, ssh_key_path: str, apx_
 
     # Check if target already exists
     list_command = ["./apx", "target", "list", "--json"]
-    status, list_output = run_command(list_command, cwd=apx_dir)
+    status, list_output = await run_command(list_command, cwd=apx_dir)
     _record_debug(list_command, status, list_output)
     if status == 0 and list_output:
         targets = _extract_targets(list_output)
@@ -643,7 +994,7 @@ def prepare_target(remote_ip_addr: str, remote_usr: str, ssh_key_path: str, apx_
             f"{remote_usr}@{remote_ip_addr}:22:{ssh_key_path}",
             "--name", generated_name
         ]
-    add_status, add_output = run_command(add_command, cwd=apx_dir)
+    add_status, add_output = await run_command(add_command, cwd=apx_dir)
     _record_debug(add_command, add_status, add_output)
     
     # Check for SSH key permission errors
@@ -668,7 +1019,7 @@ def prepare_target(remote_ip_addr: str, remote_usr: str, ssh_key_path: str, apx_
         "target", "prepare",
         "--target", f"{generated_name}"
     ]
-    status, target_id = run_command(command, cwd=apx_dir)
+    status, target_id = await run_command(command, cwd=apx_dir)
     _record_debug(command, status, target_id)
     if status != 0 or not target_id:
         return {
@@ -681,10 +1032,11 @@ def prepare_target(remote_ip_addr: str, remote_usr: str, ssh_key_path: str, apx_
         "debug_trace": debug_trace,
     }
 
-def run_workload(cmd:str, target: str, recipe:str, apx_dir:str) -> dict:
+async def run_workload(cmd:str, target: str, recipe:str, apx_dir:str, on_output: Optional[OutputCallback] = None, check_ready: bool = True) -> dict:
     """Run a sample workload on the target machine. Some example queries: 
         - 'Help my analyze my code's performance'.
         - 'Find the CPU hotspots in my application'.
+        Pass check_ready=False to skip 'apx recipe ready' for a recipe already run on this target.
         Returns the run ID of the workload execution."""
 
     debug_trace: List[Dict[str, Any]] = []
@@ -698,32 +1050,37 @@ def run_workload(cmd:str, target: str, recipe:str, apx_dir:str) -> dict:
             }
         )
 
+    # Tools are deployed only when the readiness check says they are missing. A skipped check means
+    # the recipe already ran on this prepared target, so its tools are in place.
+    deploy_tools = False
     # Check if the recipe is ready to run on the target
-    ready_command = ["./apx", "recipe", "ready", recipe, "--target", target]
-    ready_status, ready_output = run_command(ready_command, cwd=apx_dir)
-    _record_debug(ready_command, ready_status, ready_output)
-
-    ready_output_text = (ready_output or "").lower()
-    has_deploy_tools_hint = (
-        "--deploy-tools" in ready_output_text
-        and "to deploy this tool on the target" in ready_output_text
-    )
-    has_missing_agent_hint = (
-        "recipe is not ready to be run on your target machine" in ready_output_text
-        and "agent server" in ready_output_text
-        and "run `target prepare`" in ready_output_text
-    )
-    is_expected_predeploy_state = has_deploy_tools_hint or has_missing_agent_hint
+    if check_ready:
+        ready_command = ["./apx", "recipe", "ready", recipe, "--target", target]
+        ready_status, ready_output = await run_command(ready_command, cwd=apx_dir)
+        _record_debug(ready_command, ready_status, ready_output)
+
+        ready_output_text = (ready_output or "").lower()
+        has_deploy_tools_hint = (
+            "--deploy-tools" in ready_output_text
+            and "to deploy this tool on the target" in ready_output_text
+        )
+        has_missing_agent_hint = (
+            "recipe is not ready to be run on your target machine" in ready_output_text
+            and "agent server" in ready_output_text
+            and "run `target prepare`" in ready_output_text
+        )
+        is_expected_predeploy_state = has_deploy_tools_hint or has_missing_agent_hint
     
-    # If readiness failed for reasons other than missing deployed tools, return early.
-    # Missing tool deployment is expected because recipe run uses --deploy-tools.
-    if (ready_status != 0 or (ready_output and ready_output.strip())) and not is_expected_predeploy_state:
-        return {
-            "error": "The recipe is not ready to run on the target machine.",
-            "details": _redact_sensitive_text(ready_output) if ready_output else "Recipe readiness check failed.",
-            "suggestion": "You may need to run 'target prepare' or use '--deploy-tools' flag.",
-            "debug_trace": debug_trace,
-        }
+        # If readiness failed for reasons other than missing deployed tools, return early.
+        # Missing tool deployment is expected because recipe run uses --deploy-tools.
+        if (ready_status != 0 or (ready_output and ready_output.strip())) and not is_expected_predeploy_state:
+            return {
+                "error": "The recipe is not ready to run on the target machine.",
+                "details": _redact_sensitive_text(ready_output) if ready_output else "Recipe readiness check failed.",
+                "suggestion": "You may need to run 'target prepare' or use '--deploy-tools' flag.",
+                "debug_trace": debug_trace,
+            }
+        deploy_tools = is_expected_predeploy_state
     
     command = [
         "./apx",
@@ -731,9 +1088,24 @@ def run_workload(cmd:str, target: str, recipe:str, apx_dir:str) -> dict:
         f"--workload={cmd}",
         "--json",
         f"--target={target}",
-        "--deploy-tools", "--param", "collect_java_stacks=true"
+        *(["--deploy-tools"] if deploy_tools else []),
+        "--param", "collect_java_stacks=true",
     ]
-    status, output = run_command(command, cwd=apx_dir)
+    # Streamed lines are redacted one at a time, so private key blocks spanning lines are dropped whole.
+    in_key_block = False
+
+    async def _redacted_output(stream: str, line: str) -> None:
+        nonlocal in_key_block
+        if "-----BEGIN" in line and "PRIVATE KEY-----" in line:
+            in_key_block = True
+        if in_key_block:
+            if "-----END" in line:
+                in_key_block = False
+                await on_output(stream, "[REDACTED_PRIVATE_KEY]")
+            return
+        await on_output(stream, _redact_sensitive_text(_sanitize_apx_output(line)))
+
+    status, output = await run_command(command, cwd=apx_dir, on_output=_redacted_output if on_output else None)
     _record_debug(command, status, output)
     output_text = output or ""
     run_id = extract_run_id(output_text) if status == 0 else ""
@@ -748,42 +1120,17 @@ def run_workload(cmd:str, target: str, recipe:str, apx_dir:str) -> dict:
         "debug_trace": debug_trace,
     }
 
-def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "drilldown") -> Dict[str, Any]:
-    """Get results from the target machine after running a workload. 
-        Returns a structured response with SQL query, table columns/rows, and warnings/errors."""
-
-    if not run_id or "value" not in run_id:
-        return _build_atp_error_response(
-            recipe=recipe,
-            stage="input_validation",
-            message="Missing or invalid run_id payload.",
-            suggestion="Re-run the workload and retry this recipe query.",
-            details=f"Expected run_id with a 'value' key, received: {run_id}",
-        )
-
-    try:
-        query = build_recipe_query(recipe, default_table)
-    except ValueError as e:
-        return _build_atp_error_response(
-            recipe=recipe,
-            stage="query_build",
-            message="Failed to build a query for this recipe.",
-            suggestion="Use a supported recipe query name or validate SQL table names in the fallback query.",
-            details=str(e),
-        )
-
-    # Startup the local db for querying results
-    render_cmd = ["./apx", "run", "render", run_id["value"]]
+async def _render_session(run_id_value: str, recipe: str, apx_dir: str, query: str) -> Tuple[Optional[str], Optional[Dict[str, Any]]]:
+    """Start the local render database for a run; returns (session_id, None) or (None, error response)."""
+    render_cmd = ["./apx", "run", "render", run_id_value]
     try:
-        render_proc = subprocess.run(
+        render_proc = await run_process(
             render_cmd,
             cwd=apx_dir,
             timeout=60 * 5,
-            capture_output=True,
-            text=True,
         )
     except subprocess.TimeoutExpired:
-        return _build_atp_error_response(
+        return None, _build_atp_error_response(
             recipe=recipe,
             stage="render",
             message="Timed out while rendering run data.",
@@ -791,7 +1138,7 @@ def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "d
             query=query,
         )
     except Exception as e:
-        return _build_atp_error_response(
+        return None, _build_atp_error_response(
             recipe=recipe,
             stage="render",
             message="Failed to render run data.",
@@ -803,7 +1150,7 @@ def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "d
     render_stdout = render_proc.stdout or ""
     render_stderr = render_proc.stderr or ""
     if render_proc.returncode != 0:
-        return _build_atp_error_response(
+        return None, _build_atp_error_response(
             recipe=recipe,
             stage="render",
             message="apx run render command failed.",
@@ -815,7 +1162,7 @@ def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "d
 
     session_id, session_error = _extract_session_id(render_stdout)
     if not session_id:
-        return _build_atp_error_response(
+        return None, _build_atp_error_response(
             recipe=recipe,
             stage="render_parse",
             message="Could not extract session ID from render output.",
@@ -824,15 +1171,110 @@ def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "d
             query=query,
             raw_output=render_stdout,
         )
+    return session_id, None
+
+
+async def _stream_query(session_id: str, query: str, apx_dir: str, max_rows: int) -> Tuple[subprocess.CompletedProcess, ApxTableParser]:
+    """Run a render query, parsing rows as apx prints them instead of buffering its stdout."""
+    parser = ApxTableParser(max_rows=max_rows)
+
+    async def on_line(stream: str, line: str) -> None:
+        if stream == "stdout":
+            parser.feed(line)
 
     query_cmd = ["./apx", "render", "query", session_id, query]
+    proc = await run_process(query_cmd, cwd=apx_dir, on_output=on_line, keep_stdout=False)
+    return proc, parser
+
+
+async def get_results(
+    run_id: dict,
+    recipe: str,
+    apx_dir: str,
+    default_table: str = "drilldown",
+    offset: int = 0,
+    limit: int = APX_RESULTS_PAGE_SIZE,
+    order_by: Optional[str] = None,
+    group_by: Optional[str] = None,
+    aggregate: Optional[str] = None,
+    aggregate_function: str = "sum",
+    session_id: Optional[str] = None,
+    query_name: str = "default",
+    params: Optional[Dict[str, Any]] = None,
+    tiebreak_columns: int = 0,
+) -> Dict[str, Any]:
+    """Get results from the target machine after running a workload. 
+        Returns a structured response with SQL query, table columns/rows, and warnings/errors.
+
+        Rows are paged in the render database (offset/limit/order_by, or grouped with
+        group_by/aggregate) and parsed as they stream from apx. When more rows follow, the
+        response carries a next_cursor for apx_query_results. A session_id from an earlier
+        page skips re-rendering; if that session has gone away the run is rendered again.
+        query_name and params select a named query from the catalog in sql/queries.sql.
+
+        Pages are sorted by order_by, then by the query's declared '-- order:'. A query that
+        declares none is finished with all of its columns (tiebreak_columns, learned from the
+        first page and kept in the cursor), so pages never skip or repeat rows."""
+
+    if not run_id or "value" not in run_id:
+        return _build_atp_error_response(
+            recipe=recipe,
+            stage="input_validation",
+            message="Missing or invalid run_id payload.",
+            suggestion="Re-run the workload and retry this recipe query.",
+            details=f"Expected run_id with a 'value' key, received: {run_id}",
+        )
+
+    limit = max(1, min(int(limit or APX_RESULTS_PAGE_SIZE), APX_RESULTS_MAX_PAGE_SIZE))
+    offset = max(0, int(offset or 0))
+    # A grouped page has its own columns, so a declared order (over the query's columns) only applies ungrouped.
+    declared_order = None if group_by else recipe_query_order(recipe, query_name)
+    page_order = ", ".join(part for part in (order_by, declared_order) if part and part.strip()) or None
+    # Without a declared unique order the rows are only stable once every column is sorted on.
+    needs_tiebreak = not group_by and not declared_order
+    if not needs_tiebreak:
+        tiebreak_columns = 0
     try:
-        query_proc = subprocess.run(
-            query_cmd,
-            cwd=apx_dir,
-            capture_output=True,
-            text=True,
+        base_query = build_recipe_query(recipe, default_table, query_name, params)
+        query = build_paged_query(
+            base_query, offset, limit, page_order, group_by, aggregate, aggregate_function, tiebreak_columns
+        )
+    except ValueError as e:
+        return _build_atp_error_response(
+            recipe=recipe,
+            stage="query_build",
+            message="Failed to build a query for this recipe.",
+            suggestion="Use a query name and parameters listed by apx_query_catalog, valid column names for order_by/group_by/aggregate, or validate SQL table names in the fallback query.",
+            details=str(e),
         )
+
+    # Startup the local db for querying results, unless an earlier page left one running
+    reused_session = bool(session_id)
+    if not session_id:
+        session_id, render_error = await _render_session(run_id["value"], recipe, apx_dir, query)
+        if render_error:
+            return render_error
+
+    try:
+        query_proc, parser = await _stream_query(session_id, query, apx_dir, limit)
+        if query_proc.returncode != 0 and reused_session:
+            session_id, render_error = await _render_session(run_id["value"], recipe, apx_dir, query)
+            if render_error:
+                return render_error
+            query_proc, parser = await _stream_query(session_id, query, apx_dir, limit)
+        if (
+            query_proc.returncode == 0
+            and needs_tiebreak
+            and not tiebreak_columns
+            and parser.columns
+            and (offset or parser.total_rows > limit)
+        ):
+            # More than one page: sort again on every column, so this page and the next agree.
+            tiebreak_columns = len(parser.columns)
+            query = build_paged_query(
+                base_query, offset, limit, page_order, group_by, aggregate, aggregate_function, tiebreak_columns
+            )
+            query_proc, parser = await _stream_query(session_id, query, apx_dir, limit)
     except subprocess.TimeoutExpired:
         return _build_atp_error_response(
             recipe=recipe,
@@ -851,18 +1293,19 @@ def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "d
             query=query,
         )
 
+    raw_tail = "\n".join(parser.raw_tail)
     if query_proc.returncode != 0:
         return _build_atp_error_response(
             recipe=recipe,
             stage="query",
             message="apx render query command failed.",
             suggestion="Check the generated SQL query and session state, then retry.",
-            details=(query_proc.stderr or query_proc.stdout),
+            details=(query_proc.stderr or raw_tail),
             query=query,
-            raw_output=query_proc.stdout,
+            raw_output=raw_tail,
         )
 
-    parsed = parse_apx_query_table(query_proc.stdout or "")
+    parsed = parser.result()
     columns = parsed.get("columns", [])
     rows = parsed.get("rows", [])
     warnings = parsed.get("warnings", [])
@@ -871,17 +1314,43 @@ def get_results(run_id: dict, recipe: str, apx_dir: str, default_table: str = "d
         warnings.append(
             "Query command succeeded but table parsing found no structured columns. Raw output is included."
         )
+    # build_paged_query asks for one extra row to detect the next page.
+    has_more = parser.total_rows > limit
+    next_cursor = None
+    if has_more:
+        next_cursor = encode_results_cursor({
+            "run_id": run_id["value"],
+            "recipe": recipe,
+            "query_name": query_name,
+            "params": params or {},
+            "session_id": session_id,
+            "offset": offset + limit,
+            "limit": limit,
+            "order_by": order_by,
+            "group_by": group_by,
+            "aggregate": aggregate,
+            "aggregate_function": aggregate_function,
+            "tiebreak_columns": tiebreak_columns,
+        })
 
     return {
         "status": status,
         "recipe": recipe,
         "stage": "complete",
+        "run_id": run_id["value"],
+        "query_name": query_name,
+        "params": params or {},
         "query": query,
         "session_id": session_id,
         "columns": columns,
         "rows": rows,
         "row_count": len(rows),
+        "offset": offset,
+        "limit": limit,
+        "has_more": has_more,
+        "next_cursor": next_cursor,
         "warnings": warnings,
-        "raw_output": _trim_output(query_proc.stdout or ""),
+        # Parsed rows already carry the table; raw output is only kept to diagnose unparsed output.
+        "raw_output": "" if columns else _trim_output(raw_tail),
         "stderr": _trim_output(query_proc.stderr or ""),
     }
@@ -0,0 +1,295 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Differential comparison of two APX runs of the same recipe.
+
+Both runs are queried with the same named query. Rows are aligned on the recipe's key
+columns after normalizing symbol names, and every numeric column present in both runs gets
+an absolute and a relative delta. Percentage columns are compared in percentage points, since
+raw sample counts depend on run length and sampling rate and are not comparable across
+machines. A row whose primary metric moved past the thresholds in the worse direction is a
+regression; in the better direction it is an improvement.
+
+Both runs are read ordered by the primary metric, descending, so when a run has more rows
+than one page the compared page holds its hottest rows. A row seen in only one run is then
+reported as only_a/only_b only if its value would have put it inside the other run's page;
+otherwise its absence says nothing and it is counted as outside_window instead.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import re
+from dataclasses import dataclass
+from typing import Any, Dict, List, Optional, Tuple
+
+from .apx import APX_RESULTS_MAX_PAGE_SIZE, get_results
+
+
+@dataclass(frozen=True)
+class ComparisonSpec:
+    query_name: str
+    key_columns: Tuple[str, ...]
+    # Column that decides regressions, and whether a larger value is worse.
+    primary_metric: Optional[str]
+    higher_is_worse: bool = True
+
+
+COMPARISON_SPECS: Dict[str, ComparisonSpec] = {
+    "code_hotspots": ComparisonSpec(
+        query_name="function_samples",
+        key_columns=("function_name", "node_type"),
+        primary_metric="periodic_samples_self_percent",
+    ),
+    "cpu_microarchitecture": ComparisonSpec(
+        query_name="default",
+        key_columns=("metric", "units"),
+        primary_metric="value",
+    ),
+}
+# Columns tried as row keys for recipes without a spec, in order.
+FALLBACK_KEY_COLUMNS = ("function_name", "symbol", "name", "metric", "instruction", "type")
+
+# Compiler clones and linker stubs that name the same source function differently per build.
+SYMBOL_SUFFIX_RE = re.compile(r"(\.(constprop|isra|part|cold|lto_priv|llvm)(\.\d+)*|@plt|@@?[A-Za-z0-9_.]+)+$")
+# Metric names where a larger value is better; any other metric is treated as a cost.
+HIGHER_IS_BETTER_METRIC_RE = re.compile(r"\b(IPC|retiring|instructions per cycle|utili[sz]ation|hit rate)\b", re.IGNORECASE)
+
+
+def normalize_symbol(name: Any) -> Any:
+    if not isinstance(name, str):
+        return name
+    return SYMBOL_SUFFIX_RE.sub("", re.sub(r"\s+", " ", name.strip()))
+
+
+def _is_number(value: Any) -> bool:
+    return isinstance(value, (int, float)) and not isinstance(value, bool)
+
+
+def _row_key(row: Dict[str, Any], key_columns: Tuple[str, ...]) -> Tuple[Any, ...]:
+    return tuple(normalize_symbol(row.get(column)) for column in key_columns)
+
+
+def _aligned_rows(rows: List[Dict[str, Any]], key_columns: Tuple[str, ...]) -> Dict[Tuple[Any, ...], Dict[str, Any]]:
+    """Index rows by key; rows that normalize to the same key (clones of one function) are summed."""
+    aligned: Dict[Tuple[Any, ...], Dict[str, Any]] = {}
+    for row in rows:
+        key = _row_key(row, key_columns)
+        merged = aligned.get(key)
+        if merged is None:
+            aligned[key] = dict(row)
+            continue
+        for column, value in row.items():
+            if column not in key_columns and _is_number(value) and _is_number(merged.get(column)):
+                merged[column] += value
+    return aligned
+
+
+def _delta(a: Any, b: Any) -> Dict[str, Any]:
+    a = a if _is_number(a) else 0
+    b = b if _is_number(b) else 0
+    delta = b - a
+    return {
+        "a": a,
+        "b": b,
+        "delta": round(delta, 6),
+        "relative_percent": round(delta / a * 100, 3) if a else None,
+    }
+
+
+def _classify(
+    primary: Dict[str, Any],
+    higher_is_worse: bool,
+    is_percent: bool,
+    threshold: float,
+    relative_threshold_percent: float,
+) -> str:
+    delta = primary["delta"]
+    relative = primary["relative_percent"]
+    # Percent metrics move by percentage points; other metrics by a relative change.
+    if is_percent:
+        moved = abs(delta) >= threshold
+    else:
+        moved = (relative is None and delta != 0) or (relative is not None and abs(relative) >= relative_threshold_percent)
+    if not moved:
+        return "unchanged"
+    return "regression" if (delta > 0) == higher_is_worse else "improvement"
+
+
+def compare_result_rows(
+    rows_a: List[Dict[str, Any]],
+    rows_b: List[Dict[str, Any]],
+    spec: ComparisonSpec,
+    threshold: float = 1.0,
+    relative_threshold_percent: float = 10.0,
+    top_n: int = 50,
+    cutoff_a: Optional[float] = None,
+    cutoff_b: Optional[float] = None,
+) -> Dict[str, Any]:
+    """Align two result tables and report per-row deltas, regressions, and improvements.
+
+    cutoff_a/cutoff_b are the smallest primary metric value on a run's page when the run was
+    truncated to that page (None when it was read in full).
+    """
+    aligned_a = _aligned_rows(rows_a, spec.key_columns)
+    aligned_b = _aligned_rows(rows_b, spec.key_columns)
+    columns = [
+        column
+        for column in dict.fromkeys(c for row in rows_a + rows_b for c in row)
+        if column not in spec.key_columns
+        and any(_is_number(r.get(column)) for r in aligned_a.values())
+        and any(_is_number(r.get(column)) for r in aligned_b.values())
+    ]
+    primary_metric = spec.primary_metric if spec.primary_metric in columns else (columns[0] if columns else None)
+
+    compared: List[Dict[str, Any]] = []
+    outside_window = 0
+    for key in dict.fromkeys(list(aligned_a) + list(aligned_b)):
+        row_a, row_b = aligned_a.get(key), aligned_b.get(key)
+        if primary_metric and not (row_a and row_b):
+            # Present on one page only: absent from the other run, or just below its page.
+            value = (row_a or row_b).get(primary_metric)
+            other_cutoff = cutoff_b if row_a else cutoff_a
+            if other_cutoff is not None and (not _is_number(value) or value <= other_cutoff):
+                outside_window += 1
+                continue
+        entry: Dict[str, Any] = dict(zip(spec.key_columns, key))
+        entry["presence"] = "both" if row_a and row_b else ("only_a" if row_a else "only_b")
+        entry["metrics"] = {column: _delta((row_a or {}).get(column), (row_b or {}).get(column)) for column in columns}
+        if primary_metric:
+            higher_is_worse = spec.higher_is_worse
+            label = " ".join(str(part) for part in key if part is not None)
+            if spec.key_columns[0] == "metric" and HIGHER_IS_BETTER_METRIC_RE.search(label):
+                higher_is_worse = False
+            entry["change"] = _classify(
+                entry["metrics"][primary_metric],
+                higher_is_worse,
+                primary_metric.endswith("percent"),
+                threshold,
+                relative_threshold_percent,
+            )
+        compared.append(entry)
+
+    compared.sort(key=lambda e: abs(e["metrics"][primary_metric]["delta"]) if primary_metric else 0, reverse=True)
+    regressions = [e for e in compared if e.get("change") == "regression"]
+    improvements = [e for e in compared if e.get("change") == "improvement"]
+    return {
+        "key_columns": list(spec.key_columns),
+        "metrics": columns,
+        "primary_metric": primary_metric,
+        "thresholds": {
+            "percentage_points": threshold,
+            "relative_percent": relative_threshold_percent,
+        },
+        "summary": {
+            "rows_a": len(aligned_a),
+            "rows_b": len(aligned_b),
+            "matched": sum(1 for e in compared if e["presence"] == "both"),
+            "only_in_a": sum(1 for e in compared if e["presence"] == "only_a"),
+            "only_in_b": sum(1 for e in compared if e["presence"] == "only_b"),
+            "outside_window": outside_window,
+            "regressions": len(regressions),
+            "improvements": len(improvements),
+        },
+        "regressions": regressions[:top_n],
+        "improvements": improvements[:top_n],
+        "rows": compared[:top_n],
+        "truncated": len(compared) > top_n,
+    }
+
+
+def _page_cutoff(rows: List[Dict[str, Any]], metric: Optional[str]) -> Optional[float]:
+    """Smallest value of metric on a truncated page: rows of the run below it were not read."""
+    values = [row.get(metric) for row in rows if _is_number(row.get(metric))]
+    return min(values) if values else None
+
+
+def comparison_spec(recipe: str, rows: List[Dict[str, Any]]) -> ComparisonSpec:
+    spec = COMPARISON_SPECS.get(recipe)
+    if spec is not None:
+        return spec
+    present = set(rows[0]) if rows else set()
+    key = next((column for column in FALLBACK_KEY_COLUMNS if column in present), None)
+    if key is None:
+        # Without a recognizable key, align on every non-numeric column.
+        key_columns = tuple(c for c in (rows[0] if rows else {}) if not _is_number(rows[0][c]))
+    else:
+        key_columns = (key,)
+    return ComparisonSpec(query_name="default", key_columns=key_columns, primary_metric=None)
+
+
+async def compare_runs(
+    run_a: str,
+    run_b: str,
+    recipe: str,
+    apx_dir: str,
+    threshold: float = 1.0,
+    relative_threshold_percent: float = 10.0,
+    top_n: int = 50,
+) -> Dict[str, Any]:
+    """Query both runs concurrently and compare them; run_a is the baseline, run_b the candidate."""
+    known_spec = COMPARISON_SPECS.get(recipe)
+    query_name = known_spec.query_name if known_spec else "default"
+    # Hottest rows first, so a truncated page keeps the rows that matter on both sides.
+    order_by = f"{known_spec.primary_metric} DESC" if known_spec and known_spec.primary_metric else None
+    result_a, result_b = await asyncio.gather(
+        get_results(
+            {"value": run_a}, recipe, apx_dir, limit=APX_RESULTS_MAX_PAGE_SIZE, order_by=order_by, query_name=query_name
+        ),
+        get_results(
+            {"value": run_b}, recipe, apx_dir, limit=APX_RESULTS_MAX_PAGE_SIZE, order_by=order_by, query_name=query_name
+        ),
+    )
+    for label, result in (("run_a", result_a), ("run_b", result_b)):
+        if result.get("status") == "error" or not result.get("columns"):
+            return {
+                "status": "error",
+                "recipe": recipe,
+                "stage": f"{label}_results",
+                "message": f"Could not read results for {label}; both runs must have results for this recipe.",
+                "run_a": run_a,
+                "run_b": run_b,
+                "details": result,
+            }
+
+    spec = comparison_spec(recipe, result_a["rows"])
+    cutoffs = [
+        _page_cutoff(result["rows"], spec.primary_metric) if order_by and result.get("has_more") else None
+        for result in (result_a, result_b)
+    ]
+    comparison = compare_result_rows(
+        result_a["rows"], result_b["rows"], spec, threshold, relative_threshold_percent, max(1, top_n),
+        cutoff_a=cutoffs[0], cutoff_b=cutoffs[1],
+    )
+    warnings = [f"{label}: {w}" for label, r in (("run_a", result_a), ("run_b", result_b)) for w in r.get("warnings", [])]
+    for label, result in (("run_a", result_a), ("run_b", result_b)):
+        if result.get("has_more"):
+            if order_by:
+                warnings.append(
+                    f"{label} has more than {APX_RESULTS_MAX_PAGE_SIZE} rows; only its top rows by "
+                    f"{spec.primary_metric} were compared."
+                )
+            else:
+                warnings.append(
+                    f"{label} has more than {APX_RESULTS_MAX_PAGE_SIZE} rows; only the first page was compared."
+                )
+    return {
+        "status": "success",
+        "recipe": recipe,
+        "query_name": spec.query_name,
+        "run_a": run_a,
+        "run_b": run_b,
+        **comparison,
+        "warnings": warnings,
+    }
@@ -0,0 +1,182 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Prepared APX targets reused across apx_recipe_run calls.
+
+A session is keyed by (host, user, SSH key fingerprint) and remembers the prepared APX
+target and the recipes already confirmed ready on it, so later runs go straight to
+`apx recipe run`. Before a session is reused, an OpenSSH health check runs over a
+ControlMaster connection; the first check opens it and it stays open between calls, so
+later checks are a round trip on an existing connection rather than a new SSH handshake. A failed check, an expired
+session, or a failed run drops the session and the next call prepares the target again.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import hashlib
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Awaitable, Callable, Dict, Optional, Set, Tuple
+
+from .config import APX_SESSION_TTL_SECONDS, APX_SSH_CONTROL_PERSIST_SECONDS
+from .tool_metrics import record_subprocess
+
+LOCAL_TARGET_HOSTS = {"172.17.0.1", "localhost", "127.0.0.1"}
+HEALTH_CHECK_TIMEOUT_SECONDS = 15
+SSH_CONTROL_DIR = Path("/tmp/apx-ssh")
+
+SessionKey = Tuple[str, str, str]
+
+
+@dataclass
+class TargetSession:
+    key: SessionKey
+    target_id: str
+    key_path: str
+    known_hosts_path: str
+    prepared_at: float = field(default_factory=time.time)
+    ready_recipes: Set[str] = field(default_factory=set)
+
+    @property
+    def host(self) -> str:
+        return self.key[0]
+
+    @property
+    def user(self) -> str:
+        return self.key[1]
+
+    def summary(self, reused: bool, health_check: Optional[bool]) -> Dict[str, Any]:
+        return {
+            "target_id": self.target_id,
+            "reused": reused,
+            "health_check": "skipped" if health_check is None else ("ok" if health_check else "failed"),
+            "age_seconds": round(time.time() - self.prepared_at, 3),
+            "ready_recipes": sorted(self.ready_recipes),
+        }
+
+
+def canonical_host(remote_ip_addr: str) -> str:
+    # Matches prepare_target: local targets are reached through the docker bridge.
+    return "172.17.0.1" if remote_ip_addr in {"localhost", "127.0.0.1"} else remote_ip_addr
+
+
+def key_fingerprint(key_path: str) -> str:
+    """sha256 of the private key file, so a replaced key never reuses the old session."""
+    try:
+        return hashlib.sha256(Path(key_path).read_bytes()).hexdigest()
+    except OSError:
+        return f"path:{key_path}"
+
+
+async def ssh_health_check(session: TargetSession, timeout: float = HEALTH_CHECK_TIMEOUT_SECONDS) -> Optional[bool]:
+    """Run `true` on the target through a persistent ControlMaster connection.
+
+    Returns None when OpenSSH is not installed, so the caller can fall back to the TTL alone.
+    """
+    SSH_CONTROL_DIR.mkdir(parents=True, exist_ok=True)
+    # No -p: the port comes from ssh config (default 22), as for the connection APX itself makes.
+    command = [
+        "ssh", "-i", session.key_path,
+        "-o", "BatchMode=yes",
+        "-o", "ConnectTimeout=5",
+        "-o", "ControlMaster=auto",
+        "-o", f"ControlPath={SSH_CONTROL_DIR}/cm-%C",
+        "-o", f"ControlPersist={APX_SSH_CONTROL_PERSIST_SECONDS}",
+    ]
+    if session.host in LOCAL_TARGET_HOSTS:
+        # Local targets are added with --host-key-policy=ignore, so the check ignores host keys too.
+        command += ["-o", "StrictHostKeyChecking=no", "-o", "UserKnownHostsFile=/dev/null"]
+    else:
+        command += ["-o", f"UserKnownHostsFile={session.known_hosts_path}"]
+    command += [f"{session.user}@{session.host}", "true"]
+    try:
+        # The backgrounded master keeps whatever stdio it inherits, so none of it is a pipe we wait on.
+        proc = await asyncio.create_subprocess_exec(
+            *command,
+            stdin=asyncio.subprocess.DEVNULL,
+            stdout=asyncio.subprocess.DEVNULL,
+            stderr=asyncio.subprocess.DEVNULL,
+        )
+    except FileNotFoundError:
+        return None
+    started = time.perf_counter()
+    try:
+        return await asyncio.wait_for(proc.wait(), timeout=timeout) == 0
+    except asyncio.TimeoutError:
+        proc.kill()
+        await proc.wait()
+        return False
+    except asyncio.CancelledError:
+        if proc.returncode is None:
+            proc.kill()
+            await proc.wait()
+        raise
+    finally:
+        record_subprocess(time.perf_counter() - started)
+
+
+class TargetSessionCache:
+    """Prepared targets by (host, user, key fingerprint); one preparation per key at a time."""
+
+    def __init__(self, ttl: float = APX_SESSION_TTL_SECONDS):
+        self.ttl = ttl
+        self._sessions: Dict[SessionKey, TargetSession] = {}
+        self._locks: Dict[SessionKey, asyncio.Lock] = {}
+
+    def key(self, remote_ip_addr: str, remote_usr: str, key_path: str) -> SessionKey:
+        return canonical_host(remote_ip_addr), remote_usr, key_fingerprint(key_path)
+
+    async def acquire(
+        self,
+        remote_ip_addr: str,
+        remote_usr: str,
+        key_path: str,
+        known_hosts_path: str,
+        prepare: Callable[[], Awaitable[Dict[str, Any]]],
+    ) -> Tuple[Optional[TargetSession], Dict[str, Any]]:
+        """Return (session, prepare result), reusing a healthy session instead of calling prepare()."""
+        key = self.key(remote_ip_addr, remote_usr, key_path)
+        async with self._locks.setdefault(key, asyncio.Lock()):
+            session = self._sessions.get(key)
+            healthy: Optional[bool] = None
+            if session is not None and self.ttl > 0 and time.time() - session.prepared_at < self.ttl:
+                healthy = await ssh_health_check(session)
+                if healthy is not False:
+                    return session, {
+                        "target_id": session.target_id,
+                        "debug_trace": [],
+                        "session": session.summary(reused=True, health_check=healthy),
+                    }
+            self.invalidate(session)
+
+            prepared = await prepare()
+            if "error" in prepared:
+                return None, prepared
+            session = TargetSession(
+                key=key,
+                target_id=prepared["target_id"],
+                key_path=key_path,
+                known_hosts_path=known_hosts_path,
+            )
+            if self.ttl > 0:
+                self._sessions[key] = session
+            # Reports the failed check that caused this preparation, if any.
+            prepared["session"] = session.summary(reused=False, health_check=healthy)
+            return session, prepared
+
+    def invalidate(self, session: Optional[TargetSession]) -> None:
+        if session is not None and self._sessions.get(session.key) is session:
+            del self._sessions[session.key]
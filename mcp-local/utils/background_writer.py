@@ -0,0 +1,105 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Append-only log files written from a background thread, so tools never wait on disk I/O."""
+
+from __future__ import annotations
+
+from typing import Dict, List, Optional, Tuple
+import atexit
+import os
+import queue
+import threading
+
+from .config import LOG_WRITER_FLUSH_SECONDS, LOG_WRITER_QUEUE_SIZE
+
+
+class BackgroundWriter:
+    """Queues (path, text) appends and writes them in batches, one open() per file per batch.
+
+    append() never blocks: when the queue is full the text is dropped and counted in
+    self.dropped, since logging must not slow down or fail a tool call. close() writes
+    everything still queued; it is registered with atexit when the thread starts, and the
+    server also calls it on SIGTERM, which skips atexit. Appends after close() start a new thread.
+    """
+
+    def __init__(self, flush_seconds: float = LOG_WRITER_FLUSH_SECONDS, queue_size: int = LOG_WRITER_QUEUE_SIZE):
+        self.flush_seconds = flush_seconds
+        self.dropped = 0
+        self.written = 0
+        self._queue: "queue.Queue[Optional[Tuple[str, str]]]" = queue.Queue(maxsize=queue_size)
+        self._lock = threading.Lock()
+        self._thread: Optional[threading.Thread] = None
+
+    def append(self, path: str, text: str) -> None:
+        self._start()
+        try:
+            self._queue.put_nowait((path, text))
+        except queue.Full:
+            self.dropped += 1
+
+    def close(self) -> None:
+        with self._lock:
+            thread, self._thread = self._thread, None
+        if thread is None:
+            return
+        self._queue.put(None)
+        thread.join(timeout=10)
+
+    def _start(self) -> None:
+        if self._thread is not None:
+            return
+        with self._lock:
+            if self._thread is None:
+                self._thread = threading.Thread(target=self._run, name="log-writer", daemon=True)
+                self._thread.start()
+                atexit.register(self.close)
+
+    def _run(self) -> None:
+        stopping = False
+        while not stopping:
+            try:
+                item = self._queue.get(timeout=self.flush_seconds)
+            except queue.Empty:
+                continue
+            batch: List[Tuple[str, str]] = []
+            # Collect whatever else arrived meanwhile, so a burst of calls costs one write per file.
+            while True:
+                if item is None:
+                    stopping = True
+                else:
+                    batch.append(item)
+                try:
+                    item = self._queue.get_nowait()
+                except queue.Empty:
+                    break
+            self._write(batch)
+
+    def _write(self, batch: List[Tuple[str, str]]) -> None:
+        by_path: Dict[str, List[str]] = {}
+        for path, text in batch:
+            by_path.setdefault(path, []).append(text)
+        for path, texts in by_path.items():
+            try:
+                os.makedirs(os.path.dirname(path) or ".", exist_ok=True)
+                with open(path, "a", encoding="utf-8") as f:
+                    f.write("".join(texts))
+                self.written += len(texts)
+            except Exception:
+                # Never raise from logging
+                self.dropped += len(texts)
+
+
+# Shared by the invocation reason log and the per-call tool metrics log.
+LOG_WRITER = BackgroundWriter()
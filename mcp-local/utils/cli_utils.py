@@ -14,13 +14,122 @@
 
 from __future__ import annotations
 
-from typing import Dict, Any, List, Optional
+from typing import Awaitable, Callable, Dict, Any, List, Optional
+import asyncio
 import subprocess
 import shlex
 import os
+import time
 
+from .tool_metrics import record_subprocess
 
-def run_command(cmd: List[str], use_venv: bool = False, cwd: Optional[str] = None, env: Optional[Dict[str, str]] = None) -> Dict[str, Any]:
+
+def _decode_output(data: Optional[bytes]) -> str:
+    # Match subprocess.run(text=True): decode and apply universal newlines.
+    text = (data or b"").decode("utf-8", errors="replace")
+    return text.replace("\r\n", "\n").replace("\r", "\n")
+
+
+# Called with (stream name, line) for every line the child writes, as it is written.
+OutputCallback = Callable[[str, str], Awaitable[None]]
+
+
+async def _read_lines(
+    stream: asyncio.StreamReader, name: str, chunks: Optional[List[bytes]], on_output: OutputCallback
+) -> None:
+    # Read fixed-size chunks rather than readline() so very long lines (e.g. one-line JSON) cannot
+    # overrun the StreamReader limit. chunks is None when the caller only wants the lines.
+    pending = b""
+    while chunk := await stream.read(1 << 16):
+        if chunks is not None:
+            chunks.append(chunk)
+        *lines, pending = (pending + chunk).split(b"\n")
+        for line in lines:
+            await on_output(name, _decode_output(line))
+    if pending:
+        await on_output(name, _decode_output(pending))
+
+
+async def _communicate_streaming(
+    proc: asyncio.subprocess.Process,
+    on_output: OutputCallback,
+    stdout_chunks: Optional[List[bytes]],
+    stderr_chunks: List[bytes],
+) -> tuple[bytes, bytes]:
+    # The caller owns the chunk lists, so what was read is still there if this is cancelled.
+    await asyncio.gather(
+        _read_lines(proc.stdout, "stdout", stdout_chunks, on_output),
+        _read_lines(proc.stderr, "stderr", stderr_chunks, on_output),
+    )
+    await proc.wait()
+    return b"".join(stdout_chunks or []), b"".join(stderr_chunks)
+
+
+async def run_process(
+    cmd: List[str],
+    cwd: Optional[str] = None,
+    env: Optional[Dict[str, str]] = None,
+    timeout: Optional[float] = None,
+    on_output: Optional[OutputCallback] = None,
+    keep_stdout: bool = True,
+    text: bool = True,
+) -> subprocess.CompletedProcess:
+    """Async counterpart of subprocess.run(capture_output=True, text=True).
+
+    The child runs without blocking the event loop, its stdin is /dev/null so it can never read
+    the MCP stdio stream, and on timeout it is killed before subprocess.TimeoutExpired is raised.
+    When on_output is given, output is also delivered line by line while the child runs; with
+    keep_stdout=False stdout then only goes to on_output and is not buffered (the returned
+    stdout is empty), for output too large to hold in memory. With text=False the returned
+    stdout and stderr are the bytes the child wrote, undecoded.
+    """
+    proc = await asyncio.create_subprocess_exec(
+        *cmd,
+        cwd=cwd,
+        env=env,
+        stdin=asyncio.subprocess.DEVNULL,
+        stdout=asyncio.subprocess.PIPE,
+        stderr=asyncio.subprocess.PIPE,
+    )
+    started = time.perf_counter()
+    stdout_chunks: Optional[List[bytes]] = [] if keep_stdout else None
+    stderr_chunks: List[bytes] = []
+    if on_output:
+        communicate = _communicate_streaming(proc, on_output, stdout_chunks, stderr_chunks)
+    else:
+        communicate = proc.communicate()
+    try:
+        stdout, stderr = await asyncio.wait_for(communicate, timeout=timeout)
+    except asyncio.TimeoutError:
+        proc.kill()
+        if on_output is None:
+            stdout, stderr = await proc.communicate()
+        else:
+            # Streamed lines were already delivered through on_output; report what was buffered.
+            await proc.wait()
+            stdout, stderr = b"".join(stdout_chunks or []), b"".join(stderr_chunks)
+        raise subprocess.TimeoutExpired(cmd, timeout, output=_decode_output(stdout), stderr=_decode_output(stderr))
+    except asyncio.CancelledError:
+        # The client abandoned the call; do not leave the child running.
+        if proc.returncode is None:
+            proc.kill()
+            await proc.wait()
+        raise
+    finally:
+        record_subprocess(time.perf_counter() - started)
+    if not text:
+        return subprocess.CompletedProcess(cmd, proc.returncode, stdout or b"", stderr or b"")
+    return subprocess.CompletedProcess(cmd, proc.returncode, _decode_output(stdout), _decode_output(stderr))
+
+
+async def run_command(
+    cmd: List[str],
+    use_venv: bool = False,
+    cwd: Optional[str] = None,
+    env: Optional[Dict[str, str]] = None,
+    timeout: Optional[float] = None,
+    text: bool = True,
+) -> Dict[str, Any]:
     """Run a CLI command and return a structured result.
 
     Args:
@@ -28,6 +137,8 @@ def run_command(cmd: List[str], use_venv: bool = False, cwd: Optional[str] = Non
         use_venv: If true, ensure the command runs with this project's venv bin on PATH.
         cwd: Optional working directory.
         env: Optional extra environment variables.
+        timeout: Seconds before the command is killed and reported as an error (code 124).
+        text: If false, stdout is returned as the raw bytes the command wrote (e.g. to hash it).
 
     Returns:
         Dict with keys: status (ok/error), code, stdout, stderr, cmd.
@@ -43,24 +154,17 @@ def run_command(cmd: List[str], use_venv: bool = False, cwd: Optional[str] = Non
             full_env["PATH"] = f"{venv_bin}:{full_env.get('PATH','')}"
 
     try:
-        proc = subprocess.run(
-            cmd,
-            cwd=cwd,
-            env=full_env,
-            text=True,
-            stdout=subprocess.PIPE,
-            stderr=subprocess.PIPE,
-            check=False,
-        )
+        proc = await run_process(cmd, cwd=cwd, env=full_env, timeout=timeout, text=text)
         return {
             "status": "ok" if proc.returncode == 0 else "error",
             "code": proc.returncode,
             "stdout": proc.stdout,
-            "stderr": proc.stderr,
+            "stderr": proc.stderr if text else _decode_output(proc.stderr),
             "cmd": cmd,
         }
+    except subprocess.TimeoutExpired:
+        return {"status": "error", "code": 124, "stdout": "", "stderr": f"Timed out after {timeout}s", "cmd": cmd}
     except FileNotFoundError as e:
         return {"status": "error", "code": 127, "stdout": "", "stderr": str(e), "cmd": cmd}
     except Exception as e:
         return {"status": "error", "code": -1, "stdout": "", "stderr": str(e), "cmd": cmd}
-
@@ -21,11 +21,42 @@ BASE_DIR = os.path.dirname(os.path.abspath(__file__))
 DATA_DIR = os.path.join(os.path.dirname(BASE_DIR), "data")
 USEARCH_INDEX_PATH = os.path.join(DATA_DIR, "usearch_index.bin")
 METADATA_PATH = os.path.join(DATA_DIR, "metadata.json")
+# Memory-mapped metadata and BM25 index written by arm_kb_search.write_search_artifacts.
+SEARCH_ARTIFACTS_DIR = os.path.join(DATA_DIR, "search_artifacts")
+# Opt-in: memory-map the USearch index (shared page cache across containers) instead of loading it.
+USEARCH_INDEX_VIEW = os.getenv("USEARCH_INDEX_VIEW", "").strip().lower() in {"1", "true", "yes", "on"}
 MODEL_NAME = 'all-MiniLM-L6-v2'
+# Query encoder backend: torch (default), onnx, or onnx-int8 (dynamically quantized for arm64).
+EMBEDDING_BACKEND = os.getenv("EMBEDDING_BACKEND", "torch").strip().lower() or "torch"
+# ONNX exports written at image build time; outside the image the hub copy of MODEL_NAME is used.
+ONNX_MODEL_DIR = os.path.join(os.path.dirname(BASE_DIR), "models", "onnx", MODEL_NAME)
+# Threads serving knowledge base searches off the event loop.
+SEARCH_WORKERS = max(1, int(os.getenv("SEARCH_WORKERS", str(min(4, os.cpu_count() or 1)))))
+# LRU entries kept for query embeddings and for formatted search results (0 disables the cache).
+try:
+    SEARCH_CACHE_SIZE = max(0, int(os.getenv("SEARCH_CACHE_SIZE", "1024")))
+except ValueError:
+    # A malformed value must not stop the server from starting; use the default size.
+    SEARCH_CACHE_SIZE = 1024
+# Opt-in: persist the query cache here (e.g. under /workspace) so warm restarts reuse it.
+SEARCH_CACHE_PATH = os.getenv("SEARCH_CACHE_PATH", "").strip() or None
 
 # Docker architecture checking configuration
 TARGET_ARCHITECTURES = {'amd64', 'arm64'}
 TIMEOUT_SECONDS = 10
+# Registry requests check_images keeps in flight at once.
+IMAGE_CHECK_CONCURRENCY = max(1, int(os.getenv("IMAGE_CHECK_CONCURRENCY", "8")))
+# How long a tag keeps resolving to the manifest digest it had; digests never change, so
+# manifests are cached by digest (up to IMAGE_MANIFEST_CACHE_SIZE) without expiry. 0 disables.
+IMAGE_TAG_CACHE_TTL_SECONDS = float(os.getenv("IMAGE_TAG_CACHE_TTL_SECONDS", "300"))
+IMAGE_MANIFEST_CACHE_SIZE = int(os.getenv("IMAGE_MANIFEST_CACHE_SIZE", "1024"))
+
+# skopeo configuration
+# skopeo processes skopeo_inspect_images runs at once, and the per-process timeout.
+SKOPEO_CONCURRENCY = max(1, int(os.getenv("SKOPEO_CONCURRENCY", "4")))
+SKOPEO_TIMEOUT_SECONDS = float(os.getenv("SKOPEO_TIMEOUT_SECONDS", "60"))
+# Platform summaries cached by image@digest; digests are immutable, so entries never expire.
+SKOPEO_CACHE_SIZE = int(os.getenv("SKOPEO_CACHE_SIZE", "512"))
 
 # migrate-ease configuration
 MIGRATE_EASE_ROOT = "/app/migrate-ease"
@@ -33,4 +64,47 @@ MIGRATE_EASE_ROOT = "/app/migrate-ease"
 # installed: cpp, python, go, js, java.
 SUPPORTED_SCANNERS = {"cpp", "python", "go", "js", "java"}
 DEFAULT_ARCH = "armv8-a"
+# Scanners run at once by scanner="all" / multi-scanner scans; each one is a CPU-bound process.
+MIGRATE_EASE_PARALLELISM = max(
+    1, int(os.getenv("MIGRATE_EASE_PARALLELISM", str(min(len(SUPPORTED_SCANNERS), os.cpu_count() or 1))))
+)
 WORKSPACE_DIR = "/workspace"
+# How local scans see a filtered /workspace: "link" mirrors the tree with hardlinks/symlinks
+# (no file data copied), "copy" makes a full filtered copy.
+WORKSPACE_VIEW_MODE = os.getenv("WORKSPACE_VIEW_MODE", "link").strip().lower()
+if WORKSPACE_VIEW_MODE not in {"link", "copy"}:
+    WORKSPACE_VIEW_MODE = "link"
+# Per-file findings of local scans, reused so rescans only cover changed files (MIGRATE_EASE_CACHE=0 disables).
+MIGRATE_EASE_CACHE = os.getenv("MIGRATE_EASE_CACHE", "1").strip().lower() in {"1", "true", "yes", "on"}
+MIGRATE_EASE_CACHE_DIR = os.path.join(WORKSPACE_DIR, ".arm-mcp", "migrate-ease-cache")
+# Above this fraction of changed files a rescan runs over the whole workspace instead.
+MIGRATE_EASE_CACHE_MAX_CHANGED_FRACTION = 0.5
+# Remote scans (git_repo) check out from blobless depth-1 mirrors kept here (MIGRATE_EASE_GIT_CACHE=0 disables).
+MIGRATE_EASE_GIT_CACHE = os.getenv("MIGRATE_EASE_GIT_CACHE", "1").strip().lower() in {"1", "true", "yes", "on"}
+MIGRATE_EASE_GIT_CACHE_DIR = os.path.join(WORKSPACE_DIR, ".arm-mcp", "git-cache")
+MIGRATE_EASE_GIT_CACHE_MAX_REPOS = 20
+# Opt-in: check out only the files the requested scanners read.
+MIGRATE_EASE_SPARSE_CHECKOUT = os.getenv("MIGRATE_EASE_SPARSE_CHECKOUT", "").strip().lower() in {"1", "true", "yes", "on"}
+
+# APX target sessions: a prepared target is reused for this long while its SSH health check passes (0 disables).
+APX_SESSION_TTL_SECONDS = float(os.getenv("APX_SESSION_TTL_SECONDS", "1800"))
+# Idle time before the SSH ControlMaster connection used by the health check closes.
+APX_SSH_CONTROL_PERSIST_SECONDS = 600
+
+# Background jobs (start_migrate_ease_scan / start_apx_recipe_run)
+# Jobs beyond this many wait for a free slot instead of all competing for the CPU at once.
+JOB_MAX_CONCURRENT = max(1, int(os.getenv("JOB_MAX_CONCURRENT", "4")))
+# Output lines kept per job for job_status, and finished jobs kept for job_result.
+JOB_OUTPUT_TAIL_LINES = 500
+JOB_RETENTION = 50
+
+# Tool telemetry
+# Log files (invocation reasons, per-call tool metrics) are appended by a background thread
+# at most this often; appends beyond LOG_WRITER_QUEUE_SIZE pending entries are dropped.
+LOG_WRITER_FLUSH_SECONDS = 1.0
+LOG_WRITER_QUEUE_SIZE = 10000
+# Opt-in: append one JSON line per tool call (timings, RSS, response size) to this file,
+# for example /workspace/.arm-mcp/tool_metrics.jsonl. server_stats works without it.
+TOOL_METRICS_PATH = os.getenv("TOOL_METRICS_PATH", "").strip() or None
+# Recent calls per tool the server_stats latency percentiles are computed over.
+TOOL_METRICS_WINDOW = max(1, int(os.getenv("TOOL_METRICS_WINDOW", "1024")))
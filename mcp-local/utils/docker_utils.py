@@ -12,39 +12,168 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Dict, List, Tuple
-import requests
-from .config import TARGET_ARCHITECTURES, TIMEOUT_SECONDS
+import asyncio
+import re
+import time
+from collections import OrderedDict
+from dataclasses import dataclass
+from typing import Dict, List, Optional, Tuple
+import httpx
+from .config import (
+    IMAGE_CHECK_CONCURRENCY,
+    IMAGE_MANIFEST_CACHE_SIZE,
+    IMAGE_TAG_CACHE_TTL_SECONDS,
+    TARGET_ARCHITECTURES,
+    TIMEOUT_SECONDS,
+)
 
+DOCKER_HUB_REGISTRY = "registry-1.docker.io"
+DOCKER_HUB_ALIASES = {"docker.io", "index.docker.io", DOCKER_HUB_REGISTRY}
+DOCKER_HUB_AUTH = ("https://auth.docker.io/token", "registry.docker.io")
+MANIFEST_ACCEPT = ", ".join([
+    "application/vnd.docker.distribution.manifest.list.v2+json",
+    "application/vnd.oci.image.index.v1+json",
+])
+# Tokens are refreshed this long before the registry says they expire.
+TOKEN_EXPIRY_MARGIN_SECONDS = 10
+DEFAULT_TOKEN_LIFETIME_SECONDS = 60
+CHALLENGE_PARAM_RE = re.compile(r'(\w+)="([^"]*)"')
 
-def get_auth_token(repository: str) -> str:
-    """Get Docker Hub authentication token."""
-    url = "https://auth.docker.io/token"
-    params = {
-        "service": "registry.docker.io",
-        "scope": f"repository:{repository}:pull"
-    }
+# Bearer tokens by (registry, scope), and the token endpoint each registry advertised.
+_tokens: Dict[Tuple[str, str], Tuple[str, float]] = {}
+_auth_endpoints: Dict[str, Tuple[str, Optional[str]]] = {DOCKER_HUB_REGISTRY: DOCKER_HUB_AUTH}
+# (registry, repository, tag) -> (digest, expires_at); digest -> manifest.
+_tag_digests: Dict[Tuple[str, str, str], Tuple[str, float]] = {}
+_manifests: "OrderedDict[str, Dict]" = OrderedDict()
+# One pooled client per event loop, shared by every check.
+_client: Optional[httpx.AsyncClient] = None
+_client_loop: Optional[asyncio.AbstractEventLoop] = None
+
+
+@dataclass(frozen=True)
+class ImageReference:
+    registry: str
+    repository: str
+    reference: str
+
+    @property
+    def is_digest(self) -> bool:
+        return self.reference.startswith("sha256:")
+
+
+def shared_client() -> httpx.AsyncClient:
+    """The pooled client for the running event loop, so connections are reused across checks."""
+    global _client, _client_loop
+    loop = asyncio.get_running_loop()
+    if _client is None or _client.is_closed or _client_loop is not loop:
+        _client = httpx.AsyncClient(
+            timeout=TIMEOUT_SECONDS,
+            limits=httpx.Limits(max_connections=IMAGE_CHECK_CONCURRENCY * 2, max_keepalive_connections=IMAGE_CHECK_CONCURRENCY),
+        )
+        _client_loop = loop
+    return _client
+
+
+def _cached_token(registry: str, scope: str) -> Optional[str]:
+    cached = _tokens.get((registry, scope))
+    if cached and cached[1] > time.monotonic():
+        return cached[0]
+    return None
+
+
+async def get_auth_token(
+    repository: str,
+    client: httpx.AsyncClient,
+    registry: str = DOCKER_HUB_REGISTRY,
+) -> str:
+    """Get a pull token for repository from the registry's token endpoint, reusing it until it expires."""
+    scope = f"repository:{repository}:pull"
+    token = _cached_token(registry, scope)
+    if token:
+        return token
+    realm, service = _auth_endpoints.get(registry, DOCKER_HUB_AUTH)
+    params = {"scope": scope}
+    if service:
+        params["service"] = service
     try:
-        response = requests.get(url, params=params, timeout=TIMEOUT_SECONDS)
+        response = await client.get(realm, params=params, timeout=TIMEOUT_SECONDS)
         response.raise_for_status()
-        return response.json()['token']
-    except requests.exceptions.RequestException as e:
+        payload = response.json()
+        token = payload.get('token') or payload['access_token']
+    except (httpx.HTTPError, ValueError, KeyError) as e:
         return f"Failed to get auth token: {e}"
+    lifetime = payload.get("expires_in") or DEFAULT_TOKEN_LIFETIME_SECONDS
+    _tokens[(registry, scope)] = (token, time.monotonic() + max(0, lifetime - TOKEN_EXPIRY_MARGIN_SECONDS))
+    return token
 
 
-def get_manifest(repository: str, tag: str, token: str) -> Dict:
-    """Fetch manifest for specified image."""
-    headers = {
-        'Accept': 'application/vnd.docker.distribution.manifest.list.v2+json',
-        'Authorization': f'Bearer {token}'
-    }
-    url = f"https://registry-1.docker.io/v2/{repository}/manifests/{tag}"
+def _parse_bearer_challenge(header: str) -> Optional[Tuple[str, Optional[str]]]:
+    if not header.lower().startswith("bearer "):
+        return None
+    params = dict(CHALLENGE_PARAM_RE.findall(header))
+    return (params["realm"], params.get("service")) if "realm" in params else None
+
+
+def _cache_manifest(image: ImageReference, digest: Optional[str], manifest: Dict) -> None:
+    if IMAGE_MANIFEST_CACHE_SIZE <= 0 or not digest:
+        return
+    _manifests[digest] = manifest
+    _manifests.move_to_end(digest)
+    while len(_manifests) > IMAGE_MANIFEST_CACHE_SIZE:
+        _manifests.popitem(last=False)
+    if not image.is_digest and IMAGE_TAG_CACHE_TTL_SECONDS > 0:
+        _tag_digests[(image.registry, image.repository, image.reference)] = (
+            digest, time.monotonic() + IMAGE_TAG_CACHE_TTL_SECONDS
+        )
+
+
+def _cached_manifest(image: ImageReference) -> Optional[Dict]:
+    digest = image.reference if image.is_digest else None
+    if digest is None:
+        resolved = _tag_digests.get((image.registry, image.repository, image.reference))
+        if resolved and resolved[1] > time.monotonic():
+            digest = resolved[0]
+    manifest = _manifests.get(digest) if digest else None
+    if manifest is not None:
+        _manifests.move_to_end(digest)
+    return manifest
+
+
+async def get_manifest(
+    repository: str,
+    tag: str,
+    token: Optional[str],
+    client: httpx.AsyncClient,
+    registry: str = DOCKER_HUB_REGISTRY,
+) -> Dict:
+    """Fetch manifest for specified image.
+
+    Without a token the request is sent anonymously, and a bearer challenge from the registry
+    is answered once with a token from the endpoint it names.
+    """
+    headers = {'Accept': MANIFEST_ACCEPT}
+    if token:
+        headers['Authorization'] = f'Bearer {token}'
+    url = f"https://{registry}/v2/{repository}/manifests/{tag}"
     try:
-        response = requests.get(url, headers=headers, timeout=TIMEOUT_SECONDS)
+        response = await client.get(url, headers=headers, timeout=TIMEOUT_SECONDS)
+        if response.status_code == 401 and not token:
+            challenge = _parse_bearer_challenge(response.headers.get("www-authenticate", ""))
+            if challenge:
+                _auth_endpoints[registry] = challenge
+                token = await get_auth_token(repository, client, registry)
+                if token.startswith("Failed"):
+                    return {"error": token}
+                headers['Authorization'] = f'Bearer {token}'
+                response = await client.get(url, headers=headers, timeout=TIMEOUT_SECONDS)
         response.raise_for_status()
-        return response.json()
-    except requests.exceptions.RequestException as e:
+        manifest = response.json()
+    except (httpx.HTTPError, ValueError) as e:
         return {"error": f"Failed to get manifest: {e}"}
+    image = ImageReference(registry, repository, tag)
+    digest = response.headers.get("docker-content-digest") or (tag if image.is_digest else None)
+    _cache_manifest(image, digest, manifest)
+    return manifest
 
 
 def check_architectures(manifest: Dict) -> List[str]:
@@ -56,48 +185,108 @@ def check_architectures(manifest: Dict) -> List[str]:
         return []
 
 
+def parse_image_reference(image: str) -> ImageReference:
+    """Split an image reference into registry, repository, and tag or digest.
+
+    The first path component is a registry when it contains '.' or ':' or is 'localhost'
+    (as Docker resolves names); otherwise the image is on Docker Hub, where single-name
+    images live under library/.
+    """
+    remainder, digest = image.split('@', 1) if '@' in image else (image, None)
+    name, tag = remainder, 'latest'
+    last_slash = remainder.rfind('/')
+    if ':' in remainder[last_slash + 1:]:
+        name, tag = remainder.rsplit(':', 1)
+
+    first, _, rest = name.partition('/')
+    if rest and ('.' in first or ':' in first or first == 'localhost'):
+        registry, repository = first.lower(), rest
+    else:
+        registry, repository = DOCKER_HUB_REGISTRY, name
+    if registry in DOCKER_HUB_ALIASES:
+        registry = DOCKER_HUB_REGISTRY
+        if '/' not in repository:
+            repository = f'library/{repository}'
+    return ImageReference(registry, repository.lower(), digest or tag)
+
+
 def parse_image_spec(image: str) -> Tuple[str, str]:
     """Parse image specification into repository and tag."""
-    if ':' in image:
-        repository, tag = image.split(':', 1)
-    else:
-        repository, tag = image, 'latest'
+    parsed = parse_image_reference(image)
+    return parsed.repository, parsed.reference
+
 
-    if '/' not in repository:
-        repository = f'library/{repository}'
-    return repository.lower(), tag
+async def _fetch_manifest(image: ImageReference, client: httpx.AsyncClient) -> Dict:
+    cached = _cached_manifest(image)
+    if cached is not None:
+        return cached
+    token: Optional[str] = None
+    if image.registry in _auth_endpoints:
+        # The token endpoint is known, so skip the anonymous round trip that discovers it.
+        token = await get_auth_token(image.repository, client, image.registry)
+        if token.startswith("Failed"):
+            return {"error": token}
+    return await get_manifest(image.repository, image.reference, token, client, image.registry)
 
 
-def check_docker_image_architectures(image: str) -> dict:
+async def check_docker_image_architectures(image: str, client: Optional[httpx.AsyncClient] = None) -> dict:
     """Check Docker image architectures and return status information."""
-    repository, tag = parse_image_spec(image)
-    token = get_auth_token(repository)
-    
-    if isinstance(token, str) and not token.startswith("Failed"):
-        manifest = get_manifest(repository, tag, token)
-        if isinstance(manifest, dict) and not manifest.get("error"):
-            architectures = check_architectures(manifest)
-            
-            if not architectures:
-                return {"status": "error", "message": f"No architectures found for {image}"}
-            
-            available_targets = TARGET_ARCHITECTURES.intersection(architectures)
-            missing_targets = TARGET_ARCHITECTURES - set(architectures)
-            
-            if not missing_targets:
-                return {
-                    "status": "success",
-                    "message": f"Image {image} supports all required architectures",
-                    "architectures": architectures
-                }
-            else:
-                return {
-                    "status": "warning",
-                    "message": f"Image {image} is missing architectures: {', '.join(missing_targets)}",
-                    "available": architectures,
-                    "missing": list(missing_targets)
-                }
+    if client is None:
+        client = shared_client()
+
+    manifest = await _fetch_manifest(parse_image_reference(image), client)
+    if isinstance(manifest, dict) and not manifest.get("error"):
+        architectures = check_architectures(manifest)
+
+        if not architectures:
+            return {"status": "error", "message": f"No architectures found for {image}"}
+
+        available_targets = TARGET_ARCHITECTURES.intersection(architectures)
+        missing_targets = TARGET_ARCHITECTURES - set(architectures)
+
+        if not missing_targets:
+            return {
+                "status": "success",
+                "message": f"Image {image} supports all required architectures",
+                "architectures": architectures
+            }
         else:
-            return {"status": "error", "message": manifest.get("error", "Unknown error getting manifest")}
+            return {
+                "status": "warning",
+                "message": f"Image {image} is missing architectures: {', '.join(missing_targets)}",
+                "available": architectures,
+                "missing": list(missing_targets)
+            }
+    else:
+        return {"status": "error", "message": manifest.get("error", "Unknown error getting manifest")}
+
+
+async def check_images_architectures(images: List[str], client: Optional[httpx.AsyncClient] = None) -> dict:
+    """Check many images concurrently over one pooled client; duplicates are checked once."""
+    client = client or shared_client()
+    started = time.monotonic()
+    semaphore = asyncio.Semaphore(IMAGE_CHECK_CONCURRENCY)
+    unique = list(dict.fromkeys(image.strip() for image in images if image and image.strip()))
+
+    async def check(image: str) -> dict:
+        async with semaphore:
+            try:
+                return await check_docker_image_architectures(image, client)
+            except Exception as e:
+                return {"status": "error", "message": f"Failed to check {image}: {e}"}
+
+    results = dict(zip(unique, await asyncio.gather(*(check(image) for image in unique))))
+    counts = {status: sum(1 for r in results.values() if r["status"] == status) for status in ("success", "warning", "error")}
+    if counts["error"] == len(results):
+        status = "error"
+    elif counts["success"] == len(results):
+        status = "success"
     else:
-        return {"status": "error", "message": token}
\ No newline at end of file
+        status = "warning"
+    return {
+        "status": status,
+        "summary": {"images": len(results), **counts},
+        "missing_arm64": [image for image, r in results.items() if "arm64" in r.get("missing", [])],
+        "results": results,
+        "elapsed_seconds": round(time.monotonic() - started, 3),
+    }
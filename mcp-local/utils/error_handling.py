@@ -20,6 +20,7 @@ from datetime import datetime, timezone
 
 import yaml
 
+from .background_writer import LOG_WRITER
 from .config import WORKSPACE_DIR
 
 
@@ -46,9 +47,8 @@ def _log_error(tool: str, exc: Exception, args: Optional[Dict[str, Any]] = None)
     log_path = os.path.join(WORKSPACE_DIR, LOG_FILE_NAME)
 
     try:
-        os.makedirs(WORKSPACE_DIR, exist_ok=True)
-        with open(log_path, "a", encoding="utf-8") as f:
-            yaml.safe_dump(entry, f, explicit_start=True, sort_keys=False, allow_unicode=True)
+        document = yaml.safe_dump(entry, explicit_start=True, sort_keys=False, allow_unicode=True)
+        LOG_WRITER.append(log_path, document)
     except Exception:
         # Never raise from logging
         pass
@@ -0,0 +1,198 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Cached partial clones of remote repositories for migrate-ease scans.
+
+Each repository is kept as one bare, blobless mirror under MIGRATE_EASE_GIT_CACHE_DIR.
+A scan fetches only the requested ref at depth 1 into the mirror and checks it out as a
+temporary detached worktree, optionally sparse (limited to the scanner's source files),
+so rescans and scans of other commits of the same repository reuse what was downloaded.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+import tempfile
+from dataclasses import dataclass
+from typing import Dict, Iterable, List, Optional
+
+from .cli_utils import OutputCallback, run_process
+from .config import MIGRATE_EASE_GIT_CACHE_DIR, MIGRATE_EASE_GIT_CACHE_MAX_REPOS
+
+GIT_TIMEOUT_SECONDS = 60 * 10
+
+# Files each scanner reads, in gitignore (non-cone sparse-checkout) syntax.
+SCANNER_SPARSE_PATTERNS: Dict[str, List[str]] = {
+    "cpp": [
+        "*.c", "*.cc", "*.cpp", "*.cxx", "*.c++", "*.h", "*.hh", "*.hpp", "*.hxx", "*.inl",
+        "*.s", "*.S", "*.asm", "CMakeLists.txt", "*.cmake", "Makefile", "makefile", "*.mk",
+        "configure.ac", "meson.build",
+    ],
+    "python": ["*.py", "*.pyx", "*.pxd", "requirements*.txt", "setup.py", "setup.cfg", "pyproject.toml", "Pipfile*"],
+    "go": ["*.go", "go.mod", "go.sum", "*.s"],
+    "js": ["*.js", "*.mjs", "*.cjs", "*.jsx", "*.ts", "*.tsx", "package.json", "package-lock.json", "yarn.lock"],
+    "java": ["*.java", "*.jar", "pom.xml", "*.gradle", "*.gradle.kts", "*.so"],
+}
+
+_locks: Dict[str, asyncio.Lock] = {}
+# Worktrees checked out per mirror; a mirror in use is never evicted.
+_active: Dict[str, int] = {}
+
+
+class GitCacheError(RuntimeError):
+    """A git command run for the clone cache failed."""
+
+
+@dataclass
+class GitCheckout:
+    path: str
+    mirror: str
+    url: str
+    ref: Optional[str]
+    commit: str
+    sparse: bool
+
+
+def sparse_patterns(scanners: Iterable[str]) -> List[str]:
+    """Union of the sparse-checkout patterns of the given scanners."""
+    patterns: List[str] = []
+    for scanner in scanners:
+        patterns.extend(p for p in SCANNER_SPARSE_PATTERNS.get(scanner, []) if p not in patterns)
+    return patterns
+
+
+def mirror_path(url: str, cache_dir: str = MIGRATE_EASE_GIT_CACHE_DIR) -> str:
+    name = re.sub(r"[^A-Za-z0-9._-]", "_", url.rstrip("/").rsplit("/", 1)[-1].removesuffix(".git")) or "repo"
+    return os.path.join(cache_dir, f"{name}-{hashlib.sha256(url.encode('utf-8')).hexdigest()[:16]}.git")
+
+
+# Abbreviated or full SHA-1 / SHA-256 object names.
+_COMMIT_ID = re.compile(r"[0-9a-fA-F]{4,64}")
+
+
+async def validate_remote(url: str, ref: Optional[str] = None) -> None:
+    """Reject a repository URL or ref git could read as an option, or a ref that is not a ref name.
+
+    Both come straight from tool arguments, and e.g. a ref of --upload-pack=<cmd> would make
+    git fetch run a command. Refs must be a commit id or pass git check-ref-format --allow-onelevel.
+    """
+    if not url or url.startswith("-") or any(ord(char) < 32 for char in url):
+        raise GitCacheError(f"Invalid git repository URL: {url!r}")
+    if not ref or _COMMIT_ID.fullmatch(ref):
+        return
+    if ref.startswith("-"):
+        raise GitCacheError(f"Invalid git ref: {ref!r}")
+    proc = await run_process(["git", "check-ref-format", "--allow-onelevel", ref], timeout=GIT_TIMEOUT_SECONDS)
+    if proc.returncode != 0:
+        raise GitCacheError(f"Invalid git ref: {ref!r}")
+
+
+def _lock(mirror: str) -> asyncio.Lock:
+    return _locks.setdefault(mirror, asyncio.Lock())
+
+
+async def _git(args: List[str], on_output: Optional[OutputCallback] = None) -> str:
+    # Never wait on a credential prompt: the server has no terminal to answer it.
+    env = dict(os.environ, GIT_TERMINAL_PROMPT="0")
+    proc = await run_process(["git", *args], env=env, timeout=GIT_TIMEOUT_SECONDS, on_output=on_output)
+    if proc.returncode != 0:
+        raise GitCacheError(f"git {' '.join(args[:3])} failed ({proc.returncode}): {proc.stderr.strip()[-2000:]}")
+    return proc.stdout.strip()
+
+
+async def _ensure_mirror(mirror: str, url: str) -> None:
+    if os.path.isfile(os.path.join(mirror, "HEAD")):
+        return
+    # A mirror left half-created by an interrupted run is started over.
+    await asyncio.to_thread(shutil.rmtree, mirror, ignore_errors=True)
+    os.makedirs(os.path.dirname(mirror), exist_ok=True)
+    await _git(["init", "--bare", "--quiet", mirror])
+    await _git(["-C", mirror, "remote", "add", "--", "origin", url])
+    # Blobs left out by --filter are fetched on demand from the promisor remote at checkout.
+    await _git(["-C", mirror, "config", "remote.origin.promisor", "true"])
+    await _git(["-C", mirror, "config", "remote.origin.partialclonefilter", "blob:none"])
+
+
+async def checkout(
+    url: str,
+    ref: Optional[str] = None,
+    patterns: Optional[List[str]] = None,
+    on_output: Optional[OutputCallback] = None,
+) -> GitCheckout:
+    """Fetch ref (default: the remote HEAD) into the cached mirror and check it out in /tmp.
+
+    With patterns, only matching files are materialized. Release the checkout with release().
+    """
+    await validate_remote(url, ref)
+    mirror = mirror_path(url)
+    async with _lock(mirror):
+        await _ensure_mirror(mirror, url)
+        await _git(
+            ["-C", mirror, "fetch", "--quiet", "--depth", "1", "--filter=blob:none", "--", "origin", ref or "HEAD"],
+            on_output=on_output,
+        )
+        commit = await _git(["-C", mirror, "rev-parse", "FETCH_HEAD^{commit}"])
+        path = tempfile.mkdtemp(prefix="migrate_ease_clone_", dir="/tmp")
+        try:
+            await _git(["-C", mirror, "worktree", "add", "--quiet", "--detach", "--no-checkout", path, commit])
+            if patterns:
+                await _git(["-C", path, "sparse-checkout", "set", "--no-cone", *patterns])
+            await _git(["-C", path, "read-tree", "-mu", "HEAD"], on_output=on_output)
+        except (GitCacheError, OSError, subprocess.TimeoutExpired):
+            await _remove_worktree(mirror, path)
+            raise
+        os.utime(mirror)
+        _active[mirror] = _active.get(mirror, 0) + 1
+    return GitCheckout(path=path, mirror=mirror, url=url, ref=ref, commit=commit, sparse=bool(patterns))
+
+
+async def _remove_worktree(mirror: str, path: str) -> None:
+    try:
+        await _git(["-C", mirror, "worktree", "remove", "--force", path])
+    except (GitCacheError, OSError, subprocess.TimeoutExpired):
+        await asyncio.to_thread(shutil.rmtree, path, ignore_errors=True)
+        try:
+            await _git(["-C", mirror, "worktree", "prune"])
+        except (GitCacheError, OSError, subprocess.TimeoutExpired):
+            pass
+
+
+async def release(checkout_: GitCheckout) -> None:
+    """Remove a checkout's worktree and evict the least recently used mirrors over the limit."""
+    async with _lock(checkout_.mirror):
+        await _remove_worktree(checkout_.mirror, checkout_.path)
+        _active[checkout_.mirror] = max(0, _active.get(checkout_.mirror, 0) - 1)
+    await _prune_mirrors()
+
+
+async def _prune_mirrors(
+    max_repos: int = MIGRATE_EASE_GIT_CACHE_MAX_REPOS, cache_dir: str = MIGRATE_EASE_GIT_CACHE_DIR
+) -> None:
+    try:
+        mirrors = [entry for entry in os.scandir(cache_dir) if entry.is_dir() and entry.name.endswith(".git")]
+    except OSError:
+        return
+    mirrors.sort(key=lambda entry: entry.stat().st_mtime, reverse=True)
+    for entry in mirrors[max_repos:]:
+        lock = _lock(entry.path)
+        if lock.locked() or _active.get(entry.path):
+            continue
+        async with lock:
+            await asyncio.to_thread(shutil.rmtree, entry.path, ignore_errors=True)
+        _locks.pop(entry.path, None)
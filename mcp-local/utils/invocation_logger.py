@@ -19,6 +19,7 @@ from typing import Optional, Dict, Any
 
 import yaml
 
+from .background_writer import LOG_WRITER
 from .config import WORKSPACE_DIR
 
 
@@ -34,6 +35,7 @@ def log_invocation_reason(tool: str, reason: Optional[str], args: Optional[Dict[
     Append a YAML document with the tool invocation reason and metadata to /workspace/invocation_reasons.yaml.
 
     Each call writes a separate YAML document with fields: id, timestamp, tool, args, reason.
+    The document is written by the background log writer, so the tool call never waits on the file.
     Errors are swallowed to avoid impacting tool execution.
     """
     if not reason:
@@ -50,11 +52,8 @@ def log_invocation_reason(tool: str, reason: Optional[str], args: Optional[Dict[
     log_path = os.path.join(WORKSPACE_DIR, LOG_FILE_NAME)
 
     try:
-        # Ensure workspace directory exists (it should in runtime environments)
-        os.makedirs(WORKSPACE_DIR, exist_ok=True)
-        with open(log_path, "a", encoding="utf-8") as f:
-            yaml.safe_dump(entry, f, explicit_start=True, sort_keys=False, allow_unicode=True)
+        document = yaml.safe_dump(entry, explicit_start=True, sort_keys=False, allow_unicode=True)
+        LOG_WRITER.append(log_path, document)
     except Exception:
         # Do not break tool execution if logging fails
         pass
-
@@ -0,0 +1,145 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""In-process background jobs for long-running tools.
+
+A job wraps one coroutine (a migrate-ease scan, an APX run) in an asyncio task so the
+starting tool call returns immediately. Output lines are kept in a bounded tail that
+job_status reports, and waiters are woken on every new line so they can forward it as
+MCP progress notifications.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import time
+import uuid
+from collections import OrderedDict, deque
+from dataclasses import dataclass, field
+from typing import Any, Awaitable, Callable, Deque, Dict, List, Optional
+
+from .config import JOB_MAX_CONCURRENT, JOB_OUTPUT_TAIL_LINES, JOB_RETENTION
+
+JOB_PENDING = "pending"
+JOB_RUNNING = "running"
+JOB_SUCCEEDED = "succeeded"
+JOB_FAILED = "failed"
+JOB_CANCELLED = "cancelled"
+FINISHED_STATES = {JOB_SUCCEEDED, JOB_FAILED, JOB_CANCELLED}
+
+# Receives (stream name, line); the same shape as cli_utils.OutputCallback.
+JobOutput = Callable[[str, str], Awaitable[None]]
+
+
+@dataclass
+class Job:
+    id: str
+    tool: str
+    args: Dict[str, Any]
+    status: str = JOB_PENDING
+    created_at: float = field(default_factory=time.time)
+    started_at: Optional[float] = None
+    finished_at: Optional[float] = None
+    output_lines: int = 0
+    output_tail: Deque[str] = field(default_factory=lambda: deque(maxlen=JOB_OUTPUT_TAIL_LINES))
+    result: Any = None
+    error: Optional[str] = None
+    task: Optional[asyncio.Task] = None
+    updated: asyncio.Event = field(default_factory=asyncio.Event)
+
+    def summary(self, tail: int = 20) -> Dict[str, Any]:
+        end = self.finished_at or time.time()
+        return {
+            "job_id": self.id,
+            "tool": self.tool,
+            "args": self.args,
+            "status": self.status,
+            "created_at": self.created_at,
+            "elapsed_seconds": round(end - (self.started_at or self.created_at), 3),
+            "output_lines": self.output_lines,
+            "output_tail": list(self.output_tail)[-tail:] if tail > 0 else [],
+            "error": self.error,
+        }
+
+    def _notify(self) -> None:
+        # Wake current waiters and re-arm for the next update.
+        self.updated.set()
+        self.updated = asyncio.Event()
+
+
+class JobManager:
+    """Starts, tracks, and cancels background jobs; keeps the most recent finished jobs."""
+
+    def __init__(self, max_concurrent: int = JOB_MAX_CONCURRENT, retention: int = JOB_RETENTION):
+        self._jobs: "OrderedDict[str, Job]" = OrderedDict()
+        self._slots = asyncio.Semaphore(max(1, max_concurrent))
+        self._retention = retention
+
+    def start(self, tool: str, args: Dict[str, Any], work: Callable[[JobOutput], Awaitable[Any]]) -> Job:
+        """Schedule work(on_output) as a job and return it without waiting."""
+        job = Job(id=uuid.uuid4().hex[:12], tool=tool, args=args)
+        self._jobs[job.id] = job
+        job.task = asyncio.get_running_loop().create_task(self._run(job, work))
+        self._prune()
+        return job
+
+    def get(self, job_id: str) -> Optional[Job]:
+        return self._jobs.get(job_id)
+
+    def list(self) -> List[Job]:
+        return list(self._jobs.values())
+
+    def cancel(self, job_id: str) -> Optional[Job]:
+        job = self._jobs.get(job_id)
+        if job is not None and job.status not in FINISHED_STATES and job.task is not None:
+            job.task.cancel()
+        return job
+
+    async def wait(self, job: Job, timeout: float) -> bool:
+        """Wait up to timeout seconds for the job to produce output or finish; True if it changed."""
+        if job.status in FINISHED_STATES or timeout <= 0:
+            return False
+        try:
+            await asyncio.wait_for(job.updated.wait(), timeout=timeout)
+            return True
+        except asyncio.TimeoutError:
+            return False
+
+    async def _run(self, job: Job, work: Callable[[JobOutput], Awaitable[Any]]) -> None:
+        async def on_output(stream: str, line: str) -> None:
+            job.output_lines += 1
+            job.output_tail.append(f"[{stream}] {line}" if stream == "stderr" else line)
+            job._notify()
+
+        try:
+            async with self._slots:
+                job.status = JOB_RUNNING
+                job.started_at = time.time()
+                job._notify()
+                job.result = await work(on_output)
+            failed = isinstance(job.result, dict) and job.result.get("status") == "error"
+            job.status = JOB_FAILED if failed else JOB_SUCCEEDED
+        except asyncio.CancelledError:
+            job.status = JOB_CANCELLED
+        except Exception as exc:
+            job.status = JOB_FAILED
+            job.error = f"{type(exc).__name__}: {exc}"
+        finally:
+            job.finished_at = time.time()
+            job._notify()
+
+    def _prune(self) -> None:
+        finished = [job_id for job_id, job in self._jobs.items() if job.status in FINISHED_STATES]
+        for job_id in finished[: max(0, len(finished) - self._retention)]:
+            del self._jobs[job_id]
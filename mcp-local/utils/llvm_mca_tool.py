@@ -12,21 +12,220 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import asyncio
+import os
+import re
 from typing import Dict, Any, List, Optional
 from .cli_utils import run_command
 
+# CPUs a sweep covers by default, and the x86 CPU used as baseline when an x86 kernel is given.
+DEFAULT_SWEEP_CPUS = ["neoverse-n1", "neoverse-n2", "neoverse-v1", "neoverse-v2"]
+DEFAULT_X86_BASELINE_CPU = "icelake-server"
+AARCH64_TRIPLE = "aarch64-linux-gnu"
+X86_64_TRIPLE = "x86_64-linux-gnu"
+MCA_TIMEOUT_SECONDS = 60
+# A kernel whose cycles per iteration exceed its block throughput by this factor is bound by
+# a dependency chain (instruction latency), not by any one resource.
+LATENCY_BOUND_FACTOR = 1.1
 
-def mca_help() -> Dict[str, Any]:
-    return run_command(["llvm-mca", "--help"])
+SUMMARY_FIELDS = {
+    "Iterations": ("iterations", int),
+    "Instructions": ("instructions", int),
+    "Total Cycles": ("total_cycles", int),
+    "Total uOps": ("total_uops", int),
+    "Dispatch Width": ("dispatch_width", int),
+    "uOps Per Cycle": ("uops_per_cycle", float),
+    "IPC": ("ipc", float),
+    "Block RThroughput": ("block_rthroughput", float),
+}
+SUMMARY_RE = re.compile(r"^(?P<key>[A-Za-z ]+?):\s+(?P<value>[0-9.]+)\s*$")
+RESOURCE_RE = re.compile(r"^\[(?P<id>[0-9.]+)\]\s+-\s+(?P<name>\S+)\s*$")
+REGION_RE = re.compile(r"^\[(?P<index>\d+)\] Code Region(?: - (?P<name>.+?))?\s*$", re.MULTILINE)
+UNRECOGNIZED_CPU_RE = re.compile(r"'(?P<cpu>[^']+)' is not a recognized processor")
 
 
-def llvm_mca_analyze(input_path: str, triple: Optional[str], cpu: Optional[str], extra_args: Optional[List[str]]) -> Dict[str, Any]:
+async def mca_help() -> Dict[str, Any]:
+    return await run_command(["llvm-mca", "--help"])
+
+
+def _mca_command(input_path: str, triple: Optional[str], cpu: Optional[str], extra_args: Optional[List[str]]) -> List[str]:
     cmd = ["llvm-mca", input_path]
     if triple:
-        cmd += ["--triple", triple]
+        cmd.append(f"-mtriple={triple}")
     if cpu:
-        cmd += ["--mcpu", cpu]
+        cmd.append(f"-mcpu={cpu}")
     if extra_args:
         cmd += extra_args
-    return run_command(cmd)
+    return cmd
+
+
+async def llvm_mca_analyze(input_path: str, triple: Optional[str], cpu: Optional[str], extra_args: Optional[List[str]]) -> Dict[str, Any]:
+    return await run_command(_mca_command(input_path, triple, cpu, extra_args))
+
+
+def parse_mca_summary(stdout: str) -> Dict[str, Any]:
+    """Parse the llvm-mca summary, resources and per-iteration resource pressure into JSON.
+
+    Resources with several units (e.g. [1.0] and [1.1]) are reported once, with the pressure
+    summed over their units and the pressure of the busiest unit. The bottleneck is the
+    busiest unit, unless the kernel is latency bound (see LATENCY_BOUND_FACTOR).
+    """
+    summary: Dict[str, Any] = {}
+    resources: Dict[str, str] = {}
+    pressure_header: List[str] = []
+    pressure_values: List[str] = []
+    lines = stdout.splitlines()
+    section = None
+    for index, line in enumerate(lines):
+        stripped = line.strip()
+        if stripped == "Resources:":
+            section = "resources"
+            continue
+        if stripped == "Resource pressure per iteration:":
+            if index + 2 < len(lines):
+                pressure_header = re.findall(r"\[([0-9.]+)\]", lines[index + 1])
+                pressure_values = lines[index + 2].split()
+            section = None
+            continue
+        match = SUMMARY_RE.match(stripped)
+        if section is None and match and match.group("key") in SUMMARY_FIELDS:
+            name, cast = SUMMARY_FIELDS[match.group("key")]
+            summary.setdefault(name, cast(float(match.group("value"))) if cast is int else cast(match.group("value")))
+            continue
+        if section == "resources":
+            match = RESOURCE_RE.match(stripped)
+            if match:
+                resources[match.group("id")] = match.group("name")
+            elif stripped:
+                section = None
+
+    if summary.get("iterations") and "total_cycles" in summary:
+        summary["cycles_per_iteration"] = round(summary["total_cycles"] / summary["iterations"], 3)
+
+    pressure: Dict[str, Dict[str, Any]] = {}
+    for resource_id, value in zip(pressure_header, pressure_values):
+        name = resources.get(resource_id, resource_id)
+        unit_pressure = 0.0 if value == "-" else float(value)
+        entry = pressure.setdefault(name, {"resource": name, "units": 0, "pressure": 0.0, "max_unit_pressure": 0.0})
+        entry["units"] += 1
+        entry["pressure"] = round(entry["pressure"] + unit_pressure, 3)
+        entry["max_unit_pressure"] = max(entry["max_unit_pressure"], unit_pressure)
+    summary["resource_pressure"] = sorted(
+        (entry for entry in pressure.values() if entry["pressure"] > 0),
+        key=lambda entry: entry["max_unit_pressure"],
+        reverse=True,
+    )
+    summary["bottleneck"] = _bottleneck(summary)
+    return summary
+
+
+def parse_mca_regions(stdout: str) -> List[Dict[str, Any]]:
+    """Split output with LLVM-MCA-BEGIN/END code regions and parse each region's summary."""
+    starts = list(REGION_RE.finditer(stdout))
+    if not starts:
+        return [{"region": None, **parse_mca_summary(stdout)}]
+    regions = []
+    for index, match in enumerate(starts):
+        end = starts[index + 1].start() if index + 1 < len(starts) else len(stdout)
+        regions.append({"region": match.group("name") or match.group("index"), **parse_mca_summary(stdout[match.end():end])})
+    return regions
+
+
+def _bottleneck(summary: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+    busiest = summary["resource_pressure"][0] if summary["resource_pressure"] else None
+    cycles = summary.get("cycles_per_iteration")
+    throughput = summary.get("block_rthroughput")
+    if cycles and throughput and cycles > throughput * LATENCY_BOUND_FACTOR:
+        return {
+            "kind": "dependency_chain",
+            "detail": (
+                f"{cycles} cycles per iteration against a block throughput of {throughput}: "
+                "instruction latency on a dependency chain limits the kernel, not a resource."
+            ),
+            "busiest_resource": busiest["resource"] if busiest else None,
+        }
+    if busiest:
+        return {
+            "kind": "resource",
+            "resource": busiest["resource"],
+            "detail": f"{busiest['resource']} is busy {busiest['max_unit_pressure']} cycles per iteration.",
+        }
+    return None
+
+
+async def _sweep_target(
+    input_path: str,
+    triple: str,
+    cpu: str,
+    extra_args: Optional[List[str]],
+    semaphore: asyncio.Semaphore,
+) -> Dict[str, Any]:
+    async with semaphore:
+        result = await run_command(_mca_command(input_path, triple, cpu, extra_args), timeout=MCA_TIMEOUT_SECONDS)
+    target = {"cpu": cpu, "triple": triple, "input_path": input_path}
+    unrecognized = UNRECOGNIZED_CPU_RE.search(result.get("stderr") or "")
+    if unrecognized:
+        # llvm-mca falls back to a generic model for unknown CPUs; those numbers would mislead.
+        return {**target, "status": "error", "message": f"This llvm-mca does not model '{unrecognized.group('cpu')}'."}
+    if result["status"] != "ok":
+        return {**target, "status": "error", "message": (result.get("stderr") or "").strip()[-2000:]}
+    return {**target, "status": "ok", **parse_mca_summary(result.get("stdout") or "")}
+
+
+def _comparison_table(ranked: List[Dict[str, Any]]) -> str:
+    header = "| Rank | Target | Cycles/iter | IPC | uOps/cycle | Block RThroughput | Bottleneck |"
+    rows = [header, "|---|---|---|---|---|---|---|"]
+    for entry in ranked:
+        bottleneck = entry.get("bottleneck") or {}
+        bottleneck_text = bottleneck.get("resource") or bottleneck.get("kind", "-").replace("_", " ")
+        rows.append(
+            f"| {entry['rank']} | {entry['cpu']} | {entry.get('cycles_per_iteration', '-')} | {entry.get('ipc', '-')} "
+            f"| {entry.get('uops_per_cycle', '-')} | {entry.get('block_rthroughput', '-')} | {bottleneck_text} |"
+        )
+    return "\n".join(rows)
+
+
+async def llvm_mca_sweep(
+    input_path: str,
+    cpus: Optional[List[str]] = None,
+    triple: Optional[str] = None,
+    x86_input_path: Optional[str] = None,
+    x86_cpus: Optional[List[str]] = None,
+    extra_args: Optional[List[str]] = None,
+) -> Dict[str, Any]:
+    """Analyze one kernel on several CPUs in parallel and rank them.
+
+    input_path is analyzed for each of `cpus` (AArch64 Neoverse cores by default). An x86
+    build of the same kernel (x86_input_path) adds x86 baselines. Targets are ranked by
+    cycles per iteration, which stays comparable across ISAs where IPC does not (the two
+    kernels need different instruction counts for the same work).
+    """
+    targets = [(input_path, triple or AARCH64_TRIPLE, cpu) for cpu in (cpus or DEFAULT_SWEEP_CPUS)]
+    if x86_input_path:
+        targets += [(x86_input_path, X86_64_TRIPLE, cpu) for cpu in (x86_cpus or [DEFAULT_X86_BASELINE_CPU])]
+    semaphore = asyncio.Semaphore(max(1, os.cpu_count() or 1))
+    results = await asyncio.gather(
+        *(_sweep_target(path, target_triple, cpu, extra_args, semaphore) for path, target_triple, cpu in targets)
+    )
 
+    analyzed = [r for r in results if r["status"] == "ok" and "cycles_per_iteration" in r]
+    ranked = sorted(analyzed, key=lambda r: (r["cycles_per_iteration"], -r.get("ipc", 0)))
+    comparison = []
+    for rank, entry in enumerate(ranked, start=1):
+        entry["rank"] = rank
+        comparison.append({
+            key: entry.get(key)
+            for key in ("rank", "cpu", "triple", "cycles_per_iteration", "ipc", "uops_per_cycle", "block_rthroughput", "bottleneck")
+        })
+    best = ranked[0]["cycles_per_iteration"] if ranked else None
+    for row in comparison:
+        row["relative_to_best"] = round(row["cycles_per_iteration"] / best, 3) if best else None
+    return {
+        "status": "ok" if analyzed else "error",
+        "targets": len(results),
+        "analyzed": len(analyzed),
+        "comparison": comparison,
+        "table": _comparison_table(ranked),
+        "results": results,
+        "errors": [{"cpu": r["cpu"], "message": r["message"]} for r in results if r["status"] == "error"],
+    }
@@ -0,0 +1,327 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compile C/C++ sources to assembly and run llvm-mca on their hot loops.
+
+The source is compiled with -S for the requested CPU and vector extension. When the source
+already carries LLVM-MCA-BEGIN/END markers, llvm-mca analyzes those regions of the whole
+file. Otherwise each requested function is cut out of the assembly and its innermost loops
+(a backward branch to a label inside the function) become the analyzed regions. A function
+without loops is analyzed as a whole.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import os
+import platform
+import re
+import shutil
+import tempfile
+from dataclasses import dataclass
+from typing import Any, Dict, List, Optional, Tuple
+
+from .cli_utils import run_command
+from .llvm_mca_tool import AARCH64_TRIPLE, MCA_TIMEOUT_SECONDS, UNRECOGNIZED_CPU_RE, parse_mca_regions
+
+COMPILE_TIMEOUT_SECONDS = 120
+CXX_SUFFIXES = {".cc", ".cpp", ".cxx", ".c++", ".C"}
+OPT_LEVELS = {"O1", "O2", "O3", "Ofast"}
+# -mcpu suffixes for the compiler and -mattr values for llvm-mca, per vector mode.
+VECTOR_MODES: Dict[str, Tuple[str, Optional[str]]] = {
+    "auto": ("", None),
+    "neon": ("+nosve", "-sve"),
+    "sve": ("+sve", "+sve"),
+    "sve2": ("+sve2", "+sve2"),
+    "none": ("", None),
+}
+MARKER = "LLVM-MCA-BEGIN"
+# Lines kept from an extracted region, shown so results can be matched to the code.
+REGION_ASM_MAX_LINES = 60
+
+LABEL_RE = re.compile(r"^(?P<label>[A-Za-z_.$][\w.$]*):")
+FUNCTION_TYPE_RE = re.compile(r"^\s*\.type\s+(?P<symbol>[^,\s]+)\s*,\s*[@%]function")
+AARCH64_BRANCHES = {"b", "cbz", "cbnz", "tbz", "tbnz"}
+
+
+@dataclass
+class AsmLine:
+    text: str
+    label: Optional[str] = None
+    branch_target: Optional[str] = None
+
+    @property
+    def is_instruction(self) -> bool:
+        return self.label is None
+
+
+def _comment_prefix(triple: str) -> str:
+    return "#" if triple.startswith(("x86", "i386", "i686")) else "//"
+
+
+def _host_arch() -> str:
+    machine = platform.machine().lower()
+    return {"arm64": "aarch64", "amd64": "x86_64"}.get(machine, machine)
+
+
+def gcc_driver(triple: str, cxx: bool) -> str:
+    """gcc/g++ when the host builds for triple natively, else the Debian cross driver, e.g. aarch64-linux-gnu-gcc.
+
+    gcc cannot switch targets with a flag, so on an amd64 host the cross toolchain is required.
+    """
+    name = "g++" if cxx else "gcc"
+    return name if triple.split("-", 1)[0] == _host_arch() else f"{triple}-{name}"
+
+
+def compile_command(
+    source_path: str,
+    output_path: str,
+    compiler: str,
+    cpu: str,
+    opt_level: str,
+    vector: str,
+    triple: str,
+    extra_flags: Optional[List[str]],
+) -> List[str]:
+    cxx = os.path.splitext(source_path)[1] in CXX_SUFFIXES
+    if compiler == "gcc":
+        cmd = [gcc_driver(triple, cxx)]
+    else:
+        cmd = ["clang++" if cxx else "clang", f"--target={triple}"]
+    x86 = triple.startswith("x86")
+    cmd += ["-S", f"-{opt_level}", "-fno-asynchronous-unwind-tables"]
+    cmd.append(f"-march={cpu}" if x86 else f"-mcpu={cpu}{VECTOR_MODES[vector][0]}")
+    if vector == "none":
+        cmd += ["-fno-tree-vectorize"] if compiler == "gcc" else ["-fno-vectorize", "-fno-slp-vectorize"]
+    cmd += list(extra_flags or [])
+    cmd += ["-o", output_path, source_path]
+    return cmd
+
+
+def _parse_asm(lines: List[str], triple: str) -> List[AsmLine]:
+    """Labels and instructions of one function; directives and comments are dropped."""
+    comment = _comment_prefix(triple)
+    parsed: List[AsmLine] = []
+    for line in lines:
+        text = line.split(comment, 1)[0].strip() if comment in line else line.strip()
+        match = LABEL_RE.match(text)
+        if match:
+            parsed.append(AsmLine(text=f"{match.group('label')}:", label=match.group("label")))
+            text = text[match.end():].strip()
+        if not text or text.startswith("."):
+            continue
+        mnemonic, *rest = text.split(None, 1)
+        mnemonic = mnemonic.lower()
+        operands = rest[0].strip() if rest else ""
+        is_branch = (
+            mnemonic.startswith("j")
+            if comment == "#"
+            else mnemonic in AARCH64_BRANCHES or mnemonic.startswith("b.")
+        )
+        target = operands.split(",")[-1].strip() if is_branch and operands else None
+        parsed.append(AsmLine(text=f"\t{text}", branch_target=target))
+    return parsed
+
+
+def function_symbols(asm: str) -> List[str]:
+    return [m.group("symbol") for m in map(FUNCTION_TYPE_RE.match, asm.splitlines()) if m]
+
+
+def match_symbol(name: str, symbols: List[str]) -> Optional[str]:
+    """The assembly symbol for a function name as a profiler reports it.
+
+    Accepts plain C names, C++ names such as 'Matrix::multiply(float*)', and mangled names.
+    """
+    if name in symbols:
+        return name
+    plain = re.sub(r"\(.*$", "", name).strip().split("::")[-1].split(" ")[-1]
+    if plain in symbols:
+        return plain
+    # Itanium mangling spells each name component as <length><identifier>.
+    mangled = f"{len(plain)}{plain}"
+    # The identifier is followed by E (end of a nested name), I (template args) or the first
+    # parameter type, which starts with a lower-case builtin or a qualifier/pointer capital.
+    component_re = re.compile(rf"(?<!\d){re.escape(mangled)}(?:[EIPRSKC]|[a-z]|$)")
+    candidates = [s for s in symbols if s.startswith("_Z") and component_re.search(s)]
+    return min(candidates, key=len) if candidates else None
+
+
+def extract_function(asm: str, symbol: str) -> List[str]:
+    lines = asm.splitlines()
+    try:
+        start = next(i for i, line in enumerate(lines) if line.strip() == f"{symbol}:")
+    except StopIteration:
+        return []
+    body: List[str] = []
+    for line in lines[start + 1:]:
+        stripped = line.strip()
+        if stripped.startswith((".Lfunc_end", f".size\t{symbol}", f".size {symbol}", ".cfi_endproc")):
+            break
+        body.append(line)
+    return body
+
+
+def innermost_loops(parsed: List[AsmLine]) -> List[Tuple[int, int]]:
+    """(label index, branch index) of every loop that contains no other loop."""
+    label_at = {line.label: index for index, line in enumerate(parsed) if line.label}
+    loops = sorted(
+        {
+            (label_at[line.branch_target], index)
+            for index, line in enumerate(parsed)
+            if line.branch_target in label_at and label_at[line.branch_target] < index
+        }
+    )
+    return [
+        (start, end)
+        for start, end in loops
+        if not any(s >= start and e <= end and (s, e) != (start, end) for s, e in loops)
+    ]
+
+
+def build_regions(function: str, parsed: List[AsmLine], triple: str) -> Tuple[str, List[Dict[str, Any]]]:
+    """Assembly for llvm-mca with one marked region per innermost loop (or the whole function)."""
+    comment = _comment_prefix(triple)
+    loops = innermost_loops(parsed)
+    spans = loops or [(0, len(parsed) - 1)]
+    regions: List[Dict[str, Any]] = []
+    text: List[str] = []
+    for number, (start, end) in enumerate(spans):
+        name = f"{function}:loop{number}" if loops else function
+        body = [line.text for line in parsed[start:end + 1]]
+        text += [f"{comment} {MARKER} {name}", *body, f"{comment} LLVM-MCA-END"]
+        instructions = [line.text.strip() for line in parsed[start:end + 1] if line.is_instruction]
+        regions.append({
+            "region": name,
+            "kind": "loop" if loops else "function",
+            "region_instructions": len(instructions),
+            "asm": "\n".join(instructions[:REGION_ASM_MAX_LINES]),
+        })
+    return "\n".join(text) + "\n", regions
+
+
+async def _run_mca(asm_path: str, triple: str, cpu: str, vector: str) -> Dict[str, Any]:
+    cmd = ["llvm-mca", asm_path, f"-mtriple={triple}", f"-mcpu={cpu}"]
+    mattr = VECTOR_MODES[vector][1]
+    if mattr and not triple.startswith("x86"):
+        cmd.append(f"-mattr={mattr}")
+    result = await run_command(cmd, timeout=MCA_TIMEOUT_SECONDS)
+    unrecognized = UNRECOGNIZED_CPU_RE.search(result.get("stderr") or "")
+    if unrecognized:
+        return {"status": "error", "message": f"This llvm-mca does not model '{unrecognized.group('cpu')}'.", "cmd": cmd}
+    if result["status"] != "ok":
+        return {"status": "error", "message": (result.get("stderr") or "").strip()[-2000:], "cmd": cmd}
+    return {"status": "ok", "regions": parse_mca_regions(result.get("stdout") or ""), "cmd": cmd}
+
+
+def _merge_regions(described: List[Dict[str, Any]], analyzed: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+    by_name = {region.get("region"): region for region in analyzed}
+    return [{**region, **by_name.get(region["region"], {})} for region in described]
+
+
+async def compile_and_analyze(
+    source_path: str,
+    functions: Optional[List[str]] = None,
+    cpu: str = "neoverse-v1",
+    opt_level: str = "O3",
+    vector: str = "auto",
+    compiler: str = "clang",
+    triple: str = AARCH64_TRIPLE,
+    extra_flags: Optional[List[str]] = None,
+) -> Dict[str, Any]:
+    """Compile source_path for cpu and analyze the given functions (or its marked regions)."""
+    opt_level = opt_level.lstrip("-")
+    if opt_level not in OPT_LEVELS:
+        raise ValueError(f"opt_level must be one of {sorted(OPT_LEVELS)}")
+    if vector not in VECTOR_MODES:
+        raise ValueError(f"vector must be one of {sorted(VECTOR_MODES)}")
+    if compiler not in {"clang", "gcc"}:
+        raise ValueError("compiler must be 'clang' or 'gcc'")
+    if not os.path.isfile(source_path):
+        return {"status": "error", "message": f"Source file not found: {source_path}"}
+    with open(source_path, "r", encoding="utf-8", errors="replace") as file:
+        has_markers = MARKER in file.read()
+    if not functions and not has_markers:
+        return {
+            "status": "error",
+            "message": "Name the functions to analyze, or mark regions in the source with LLVM-MCA-BEGIN/LLVM-MCA-END.",
+        }
+
+    work_dir = tempfile.mkdtemp(prefix="mca_compile_", dir="/tmp")
+    try:
+        asm_path = os.path.join(work_dir, "source.s")
+        cmd = compile_command(source_path, asm_path, compiler, cpu, opt_level, vector, triple, extra_flags)
+        compiled = await run_command(cmd, timeout=COMPILE_TIMEOUT_SECONDS)
+        compile_info = {"cmd": cmd, "warnings": (compiled.get("stderr") or "").strip()[-4000:]}
+        if compiled["status"] != "ok":
+            return {"status": "error", "stage": "compile", "message": "Compilation failed.", "compile": compile_info}
+        with open(asm_path, "r", encoding="utf-8", errors="replace") as file:
+            asm = file.read()
+
+        result: Dict[str, Any] = {"status": "ok", "source": source_path, "cpu": cpu, "vector": vector, "compile": compile_info}
+        if has_markers and not functions:
+            analysis = await _run_mca(asm_path, triple, cpu, vector)
+            result.update(status=analysis["status"], regions=analysis.get("regions", []), message=analysis.get("message"))
+            return result
+
+        symbols = function_symbols(asm)
+        analyses: Dict[str, Any] = {}
+        not_found: List[str] = []
+
+        async def analyze(name: str, symbol: str) -> None:
+            parsed = _parse_asm(extract_function(asm, symbol), triple)
+            if not any(line.is_instruction for line in parsed):
+                analyses[name] = {"symbol": symbol, "status": "error", "message": "Function body is empty."}
+                return
+            region_asm, regions = build_regions(name, parsed, triple)
+            region_path = os.path.join(work_dir, f"{len(analyses)}_{re.sub(r'[^A-Za-z0-9_]', '_', symbol)[:80]}.s")
+            with open(region_path, "w", encoding="utf-8") as file:
+                file.write(region_asm)
+            analyses[name] = {"symbol": symbol, "status": "pending"}
+            analysis = await _run_mca(region_path, triple, cpu, vector)
+            entry = {"symbol": symbol, "status": analysis["status"]}
+            if analysis["status"] == "ok":
+                entry["regions"] = _merge_regions(regions, analysis["regions"])
+            else:
+                entry["message"] = analysis["message"]
+            analyses[name] = entry
+
+        tasks = []
+        for name in dict.fromkeys(functions or []):
+            symbol = match_symbol(name, symbols)
+            if symbol is None:
+                not_found.append(name)
+            else:
+                tasks.append(analyze(name, symbol))
+        await asyncio.gather(*tasks)
+        result["functions"] = analyses
+        result["not_found"] = not_found
+        if not analyses:
+            result["status"] = "error"
+            result["message"] = "None of the functions are defined in this source file."
+        return result
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+
+async def hotspot_functions(run_id: str, apx_dir: str, top_n: int = 5) -> Tuple[List[str], Optional[Dict[str, Any]]]:
+    """Function names of the top code_hotspots of an APX run, busiest first."""
+    from .apx import get_results
+
+    results = await get_results(
+        {"value": run_id}, "code_hotspots", apx_dir, query_name="top_functions", params={"top_n": top_n}
+    )
+    if results.get("status") == "error":
+        return [], results
+    names = [row.get("function_name") for row in results.get("rows", [])]
+    return [name for name in dict.fromkeys(names) if isinstance(name, str) and name != "EMPTY_SYMBOLS"], None
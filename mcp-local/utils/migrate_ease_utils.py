@@ -12,7 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Dict, Any, List, Optional, Set
+from typing import Dict, Any, List, Optional, Set, Union
+import asyncio
 import os
 import time
 import shlex
@@ -20,7 +21,20 @@ import subprocess
 import json
 import tempfile
 import shutil
-from .config import SUPPORTED_SCANNERS, WORKSPACE_DIR
+import uuid
+from .cli_utils import OutputCallback, run_process
+from .config import (
+    MIGRATE_EASE_CACHE,
+    MIGRATE_EASE_CACHE_MAX_CHANGED_FRACTION,
+    MIGRATE_EASE_GIT_CACHE,
+    MIGRATE_EASE_PARALLELISM,
+    MIGRATE_EASE_SPARSE_CHECKOUT,
+    SUPPORTED_SCANNERS,
+    WORKSPACE_DIR,
+    WORKSPACE_VIEW_MODE,
+)
+from . import git_cache
+from .scan_cache import ScanCache, fingerprint_tree, link_subset
 
 # Directories and patterns to exclude from migrate-ease scans
 EXCLUDE_PATTERNS: Set[str] = {
@@ -37,6 +51,8 @@ EXCLUDE_PATTERNS: Set[str] = {
     '.vscode', '.idea', '.eclipse',
     # Other common build/cache directories
     'target', 'out', '.cache',
+    # Server state kept in the workspace (scan and search caches)
+    '.arm-mcp',
 }
 
 
@@ -77,37 +93,75 @@ def _should_exclude(name: str) -> bool:
     return False
 
 
-def _create_filtered_workspace(source_dir: str) -> tuple[str, List[str]]:
+def resolve_scanners(scanner: Union[str, List[str]]) -> List[str]:
     """
-    Create a temporary filtered copy of the workspace, excluding virtual environments
+    Expand a scanner argument into scanner names: "all" means every supported scanner,
+    and a list or comma-separated string names several. Duplicates are dropped.
+    """
+    names = scanner.split(",") if isinstance(scanner, str) else list(scanner)
+    resolved: List[str] = []
+    for name in names:
+        name = name.strip()
+        if not name:
+            continue
+        expanded = sorted(SUPPORTED_SCANNERS) if name.lower() == "all" else [_normalize_scanner(name)]
+        resolved.extend(s for s in expanded if s not in resolved)
+    return resolved
+
+
+def _link_file(src_path: str, dst_path: str, same_device: bool) -> None:
+    """Materialize one workspace file in the view without copying its data."""
+    if same_device:
+        try:
+            os.link(src_path, dst_path)
+            return
+        except OSError:
+            pass
+    os.symlink(src_path, dst_path)
+
+
+def _create_filtered_workspace(source_dir: str, mode: str = WORKSPACE_VIEW_MODE) -> tuple[str, List[str]]:
+    """
+    Create a temporary filtered view of the workspace, excluding virtual environments
     and dependency directories to avoid scanning irrelevant files.
 
+    In "link" mode (the default) only the directory skeleton is created; every file is
+    hardlinked when /tmp shares a filesystem with the workspace and symlinked to its
+    workspace path otherwise, so the view costs no file data. "copy" mode keeps the
+    original full copy for scanners that must not see links.
+
     Args:
         source_dir: The source directory to filter
+        mode: "link" or "copy"
 
     Returns:
         Tuple of (filtered_directory_path, list_of_excluded_items)
     """
     filtered_dir = tempfile.mkdtemp(prefix="migrate_ease_filtered_", dir="/tmp")
     excluded_items: List[str] = []
+    copy_files = mode == "copy"
+    try:
+        same_device = os.stat(source_dir).st_dev == os.stat(filtered_dir).st_dev
+    except OSError:
+        same_device = False
 
     def copy_tree(src: str, dst: str, base_src: str = None) -> None:
-        """Recursively copy directory tree, excluding filtered items."""
+        """Recursively mirror directory tree, excluding filtered items."""
         if base_src is None:
             base_src = src
 
         try:
-            items = os.listdir(src)
+            entries = list(os.scandir(src))
         except (PermissionError, FileNotFoundError) as e:
             # Skip directories we can't read
             return
 
-        for item in items:
-            src_path = os.path.join(src, item)
-            dst_path = os.path.join(dst, item)
+        for entry in entries:
+            src_path = entry.path
+            dst_path = os.path.join(dst, entry.name)
 
             # Check if this item should be excluded
-            if _should_exclude(item):
+            if _should_exclude(entry.name):
                 # Track relative path for reporting
                 rel_path = os.path.relpath(src_path, base_src)
                 excluded_items.append(rel_path)
@@ -115,7 +169,7 @@ def _create_filtered_workspace(source_dir: str) -> tuple[str, List[str]]:
 
             try:
                 # Handle symlinks carefully to avoid the broken symlink issue
-                if os.path.islink(src_path):
+                if entry.is_symlink():
                     # Check if symlink target exists
                     if not os.path.exists(src_path):
                         # Skip broken symlinks
@@ -125,50 +179,273 @@ def _create_filtered_workspace(source_dir: str) -> tuple[str, List[str]]:
                     # Copy the symlink itself, not its target
                     linkto = os.readlink(src_path)
                     os.symlink(linkto, dst_path)
-                elif os.path.isdir(src_path):
-                    # Recursively copy directory
+                elif entry.is_dir(follow_symlinks=False):
+                    # Recursively mirror directory
                     os.makedirs(dst_path, exist_ok=True)
                     copy_tree(src_path, dst_path, base_src)
-                else:
+                elif copy_files:
                     # Copy regular file
                     shutil.copy2(src_path, dst_path)
+                else:
+                    _link_file(src_path, dst_path, same_device)
             except (PermissionError, OSError) as e:
                 # Skip items we can't copy
                 rel_path = os.path.relpath(src_path, base_src)
                 excluded_items.append(f"{rel_path} (error: {e})")
                 continue
 
-    # Perform the filtered copy
+    # Build the filtered view
     copy_tree(source_dir, filtered_dir)
 
     return filtered_dir, excluded_items
 
 
+def _fingerprint_view(view_dir: str, scanners: List[str], arch: str) -> Dict[str, Dict[str, Any]]:
+    """Fingerprint a shared view once for several scanners, reusing hashes any of their caches hold."""
+    previous: Dict[str, Dict[str, Any]] = {}
+    for scanner in scanners:
+        previous.update(ScanCache.load(_normalize_scanner(scanner), arch).files)
+    return fingerprint_tree(view_dir, previous)
+
+
+def _plan_cached_scan(
+    scanner: str, arch: str, view_dir: str, files: Optional[Dict[str, Dict[str, Any]]] = None
+) -> Dict[str, Any]:
+    """
+    Decide how much of a filtered workspace view migrate-ease has to scan.
+
+    Returns a plan with the loaded cache, the current file fingerprints and a mode:
+    "full" scans the whole view, "incremental" scans only the changed files (linked into
+    plan["subset_dir"]), and "cached" means no file changed and the report comes from the cache.
+    files, when given, are the view's fingerprints computed once for every scanner of a request.
+    A change to a header, build file or dependency manifest forces a full scan, since it can
+    change the findings of files whose own content did not change.
+    """
+    cache = ScanCache.load(scanner, arch)
+    if files is None:
+        files = fingerprint_tree(view_dir, cache.files)
+    changed = cache.changed_files(files)
+    plan: Dict[str, Any] = {"cache": cache, "files": files, "mode": "full", "scan": sorted(files), "subset_dir": None}
+    if not cache.can_merge(files) or len(changed) > MIGRATE_EASE_CACHE_MAX_CHANGED_FRACTION * len(files):
+        return plan
+    if not changed:
+        plan.update(mode="cached", scan=[])
+        return plan
+    subset_dir = tempfile.mkdtemp(prefix="migrate_ease_changed_", dir="/tmp")
+    plan["subset_dir"], plan["scan"] = link_subset(view_dir, changed, subset_dir)
+    plan["mode"] = "incremental"
+    return plan
+
+
+def _finish_cached_scan(
+    plan: Dict[str, Any], report: Optional[Dict[str, Any]], scan_root: str, report_root: str = WORKSPACE_DIR
+) -> Dict[str, Any]:
+    """Merge a scan report with the cached findings, persist the cache, and return the report.
+
+    scan_root is the (temporary) directory migrate-ease scanned; the returned report gives
+    paths under report_root, the workspace the view mirrors, whatever the plan's mode.
+    """
+    cache: ScanCache = plan["cache"]
+    if plan["mode"] == "cached":
+        merged = cache.cached_report(plan["files"], report_root)
+    else:
+        merged = cache.record(
+            report, scan_root, plan["scan"], plan["files"], full=plan["mode"] == "full", report_root=report_root
+        )
+    # A report with scanner errors may be missing findings, so it is returned but not cached.
+    if not (report or {}).get("errors"):
+        cache.save()
+    return merged
+
+
+def _uses_scan_cache(output_format: str, extra_args: Optional[List[str]]) -> bool:
+    # Extra args may change what is reported, so those scans always cover the whole workspace.
+    return MIGRATE_EASE_CACHE and output_format.lower().lstrip(".") == "json" and not extra_args
+
+
 def _build_output_path(scanner: str, output_format: str) -> str:
     ts = time.strftime("%Y%m%d-%H%M%S")
     suffix = output_format.lower().lstrip(".")
-    # Always put results into /tmp to avoid permission issues
-    return f"/tmp/migrate_ease_{scanner}_{ts}.{suffix}"
+    # Always put results into /tmp to avoid permission issues. The random part keeps scans of
+    # the same scanner started within one second (concurrent jobs) from sharing a file.
+    return f"/tmp/migrate_ease_{scanner}_{ts}_{uuid.uuid4().hex[:12]}.{suffix}"
+
+
+async def run_migrate_ease_scan(
+    scanner: Union[str, List[str]],
+    arch: str,
+    git_repo: Optional[str],
+    output_format: str,
+    extra_args: Optional[List[str]] = None,
+    on_output: Optional[OutputCallback] = None,
+    git_ref: Optional[str] = None,
+) -> Dict[str, Any]:
+    """
+    Run one migrate-ease scanner, or several when scanner is "all", a list, or a
+    comma-separated string (see run_migrate_ease_scans).
+    """
+    if git_repo:
+        # Checked before any git or migrate-ease command sees them, cached clone or not.
+        try:
+            await git_cache.validate_remote(git_repo, git_ref)
+        except git_cache.GitCacheError as e:
+            return {"status": "error", "message": str(e)}
+    scanners = resolve_scanners(scanner)
+    if len(scanners) == 1 and not (isinstance(scanner, str) and scanner.strip().lower() == "all"):
+        return await _run_single_scan(scanners[0], arch, git_repo, output_format, extra_args, on_output, git_ref=git_ref)
+    return await run_migrate_ease_scans(scanners, arch, git_repo, output_format, extra_args, on_output, git_ref=git_ref)
 
 
-def run_migrate_ease_scan(
+async def _checkout_remote(
+    git_repo: str, git_ref: Optional[str], scanners: List[str], on_output: Optional[OutputCallback]
+) -> git_cache.GitCheckout:
+    patterns = git_cache.sparse_patterns(scanners) if MIGRATE_EASE_SPARSE_CHECKOUT else None
+    return await git_cache.checkout(git_repo, git_ref, patterns, on_output=on_output)
+
+
+async def run_migrate_ease_scans(
+    scanners: List[str],
+    arch: str,
+    git_repo: Optional[str],
+    output_format: str,
+    extra_args: Optional[List[str]] = None,
+    on_output: Optional[OutputCallback] = None,
+    parallelism: int = MIGRATE_EASE_PARALLELISM,
+    git_ref: Optional[str] = None,
+) -> Dict[str, Any]:
+    """
+    Run several scanners concurrently, at most `parallelism` at a time, and merge their reports.
+
+    Local scans share one filtered workspace view, built once and removed after the last
+    scanner finishes; remote scans likewise share one checkout of git_repo from the clone
+    cache. Output lines are forwarded to on_output prefixed with the scanner name.
+
+    Returns:
+        A dictionary with an overall status (error if any scanner failed), the per-scanner
+        results and timings, total_issue_count over all JSON reports, and for local scans the
+        workspace listing and excluded items once rather than per scanner.
+    """
+    if not scanners:
+        return {"status": "error", "message": "No scanners requested."}
+
+    started = time.monotonic()
+    workspace_view: Optional[tuple] = None
+    view_error: Optional[str] = None
+    remote: Optional[git_cache.GitCheckout] = None
+    if git_repo and MIGRATE_EASE_GIT_CACHE:
+        try:
+            remote = await _checkout_remote(git_repo, git_ref, scanners, on_output)
+        except Exception as e:
+            # Each scanner then tries the clone cache (or its own clone) again.
+            view_error = f"Failed to check out {git_repo} from the clone cache: {e}"
+    elif not git_repo:
+        try:
+            workspace_view = await asyncio.to_thread(_create_filtered_workspace, WORKSPACE_DIR)
+        except Exception as e:
+            # Each scanner then falls back to building its own view.
+            view_error = f"Failed to create shared filtered workspace: {e}"
+    view_files: Optional[Dict[str, Dict[str, Any]]] = None
+    if workspace_view is not None and _uses_scan_cache(output_format, extra_args):
+        try:
+            # Stat and hash the shared view once, rather than once per scanner's cache.
+            view_files = await asyncio.to_thread(_fingerprint_view, workspace_view[0], scanners, arch)
+        except Exception:
+            # Each scanner then fingerprints the view itself (and reports any error).
+            view_files = None
+
+    slots = asyncio.Semaphore(max(1, parallelism))
+    timings: Dict[str, float] = {}
+
+    async def scan(name: str) -> Dict[str, Any]:
+        async def prefixed(stream: str, line: str) -> None:
+            await on_output(stream, f"[{name}] {line}")
+
+        async with slots:
+            scan_started = time.monotonic()
+            try:
+                return await _run_single_scan(
+                    name, arch, git_repo, output_format, extra_args,
+                    on_output=prefixed if on_output is not None else None,
+                    workspace_view=workspace_view,
+                    git_ref=git_ref,
+                    remote=remote,
+                    view_files=view_files,
+                )
+            finally:
+                timings[name] = round(time.monotonic() - scan_started, 3)
+
+    try:
+        outcomes = await asyncio.gather(*(scan(name) for name in scanners), return_exceptions=True)
+    finally:
+        if workspace_view is not None:
+            await asyncio.to_thread(shutil.rmtree, workspace_view[0], ignore_errors=True)
+        if remote is not None:
+            await git_cache.release(remote)
+
+    results: Dict[str, Dict[str, Any]] = {}
+    for name, outcome in zip(scanners, outcomes):
+        if isinstance(outcome, asyncio.CancelledError):
+            raise outcome
+        if isinstance(outcome, BaseException):
+            outcome = {"status": "error", "message": f"{type(outcome).__name__}: {outcome}"}
+        results[name] = outcome
+
+    merged: Dict[str, Any] = {
+        "status": "success" if all(r.get("status") == "success" for r in results.values()) else "error",
+        "scanners": scanners,
+        "parallelism": max(1, parallelism),
+        "elapsed_seconds": round(time.monotonic() - started, 3),
+        "timings": timings,
+        "results": results,
+    }
+    issue_counts = {
+        name: r["parsed_results"].get("total_issue_count", len(r["parsed_results"].get("issues") or []))
+        for name, r in results.items()
+        if isinstance(r.get("parsed_results"), dict)
+    }
+    if issue_counts:
+        merged["issue_counts"] = issue_counts
+        merged["total_issue_count"] = sum(issue_counts.values())
+    # The listing and exclusions describe the shared view, so report them once.
+    for key in ("workspace_listing", "workspace_listing_error", "excluded_items", "excluded_count"):
+        for r in results.values():
+            if key in r:
+                merged.setdefault(key, r.pop(key))
+    if view_error:
+        merged["workspace_view_error"] = view_error
+    return merged
+
+
+async def _run_single_scan(
     scanner: str,
     arch: str,
     git_repo: Optional[str],
     output_format: str,
     extra_args: Optional[List[str]] = None,
+    on_output: Optional[OutputCallback] = None,
+    workspace_view: Optional[tuple] = None,
+    git_ref: Optional[str] = None,
+    remote: Optional[git_cache.GitCheckout] = None,
+    view_files: Optional[Dict[str, Dict[str, Any]]] = None,
 ) -> Dict[str, Any]:
     """
     Execute migrate-ease via unified CLI wrappers installed in /usr/local/bin:
     'migrate-ease-{scanner}' (e.g., migrate-ease-cpp, migrate-ease-python, migrate-ease-go, migrate-ease-js, migrate-ease-java).
 
-    NOTE: Local scans now use a filtered copy of WORKSPACE_DIR (/workspace) that excludes
+    NOTE: Local scans now use a filtered view of WORKSPACE_DIR (/workspace) that excludes
     virtual environments, dependency directories, and build artifacts to improve scan
-    performance and avoid errors from broken symlinks. Remote repository scans are staged
-    inside a temporary directory under /tmp that is removed after execution. The migrate-ease
+    performance and avoid errors from broken symlinks. By default the view links files instead
+    of copying them (see WORKSPACE_VIEW_MODE). Remote repository scans check out git_ref
+    (default: the remote HEAD) from a cached depth-1 blobless mirror under /workspace into a
+    temporary worktree under /tmp, or, with the clone cache disabled, let migrate-ease clone
+    into a temporary directory; either is removed after execution. The migrate-ease
     output file is created under /tmp and is **deleted** before this function returns.
     A best-effort deletion flag is included in the returned dictionary as 'output_file_deleted'.
     For local scans, a listing of excluded items is included in the result.
+    Scanner output is also passed line by line to on_output while the scan runs.
+    A workspace_view (directory, excluded items) or remote checkout prepared by the caller
+    is scanned instead of a new one and left in place; view_files are that view's fingerprints
+    when the caller already computed them.
     """
     normalized_scanner = _normalize_scanner(scanner)
     fmt = output_format.lower().lstrip(".")
@@ -187,26 +464,67 @@ def run_migrate_ease_scan(
     workspace_listing: Optional[List[str]] = None
     workspace_listing_error: Optional[str] = None
     excluded_items: Optional[List[str]] = None
+    scan_plan: Optional[Dict[str, Any]] = None
+    scan_cache_error: Optional[str] = None
+    owned_remote: Optional[git_cache.GitCheckout] = None
+    git_cache_error: Optional[str] = None
 
     try:
         # Route: git repo vs workspace scan
         if git_repo:
-            # Always stage remote scans inside a temporary workspace that is cleaned up later
-            temporary_clone_dir = tempfile.mkdtemp(prefix="migrate_ease_clone_", dir="/tmp")
-            cmd.extend(["--git-repo", git_repo, temporary_clone_dir])
-            resolved_for_echo = temporary_clone_dir
+            if remote is None and MIGRATE_EASE_GIT_CACHE:
+                try:
+                    remote = owned_remote = await _checkout_remote(
+                        git_repo, git_ref, [normalized_scanner], on_output
+                    )
+                except Exception as e:
+                    git_cache_error = f"Clone cache unavailable: {e}"
+            if remote is not None:
+                cmd.append(remote.path)
+                resolved_for_echo = f"{git_repo}@{remote.commit}"
+            elif git_ref:
+                return {
+                    "status": "error",
+                    "message": f"Cannot scan git_ref '{git_ref}' without the clone cache.",
+                    "git_cache_error": git_cache_error or "MIGRATE_EASE_GIT_CACHE is disabled.",
+                }
+            else:
+                # Always stage remote scans inside a temporary workspace that is cleaned up later
+                temporary_clone_dir = tempfile.mkdtemp(prefix="migrate_ease_clone_", dir="/tmp")
+                cmd.extend(["--git-repo", git_repo, temporary_clone_dir])
+                resolved_for_echo = temporary_clone_dir
         else:
-            # Create a filtered copy of the workspace to exclude venvs, node_modules, etc.
+            # Create a filtered view of the workspace to exclude venvs, node_modules, etc.
+            # The copy is blocking file I/O, so it runs on a worker thread.
             try:
-                filtered_workspace_dir, excluded_items = _create_filtered_workspace(WORKSPACE_DIR)
-                cmd.append(filtered_workspace_dir)
+                if workspace_view is not None:
+                    view_dir, excluded_items = workspace_view
+                else:
+                    filtered_workspace_dir, excluded_items = await asyncio.to_thread(
+                        _create_filtered_workspace, WORKSPACE_DIR
+                    )
+                    view_dir = filtered_workspace_dir
                 resolved_for_echo = f"{WORKSPACE_DIR} (filtered)"
+                scan_target = view_dir
 
                 # Get listing of what's in the filtered workspace
                 try:
-                    workspace_listing = sorted(os.listdir(filtered_workspace_dir))
+                    workspace_listing = sorted(os.listdir(view_dir))
                 except Exception as e:
                     workspace_listing_error = f"Failed to list filtered workspace contents: {e}"
+
+                # Reuse per-file findings from earlier scans; extra args may change what is
+                # reported, so those scans always cover the whole workspace.
+                if _uses_scan_cache(fmt, extra_args):
+                    try:
+                        scan_plan = await asyncio.to_thread(
+                            _plan_cached_scan, normalized_scanner, arch, view_dir,
+                            view_files if workspace_view is not None else None,
+                        )
+                        scan_target = scan_plan["subset_dir"] or view_dir
+                    except Exception as e:
+                        scan_cache_error = f"Scan cache unavailable (scanning the whole workspace): {e}"
+                cmd.append(scan_target)
             except Exception as e:
                 # If filtering fails, fall back to scanning the original workspace
                 # but note the error
@@ -222,13 +540,17 @@ def run_migrate_ease_scan(
         if extra_args:
             cmd.extend(extra_args)
 
-        # Run (no special cwd required when using wrappers)
-        proc = subprocess.run(
-            cmd,
-            capture_output=True,
-            text=True,
-            timeout=60 * 30,  # 30 minutes max
-        )
+        if scan_plan is not None and scan_plan["mode"] == "cached":
+            proc = subprocess.CompletedProcess(
+                cmd, 0, "No files changed since the cached scan; migrate-ease was not run.\n", ""
+            )
+        else:
+            # Run (no special cwd required when using wrappers)
+            proc = await run_process(
+                cmd,
+                timeout=60 * 30,  # 30 minutes max
+                on_output=on_output,
+            )
         status = "success" if proc.returncode == 0 else "error"
         result: Dict[str, Any] = {
             "status": status,
@@ -242,6 +564,12 @@ def run_migrate_ease_scan(
             "output_format": fmt,
         }
 
+        if remote is not None:
+            result["git_commit"] = remote.commit
+            result["git_ref"] = remote.ref
+            result["sparse_checkout"] = remote.sparse
+        if git_cache_error:
+            result["git_cache_error"] = git_cache_error
         if workspace_listing is not None:
             result["workspace_listing"] = workspace_listing
         if workspace_listing_error:
@@ -251,7 +579,7 @@ def run_migrate_ease_scan(
             result["excluded_count"] = len(excluded_items)
 
         # Inline JSON results before cleanup so callers still get the data.
-        if fmt == "json":
+        if fmt == "json" and not (scan_plan is not None and scan_plan["mode"] == "cached"):
             try:
                 with open(out_path, "r") as f:
                     data = json.load(f)
@@ -259,6 +587,23 @@ def run_migrate_ease_scan(
             except Exception as e:
                 result["parsed_results_error"] = f"Failed to parse JSON report: {e}"
 
+        if scan_plan is not None and (scan_plan["mode"] == "cached" or isinstance(result.get("parsed_results"), dict)):
+            try:
+                result["parsed_results"] = await asyncio.to_thread(
+                    _finish_cached_scan, scan_plan, result.get("parsed_results"), scan_target
+                )
+                result["scan_cache"] = {
+                    "mode": scan_plan["mode"],
+                    "files": len(scan_plan["files"]),
+                    "scanned_files": len(scan_plan["scan"]),
+                    "reused_files": len(scan_plan["files"]) - len(scan_plan["scan"]),
+                    "cache_file": scan_plan["cache"].path,
+                }
+            except Exception as e:
+                scan_cache_error = f"Failed to merge cached scan results: {e}"
+        if scan_cache_error:
+            result["scan_cache_error"] = scan_cache_error
+
         # BEST-EFFORT CLEANUP of the migrate-ease output file
         try:
             os.remove(out_path)
@@ -288,6 +633,10 @@ def run_migrate_ease_scan(
     finally:
         # Clean up temporary directories
         if temporary_clone_dir:
-            shutil.rmtree(temporary_clone_dir, ignore_errors=True)
+            await asyncio.to_thread(shutil.rmtree, temporary_clone_dir, ignore_errors=True)
+        if owned_remote is not None:
+            await git_cache.release(owned_remote)
         if filtered_workspace_dir:
-            shutil.rmtree(filtered_workspace_dir, ignore_errors=True)
+            await asyncio.to_thread(shutil.rmtree, filtered_workspace_dir, ignore_errors=True)
+        if scan_plan is not None and scan_plan["subset_dir"]:
+            await asyncio.to_thread(shutil.rmtree, scan_plan["subset_dir"], ignore_errors=True)
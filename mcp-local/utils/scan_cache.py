@@ -0,0 +1,350 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Per-file migrate-ease findings cached across local workspace scans.
+
+One cache file per (scanner, arch) maps each workspace file to its content hash and each
+content hash to the issues migrate-ease reported for it. A rescan only hands migrate-ease
+the files whose hash has no cached findings, then merges the new issues with the cached
+ones so the report keeps the shape of a full scan. Issue paths are stored relative to the
+scan root, and every report (full, incremental or cached) gives them, and root_directory,
+under one stable report root: the workspace, not the temporary view migrate-ease scanned.
+
+A file's findings can also depend on other files (the headers it includes, the build files
+and dependency manifests that describe the project), so the cache also keeps a context key
+over those; when it changes, the next scan is a full one. Concurrent scans with the same
+(scanner, arch) merge their findings into the file under a lock instead of overwriting it.
+"""
+
+from __future__ import annotations
+
+import copy
+import fcntl
+import hashlib
+import json
+import os
+import tempfile
+from typing import Any, Dict, List, Optional, Tuple
+
+from .config import MIGRATE_EASE_CACHE_DIR
+
+SCAN_CACHE_FORMAT_VERSION = 1
+HASH_CHUNK_BYTES = 1 << 20
+# Keys migrate-ease scanners use for the file an issue was found in.
+ISSUE_PATH_KEYS = ("filename", "file", "fileName", "file_name", "path")
+# Files whose content can change the findings of other files: headers, and build and dependency manifests.
+CONTEXT_FILE_SUFFIXES = (
+    ".h", ".hh", ".hpp", ".hxx", ".h++", ".inc", ".inl", ".ipp", ".tcc", ".cmake", ".mk", ".gradle", ".gradle.kts",
+)
+CONTEXT_FILE_NAMES = {
+    "CMakeLists.txt", "Makefile", "makefile", "GNUmakefile", "configure", "configure.ac", "meson.build",
+    "BUILD", "BUILD.bazel", "WORKSPACE", "Dockerfile",
+    "setup.py", "setup.cfg", "pyproject.toml", "Pipfile", "Pipfile.lock", "poetry.lock",
+    "package.json", "package-lock.json", "yarn.lock", "pnpm-lock.yaml",
+    "go.mod", "go.sum", "pom.xml", "Cargo.toml", "Cargo.lock",
+}
+
+
+def cache_path(scanner: str, arch: str, cache_dir: str = MIGRATE_EASE_CACHE_DIR) -> str:
+    safe = "".join(c if c.isalnum() or c in "-_." else "_" for c in f"{scanner}-{arch}")
+    return os.path.join(cache_dir, f"{safe}.json")
+
+
+def _file_sha256(path: str) -> str:
+    digest = hashlib.sha256()
+    with open(path, "rb") as file:
+        while chunk := file.read(HASH_CHUNK_BYTES):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+
+def fingerprint_tree(root: str, previous: Dict[str, Dict[str, Any]]) -> Dict[str, Dict[str, Any]]:
+    """Map every file under root (relative path) to its size, mtime and sha256.
+
+    Links are followed, so a file in a linked scan view is fingerprinted by its workspace
+    content. A file whose size and mtime match the previous fingerprint keeps its hash
+    without being read again.
+    """
+    files: Dict[str, Dict[str, Any]] = {}
+    stack = [root]
+    while stack:
+        directory = stack.pop()
+        try:
+            entries = list(os.scandir(directory))
+        except OSError:
+            continue
+        for entry in entries:
+            try:
+                if entry.is_dir(follow_symlinks=False):
+                    stack.append(entry.path)
+                    continue
+                stat = entry.stat()
+                if not entry.is_file():
+                    continue
+                rel_path = os.path.relpath(entry.path, root)
+                known = previous.get(rel_path)
+                if known and known.get("size") == stat.st_size and known.get("mtime_ns") == stat.st_mtime_ns:
+                    sha256 = known["sha256"]
+                else:
+                    sha256 = _file_sha256(entry.path)
+                files[rel_path] = {"size": stat.st_size, "mtime_ns": stat.st_mtime_ns, "sha256": sha256}
+            except OSError:
+                continue
+    return files
+
+
+def is_context_file(rel_path: str) -> bool:
+    name = os.path.basename(rel_path)
+    return (
+        name in CONTEXT_FILE_NAMES
+        or name.endswith(CONTEXT_FILE_SUFFIXES)
+        or (name.startswith("requirements") and name.endswith(".txt"))
+    )
+
+
+def context_key(files: Dict[str, Dict[str, Any]]) -> str:
+    """Hash of the paths and contents of every context file in `files`."""
+    digest = hashlib.sha256()
+    for rel_path in sorted(files):
+        if is_context_file(rel_path):
+            digest.update(f"{rel_path}\0{files[rel_path]['sha256']}\n".encode("utf-8"))
+    return digest.hexdigest()
+
+
+def _issue_path_key(issue: Any) -> Optional[str]:
+    if not isinstance(issue, dict):
+        return None
+    for key in ISSUE_PATH_KEYS:
+        if isinstance(issue.get(key), str) and issue[key]:
+            return key
+    return None
+
+
+def _relative_issue_path(issue: Any, scan_root: str) -> Optional[str]:
+    key = _issue_path_key(issue)
+    if key is None:
+        return None
+    path = issue[key]
+    if not os.path.isabs(path):
+        return os.path.normpath(path)
+    rel_path = os.path.relpath(path, scan_root)
+    return None if rel_path.startswith("..") else rel_path
+
+
+def _issue_type(issue: Dict[str, Any]) -> Optional[str]:
+    issue_type = issue.get("issue_type")
+    if isinstance(issue_type, dict):
+        issue_type = issue_type.get("type") or issue_type.get("name")
+    return issue_type if isinstance(issue_type, str) else None
+
+
+def _recount(report: Dict[str, Any]) -> None:
+    """Recompute total_issue_count, and the issue_summary counts when every issue has a known type."""
+    issues = report.get("issues") or []
+    report["total_issue_count"] = len(issues)
+    summary = report.get("issue_summary")
+    if not isinstance(summary, dict):
+        return
+    types = [_issue_type(issue) for issue in issues]
+    if any(t is None or not isinstance(summary.get(t), dict) for t in types):
+        return
+    for entry in summary.values():
+        if isinstance(entry, dict) and "count" in entry:
+            entry["count"] = 0
+    for t in types:
+        summary[t]["count"] = summary[t].get("count", 0) + 1
+
+
+class ScanCache:
+    """Findings for one (scanner, arch): files -> fingerprint, content hash -> issues."""
+
+    def __init__(self, path: str, scanner: str, arch: str):
+        self.path = path
+        self.scanner = scanner
+        self.arch = arch
+        self.files: Dict[str, Dict[str, Any]] = {}
+        self.findings: Dict[str, List[Dict[str, Any]]] = {}
+        # The last full report without its issues, reused for fields a partial scan cannot fill.
+        self.baseline: Optional[Dict[str, Any]] = None
+        # False once any issue could not be attributed to a file; such reports are never merged.
+        self.attributable = True
+        # context_key of the files the findings were computed with.
+        self.context: Optional[str] = None
+
+    @classmethod
+    def load(cls, scanner: str, arch: str, cache_dir: str = MIGRATE_EASE_CACHE_DIR) -> "ScanCache":
+        return cls._read(cache_path(scanner, arch, cache_dir), scanner, arch)
+
+    @classmethod
+    def _read(cls, path: str, scanner: str, arch: str) -> "ScanCache":
+        cache = cls(path, scanner, arch)
+        try:
+            with open(cache.path, "r", encoding="utf-8") as file:
+                payload = json.load(file)
+        except (OSError, ValueError):
+            return cache
+        if (
+            payload.get("format_version") != SCAN_CACHE_FORMAT_VERSION
+            or payload.get("scanner") != scanner
+            or payload.get("arch") != arch
+        ):
+            return cache
+        cache.files = payload.get("files") or {}
+        cache.findings = payload.get("findings") or {}
+        cache.baseline = payload.get("baseline")
+        cache.attributable = bool(payload.get("attributable", True))
+        cache.context = payload.get("context")
+        return cache
+
+    def save(self) -> None:
+        """Write the cache, first taking in findings another scan saved since this one loaded.
+
+        Findings are keyed by content hash, so entries from a scan with the same context are
+        valid here too; the files, baseline and context written are this scan's.
+        """
+        cache_dir = os.path.dirname(self.path)
+        os.makedirs(cache_dir, exist_ok=True)
+        with open(f"{self.path}.lock", "a") as lock:
+            fcntl.flock(lock, fcntl.LOCK_EX)
+            on_disk = ScanCache._read(self.path, self.scanner, self.arch)
+            if on_disk.context == self.context:
+                live = {info["sha256"] for info in (*self.files.values(), *on_disk.files.values())}
+                for sha256, issues in on_disk.findings.items():
+                    if sha256 in live:
+                        self.findings.setdefault(sha256, issues)
+            self._write()
+
+    def _write(self) -> None:
+        payload = {
+            "format_version": SCAN_CACHE_FORMAT_VERSION,
+            "scanner": self.scanner,
+            "arch": self.arch,
+            "attributable": self.attributable,
+            "context": self.context,
+            "baseline": self.baseline,
+            "files": self.files,
+            "findings": self.findings,
+        }
+        cache_dir = os.path.dirname(self.path)
+        # A unique temporary file, so a reader never sees a partly written cache.
+        fd, temp_path = tempfile.mkstemp(prefix=f"{os.path.basename(self.path)}.", suffix=".tmp", dir=cache_dir)
+        try:
+            with os.fdopen(fd, "w", encoding="utf-8") as file:
+                json.dump(payload, file, separators=(",", ":"))
+            os.replace(temp_path, self.path)
+        except BaseException:
+            try:
+                os.remove(temp_path)
+            except OSError:
+                pass
+            raise
+
+    def changed_files(self, files: Dict[str, Dict[str, Any]]) -> List[str]:
+        """Files whose current content has no cached findings: the ones a rescan must cover."""
+        return sorted(rel for rel, info in files.items() if info["sha256"] not in self.findings)
+
+    def can_merge(self, files: Dict[str, Dict[str, Any]]) -> bool:
+        """Whether cached findings can stand in for a scan of `files` (else a full scan is needed)."""
+        return self.baseline is not None and self.attributable and self.context == context_key(files)
+
+    def record(
+        self,
+        report: Dict[str, Any],
+        scan_root: str,
+        scanned: List[str],
+        files: Dict[str, Dict[str, Any]],
+        full: bool,
+        report_root: str,
+    ) -> Optional[Dict[str, Any]]:
+        """Store the findings of a scan of scan_root over `scanned` and return the report.
+
+        For a full scan the result is the report itself; for a partial scan, the partial
+        report with its issues replaced by those of every current file. Either way issue
+        paths and root_directory are re-rooted from scan_root to report_root.
+        """
+        by_file: Dict[str, List[Dict[str, Any]]] = {rel: [] for rel in scanned}
+        unattributed: List[Dict[str, Any]] = []
+        for issue in report.get("issues") or []:
+            rel_path = _relative_issue_path(issue, scan_root)
+            if rel_path is None or rel_path not in by_file:
+                unattributed.append(issue)
+                continue
+            stored = dict(issue)
+            stored[_issue_path_key(issue)] = rel_path
+            by_file[rel_path].append(stored)
+
+        for rel_path, issues in by_file.items():
+            self.findings[files[rel_path]["sha256"]] = issues
+        live = {info["sha256"] for info in files.values()}
+        self.findings = {sha256: issues for sha256, issues in self.findings.items() if sha256 in live}
+        self.files = files
+        self.context = context_key(files)
+        if unattributed:
+            self.attributable = False
+        if full:
+            self.attributable = not unattributed
+            self.baseline = {key: value for key, value in report.items() if key != "issues"}
+            rerooted = copy.deepcopy(report)
+            rerooted["root_directory"] = report_root
+            for issue in rerooted.get("issues") or []:
+                rel_path = _relative_issue_path(issue, scan_root)
+                if rel_path is not None and rel_path in by_file:
+                    issue[_issue_path_key(issue)] = os.path.join(report_root, rel_path)
+            return rerooted
+
+        merged = copy.deepcopy(report)
+        merged["root_directory"] = report_root
+        merged["issues"] = self.issues(files, report_root) + unattributed
+        if isinstance(self.baseline.get("file_summary"), dict):
+            merged["file_summary"] = copy.deepcopy(self.baseline["file_summary"])
+        _recount(merged)
+        return merged
+
+    def cached_report(self, files: Dict[str, Dict[str, Any]], report_root: str) -> Dict[str, Any]:
+        """Report for a workspace with no changed files, assembled without running migrate-ease."""
+        self.files = files
+        report = copy.deepcopy(self.baseline)
+        report["root_directory"] = report_root
+        report["issues"] = self.issues(files, report_root)
+        _recount(report)
+        return report
+
+    def issues(self, files: Dict[str, Dict[str, Any]], report_root: str) -> List[Dict[str, Any]]:
+        """Cached issues of every file in `files`, with paths re-rooted at report_root."""
+        issues: List[Dict[str, Any]] = []
+        for rel_path in sorted(files):
+            for stored in self.findings.get(files[rel_path]["sha256"], []):
+                issue = dict(stored)
+                issue[_issue_path_key(stored)] = os.path.join(report_root, rel_path)
+                issues.append(issue)
+        return issues
+
+
+def link_subset(view_dir: str, rel_paths: List[str], subset_dir: str) -> Tuple[str, List[str]]:
+    """Link the given files of a scan view into subset_dir; returns (dir, files linked)."""
+    linked: List[str] = []
+    for rel_path in rel_paths:
+        dst_path = os.path.join(subset_dir, rel_path)
+        src_path = os.path.join(view_dir, rel_path)
+        try:
+            os.makedirs(os.path.dirname(dst_path), exist_ok=True)
+            if os.path.islink(src_path):
+                # Relative link targets would not resolve from the subset, so point at the file itself.
+                os.symlink(os.path.realpath(src_path), dst_path)
+            else:
+                os.link(src_path, dst_path)
+        except OSError:
+            continue
+        linked.append(rel_path)
+    return subset_dir, linked
@@ -12,18 +12,197 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Dict, Any
+import asyncio
+import hashlib
+import json
+import time
+from collections import OrderedDict
+from typing import Dict, Any, List, Optional
 from .cli_utils import run_command
+from .config import SKOPEO_CACHE_SIZE, SKOPEO_CONCURRENCY, SKOPEO_TIMEOUT_SECONDS
 
+INDEX_MEDIA_TYPES = {
+    "application/vnd.docker.distribution.manifest.list.v2+json",
+    "application/vnd.oci.image.index.v1+json",
+}
+# Summaries by "<image>@<digest>": content-addressed, so they never go stale.
+_summaries: "OrderedDict[str, Dict[str, Any]]" = OrderedDict()
 
-def skopeo_help() -> Dict[str, Any]:
-    return run_command(["skopeo", "--help"])
 
+async def skopeo_help() -> Dict[str, Any]:
+    return await run_command(["skopeo", "--help"])
 
-def skopeo_inspect(image: str, transport: str = "docker", raw: bool = False) -> Dict[str, Any]:
+
+async def skopeo_inspect(
+    image: str,
+    transport: str = "docker",
+    raw: bool = False,
+    timeout: Optional[float] = SKOPEO_TIMEOUT_SECONDS,
+    text: bool = True,
+) -> Dict[str, Any]:
     cmd = ["skopeo", "inspect"]
     if raw:
         cmd.append("--raw")
     cmd.append(f"{transport}://{image}")
-    return run_command(cmd)
+    return await run_command(cmd, timeout=timeout, text=text)
+
+
+def _image_name(image: str) -> str:
+    """The image without its tag or digest, for building name@digest references."""
+    if "@" in image:
+        return image.split("@", 1)[0]
+    slash = image.rfind("/")
+    colon = image.rfind(":")
+    return image[:colon] if colon > slash else image
+
+
+def _cache_get(key: str) -> Optional[Dict[str, Any]]:
+    summary = _summaries.get(key)
+    if summary is not None:
+        _summaries.move_to_end(key)
+    return summary
+
+
+def _cache_put(key: str, summary: Dict[str, Any]) -> None:
+    if SKOPEO_CACHE_SIZE <= 0:
+        return
+    _summaries[key] = summary
+    _summaries.move_to_end(key)
+    while len(_summaries) > SKOPEO_CACHE_SIZE:
+        _summaries.popitem(last=False)
+
+
+def _layers_summary(manifest: Dict[str, Any]) -> Dict[str, Any]:
+    layers = manifest.get("layers") or []
+    return {"layers": len(layers), "size": sum(layer.get("size", 0) for layer in layers)}
+
+
+class _Inspector:
+    """Runs the skopeo processes of one batch, at most `concurrency` at a time."""
+
+    def __init__(self, transport: str, timeout: Optional[float], concurrency: int):
+        self.transport = transport
+        self.timeout = timeout
+        self.semaphore = asyncio.Semaphore(concurrency)
+        self.processes = 0
+
+    async def json(self, reference: str, raw: bool, text: bool = True) -> Any:
+        async with self.semaphore:
+            self.processes += 1
+            result = await skopeo_inspect(reference, self.transport, raw=raw, timeout=self.timeout, text=text)
+        if result["status"] != "ok":
+            raise RuntimeError((result.get("stderr") or "").strip() or f"skopeo exited with {result.get('code')}")
+        return result["stdout"]
+
+    async def platform(self, name: str, descriptor: Dict[str, Any]) -> Dict[str, Any]:
+        platform = descriptor.get("platform") or {}
+        digest = descriptor.get("digest", "")
+        summary = {
+            "os": platform.get("os"),
+            "architecture": platform.get("architecture"),
+            "variant": platform.get("variant"),
+            "digest": digest,
+        }
+        key = f"{name}@{digest}"
+        cached = _cache_get(key)
+        if cached is None:
+            cached = _layers_summary(json.loads(await self.json(key, raw=True)))
+            _cache_put(key, cached)
+        return {**summary, **cached}
+
+    async def image(self, image: str) -> Dict[str, Any]:
+        if self.transport != "docker":
+            # Other transports (oci, dir, ...) describe a single local image.
+            info = json.loads(await self.json(image, raw=False))
+            return {
+                "digest": info.get("Digest"),
+                "platforms": [{
+                    "os": info.get("Os"),
+                    "architecture": info.get("Architecture"),
+                    "variant": info.get("Variant"),
+                    "digest": info.get("Digest"),
+                    "layers": len(info.get("Layers") or []),
+                    "size": sum(layer.get("Size", 0) for layer in info.get("LayersData") or []),
+                }],
+                "cached": False,
+            }
+
+        name = _image_name(image)
+        if "@" in image:
+            cached = _cache_get(image)
+            if cached is not None:
+                return {**cached, "cached": True}
+
+        # The manifest digest is the sha256 of the exact bytes the registry served, so hash them undecoded.
+        raw_manifest = await self.json(image, raw=True, text=False)
+        digest = "sha256:" + hashlib.sha256(raw_manifest).hexdigest()
+        key = f"{name}@{digest}"
+        cached = _cache_get(key)
+        if cached is not None:
+            return {**cached, "cached": True}
+
+        manifest = json.loads(raw_manifest)
+        if manifest.get("mediaType") in INDEX_MEDIA_TYPES or "manifests" in manifest:
+            descriptors = [
+                d for d in manifest.get("manifests") or []
+                # Attestation manifests are listed with an unknown platform; they are not images.
+                if (d.get("platform") or {}).get("architecture") not in (None, "unknown")
+            ]
+            platforms = list(await asyncio.gather(*(self.platform(name, d) for d in descriptors)))
+        else:
+            # A single-platform image: its platform is in the image config, which plain inspect reads.
+            info = json.loads(await self.json(image, raw=False))
+            platforms = [{
+                "os": info.get("Os"),
+                "architecture": info.get("Architecture"),
+                "variant": info.get("Variant"),
+                "digest": digest,
+                **_layers_summary(manifest),
+            }]
+        summary = {"digest": digest, "media_type": manifest.get("mediaType"), "platforms": platforms}
+        _cache_put(key, summary)
+        return {**summary, "cached": False}
+
+
+async def skopeo_inspect_images(
+    images: List[str],
+    transport: str = "docker",
+    timeout: Optional[float] = None,
+    concurrency: Optional[int] = None,
+) -> Dict[str, Any]:
+    """Inspect many images concurrently and return compact per-platform summaries.
+
+    Each platform reports os, architecture, variant, digest, layer count and size (the sum
+    of its compressed layers). Per-platform manifests and whole images are cached by
+    image@digest, so re-inspecting a tag only re-reads its index.
+    """
+    started = time.monotonic()
+    inspector = _Inspector(
+        transport,
+        timeout or SKOPEO_TIMEOUT_SECONDS,
+        max(1, concurrency or SKOPEO_CONCURRENCY),
+    )
+    unique = list(dict.fromkeys(image.strip() for image in images if image and image.strip()))
+
+    async def inspect(image: str) -> Dict[str, Any]:
+        try:
+            summary = await inspector.image(image)
+        except (RuntimeError, ValueError) as e:
+            return {"status": "error", "message": f"Failed to inspect {image}: {e}"}
+        architectures = {p.get("architecture") for p in summary["platforms"]}
+        return {"status": "ok", "supports_arm64": "arm64" in architectures, **summary}
 
+    results = dict(zip(unique, await asyncio.gather(*(inspect(image) for image in unique))))
+    errors = sum(1 for r in results.values() if r["status"] == "error")
+    return {
+        "status": "error" if results and errors == len(results) else "ok",
+        "summary": {
+            "images": len(results),
+            "errors": errors,
+            "cached": sum(1 for r in results.values() if r.get("cached")),
+            "skopeo_processes": inspector.processes,
+        },
+        "missing_arm64": [image for image, r in results.items() if r["status"] == "ok" and not r["supports_arm64"]],
+        "results": results,
+        "elapsed_seconds": round(time.monotonic() - started, 3),
+    }
@@ -0,0 +1,302 @@
+# Copyright © 2026, Arm Limited and Contributors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Per-tool latency, subprocess, memory and response size metrics.
+
+ToolMetrics.instrument() wraps the FastMCP tool decorator so every tool call is timed. While a
+call runs, run_process() adds each child's lifetime to it through record_subprocess(), and
+search tools add their stage timings through record_stages(); both reach the call through a
+context variable, so concurrent calls never mix. Aggregates are served by the server_stats
+tool as JSON or OpenMetrics text; with TOOL_METRICS_PATH set, each call is also appended as
+one JSON line through the background log writer.
+"""
+
+from __future__ import annotations
+
+from collections import deque
+from contextvars import ContextVar
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from typing import Any, Callable, Deque, Dict, List, Mapping, Optional
+import functools
+import json
+import time
+
+from arm_kb_search.timing import children_peak_rss_bytes, latency_percentile, peak_rss_bytes, rss_bytes
+
+from .background_writer import LOG_WRITER, BackgroundWriter
+from .config import TOOL_METRICS_WINDOW
+
+# Response size in bytes per model token, for the rough token count server_stats reports.
+BYTES_PER_TOKEN = 4
+WALL_PERCENTILES = (50, 95, 99)
+
+
+@dataclass
+class CallMetrics:
+    """What one tool call spent outside its own code, filled in while it runs."""
+
+    subprocess_seconds: float = 0.0
+    subprocesses: int = 0
+    stages_ms: Dict[str, float] = field(default_factory=dict)
+
+
+_CURRENT_CALL: ContextVar[Optional[CallMetrics]] = ContextVar("tool_call_metrics", default=None)
+
+
+def record_subprocess(seconds: float) -> None:
+    """Charge a child process's lifetime to the tool call that started it, if any."""
+    call = _CURRENT_CALL.get()
+    if call is not None:
+        call.subprocess_seconds += seconds
+        call.subprocesses += 1
+
+
+def record_stages(stages_ms: Mapping[str, float]) -> None:
+    """Add named stage timings (e.g. a search StageTimer's) to the current tool call."""
+    call = _CURRENT_CALL.get()
+    if call is not None:
+        for stage, elapsed_ms in stages_ms.items():
+            call.stages_ms[stage] = call.stages_ms.get(stage, 0.0) + elapsed_ms
+
+
+def _response_bytes(result: Any) -> int:
+    # Roughly what the client receives as structured content.
+    try:
+        return len(json.dumps(result, default=str, ensure_ascii=False).encode("utf-8"))
+    except (TypeError, ValueError):
+        return len(str(result).encode("utf-8"))
+
+
+def _is_error(result: Any) -> bool:
+    # Tools report failures as a payload (format_tool_error, failed commands) rather than raising.
+    return isinstance(result, dict) and result.get("status") == "error"
+
+
+class _ToolStats:
+    def __init__(self, window: int):
+        self.calls = 0
+        self.errors = 0
+        self.wall_seconds = 0.0
+        self.wall_max_seconds = 0.0
+        self.recent_wall_ms: Deque[float] = deque(maxlen=window)
+        self.subprocess_seconds = 0.0
+        self.subprocesses = 0
+        self.response_bytes = 0
+        self.response_bytes_max = 0
+        self.rss_bytes_max = 0
+        self.peak_rss_growth_bytes_max = 0
+        self.child_peak_rss_bytes_max = 0
+        self.stages_ms: Dict[str, float] = {}
+
+    def summary(self) -> Dict[str, Any]:
+        recent = list(self.recent_wall_ms)
+        wall_ms = {f"p{percentile}": latency_percentile(recent, percentile) for percentile in WALL_PERCENTILES}
+        wall_ms["max"] = self.wall_max_seconds * 1000
+        wall_ms["mean"] = self.wall_seconds * 1000 / self.calls if self.calls else 0
+        summary: Dict[str, Any] = {
+            "calls": self.calls,
+            "errors": self.errors,
+            "wall_seconds_total": self.wall_seconds,
+            "wall_ms": wall_ms,
+            "subprocess_seconds_total": self.subprocess_seconds,
+            "subprocesses": self.subprocesses,
+            # Child process seconds per wall second; above 1 when a tool runs children in parallel.
+            "subprocess_fraction": self.subprocess_seconds / self.wall_seconds if self.wall_seconds else 0,
+            "response_bytes_mean": self.response_bytes / self.calls if self.calls else 0,
+            "response_bytes_max": self.response_bytes_max,
+            "response_tokens_estimate_max": self.response_bytes_max // BYTES_PER_TOKEN,
+            "rss_bytes_max": self.rss_bytes_max,
+            "peak_rss_growth_bytes_max": self.peak_rss_growth_bytes_max,
+            "child_peak_rss_bytes_max": self.child_peak_rss_bytes_max,
+        }
+        if self.stages_ms:
+            summary["stages_ms_mean"] = {stage: total / self.calls for stage, total in self.stages_ms.items()}
+        return summary
+
+
+class ToolMetrics:
+    """Aggregated metrics of every instrumented tool, keyed by tool name.
+
+    Calls are recorded on the event loop thread, so the aggregates need no lock.
+    """
+
+    def __init__(
+        self,
+        log_path: Optional[str] = None,
+        window: int = TOOL_METRICS_WINDOW,
+        writer: BackgroundWriter = LOG_WRITER,
+    ):
+        self.log_path = log_path
+        self.window = window
+        self.writer = writer
+        self.started = time.time()
+        self.tools: Dict[str, _ToolStats] = {}
+
+    def instrument(self, tool: Callable[..., Any]) -> Callable[..., Any]:
+        """Wrap a FastMCP ``tool`` decorator so the functions it registers are observed."""
+
+        def instrumented_tool(*args: Any, **kwargs: Any) -> Any:
+            if args and callable(args[0]):
+                fn = args[0]
+                return tool(self.observe(kwargs.get("name") or fn.__name__, fn), *args[1:], **kwargs)
+            name = kwargs.get("name") or (args[0] if args and isinstance(args[0], str) else None)
+
+            def decorator(fn: Callable[..., Any]) -> Any:
+                return tool(*args, **kwargs)(self.observe(name or fn.__name__, fn))
+
+            return decorator
+
+        return instrumented_tool
+
+    def observe(self, name: str, fn: Callable[..., Any]) -> Callable[..., Any]:
+        """Async wrapper of tool fn that records each call; the signature FastMCP sees is fn's."""
+
+        @functools.wraps(fn)
+        async def wrapper(*args: Any, **kwargs: Any) -> Any:
+            call = CallMetrics()
+            token = _CURRENT_CALL.set(call)
+            peak_before = peak_rss_bytes()
+            child_peak_before = children_peak_rss_bytes()
+            started = time.perf_counter()
+            result = None
+            failed = True
+            try:
+                result = await fn(*args, **kwargs)
+                failed = _is_error(result)
+                return result
+            finally:
+                wall_seconds = time.perf_counter() - started
+                _CURRENT_CALL.reset(token)
+                try:
+                    self._record(name, call, wall_seconds, failed, result, peak_before, child_peak_before)
+                except Exception:
+                    # Metrics must never fail the tool call.
+                    pass
+
+        return wrapper
+
+    def _record(
+        self,
+        name: str,
+        call: CallMetrics,
+        wall_seconds: float,
+        failed: bool,
+        result: Any,
+        peak_before: int,
+        child_peak_before: int,
+    ) -> None:
+        response_bytes = _response_bytes(result) if result is not None else 0
+        current_rss = rss_bytes() or 0
+        peak_growth = max(0, peak_rss_bytes() - peak_before)
+        child_peak = children_peak_rss_bytes()
+        # Only a child that set a new high-water mark during this call is attributed to it.
+        child_peak_during = child_peak if child_peak > child_peak_before else 0
+
+        stats = self.tools.get(name)
+        if stats is None:
+            stats = self.tools[name] = _ToolStats(self.window)
+        stats.calls += 1
+        stats.errors += int(failed)
+        stats.wall_seconds += wall_seconds
+        stats.wall_max_seconds = max(stats.wall_max_seconds, wall_seconds)
+        stats.recent_wall_ms.append(wall_seconds * 1000)
+        stats.subprocess_seconds += call.subprocess_seconds
+        stats.subprocesses += call.subprocesses
+        stats.response_bytes += response_bytes
+        stats.response_bytes_max = max(stats.response_bytes_max, response_bytes)
+        stats.rss_bytes_max = max(stats.rss_bytes_max, current_rss)
+        stats.peak_rss_growth_bytes_max = max(stats.peak_rss_growth_bytes_max, peak_growth)
+        stats.child_peak_rss_bytes_max = max(stats.child_peak_rss_bytes_max, child_peak_during)
+        for stage, elapsed_ms in call.stages_ms.items():
+            stats.stages_ms[stage] = stats.stages_ms.get(stage, 0.0) + elapsed_ms
+
+        if self.log_path:
+            entry: Dict[str, Any] = {
+                "timestamp": datetime.now(timezone.utc).isoformat(),
+                "tool": name,
+                "error": failed,
+                "wall_ms": round(wall_seconds * 1000, 3),
+                "subprocess_ms": round(call.subprocess_seconds * 1000, 3),
+                "subprocesses": call.subprocesses,
+                "response_bytes": response_bytes,
+                "rss_bytes": current_rss,
+                "peak_rss_growth_bytes": peak_growth,
+            }
+            if call.stages_ms:
+                entry["stages_ms"] = {stage: round(elapsed, 3) for stage, elapsed in call.stages_ms.items()}
+            self.writer.append(self.log_path, json.dumps(entry) + "\n")
+
+    def snapshot(self) -> Dict[str, Any]:
+        """Process totals and per-tool summaries, slowest tools (by total wall time) first."""
+        ranked = sorted(self.tools.items(), key=lambda item: item[1].wall_seconds, reverse=True)
+        return {
+            "uptime_seconds": time.time() - self.started,
+            "process": {
+                "rss_bytes": rss_bytes(),
+                "peak_rss_bytes": peak_rss_bytes(),
+                "children_peak_rss_bytes": children_peak_rss_bytes(),
+            },
+            "log_writer": {"written": self.writer.written, "dropped": self.writer.dropped},
+            "tools": {name: stats.summary() for name, stats in ranked},
+        }
+
+    def openmetrics(self) -> str:
+        """The aggregates in OpenMetrics text format, for scraping or a Prometheus textfile collector."""
+        lines: List[str] = []
+
+        def family(metric: str, kind: str, help_text: str) -> None:
+            lines.append(f"# TYPE {metric} {kind}")
+            lines.append(f"# HELP {metric} {help_text}")
+
+        def sample(metric: str, value: float, **labels: str) -> None:
+            rendered = ",".join(f'{key}="{_escape_label(str(label))}"' for key, label in labels.items())
+            lines.append(f"{metric}{{{rendered}}} {value}" if rendered else f"{metric} {value}")
+
+        tools = sorted(self.tools.items())
+        family("arm_mcp_tool_calls", "counter", "Tool calls.")
+        for name, stats in tools:
+            sample("arm_mcp_tool_calls_total", stats.calls, tool=name)
+        family("arm_mcp_tool_errors", "counter", "Tool calls that raised or returned status error.")
+        for name, stats in tools:
+            sample("arm_mcp_tool_errors_total", stats.errors, tool=name)
+        family("arm_mcp_tool_wall_seconds", "summary", "Tool call wall time; quantiles over recent calls.")
+        for name, stats in tools:
+            recent = list(stats.recent_wall_ms)
+            for percentile in WALL_PERCENTILES:
+                sample("arm_mcp_tool_wall_seconds", latency_percentile(recent, percentile) / 1000, tool=name, quantile=str(percentile / 100))
+            sample("arm_mcp_tool_wall_seconds_sum", stats.wall_seconds, tool=name)
+            sample("arm_mcp_tool_wall_seconds_count", stats.calls, tool=name)
+        family("arm_mcp_tool_subprocess_seconds", "counter", "Lifetime of child processes started by tool calls.")
+        for name, stats in tools:
+            sample("arm_mcp_tool_subprocess_seconds_total", stats.subprocess_seconds, tool=name)
+        family("arm_mcp_tool_response_bytes", "summary", "Size of tool responses as JSON.")
+        for name, stats in tools:
+            sample("arm_mcp_tool_response_bytes_sum", stats.response_bytes, tool=name)
+            sample("arm_mcp_tool_response_bytes_count", stats.calls, tool=name)
+        family("arm_mcp_tool_rss_bytes_max", "gauge", "Largest process RSS at the end of a tool call.")
+        for name, stats in tools:
+            sample("arm_mcp_tool_rss_bytes_max", stats.rss_bytes_max, tool=name)
+        family("arm_mcp_tool_stage_seconds", "counter", "Time tool calls spent in named stages.")
+        for name, stats in tools:
+            for stage, total_ms in sorted(stats.stages_ms.items()):
+                sample("arm_mcp_tool_stage_seconds_total", total_ms / 1000, tool=name, stage=stage)
+        family("arm_mcp_process_peak_rss_bytes", "gauge", "Peak RSS of the server process.")
+        sample("arm_mcp_process_peak_rss_bytes", peak_rss_bytes())
+        lines.append("# EOF")
+        return "\n".join(lines) + "\n"
+
+
+def _escape_label(value: str) -> str:
+    return value.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")